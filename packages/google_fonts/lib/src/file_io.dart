@@ -28,6 +28,10 @@ Future<void> saveFontToDeviceFileSystem({
   return Future<void>.value();
 }
 
+/// Stubbed out version of clearDeviceFileSystemCache from
+/// `file_io_desktop_and_mobile.dart`.
+void clearDeviceFileSystemCache() {}
+
 /// Stubbed out version of loadFontFromDeviceFileSystem from
 /// `file_io_desktop_and_mobile.dart`.
 Future<ByteData?> loadFontFromDeviceFileSystem({
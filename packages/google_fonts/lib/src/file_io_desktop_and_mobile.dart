@@ -37,9 +37,9 @@ Future<ByteData?> loadFontFromDeviceFileSystem({
     final File file = await _localFile(name, fileHash);
     final bool fileExists = file.existsSync();
     if (fileExists) {
-      final List<int> contents = await file.readAsBytes();
+      final Uint8List contents = await file.readAsBytes();
       if (contents.isNotEmpty) {
-        return ByteData.view(Uint8List.fromList(contents).buffer);
+        return ByteData.sublistView(contents);
       }
     }
   } catch (e) {
@@ -48,9 +48,28 @@ Future<ByteData?> loadFontFromDeviceFileSystem({
   return null;
 }
 
-Future<String> get _localPath async {
-  final Directory directory = await getApplicationSupportDirectory();
-  return directory.path;
+/// Forgets the application support directory resolved by previous calls, so
+/// that it is looked up again.
+void clearDeviceFileSystemCache() {
+  _localPathFuture = null;
+}
+
+// The application support directory doesn't change while the app is running,
+// so it is only looked up once rather than for every font.
+Future<String>? _localPathFuture;
+
+Future<String> get _localPath => _localPathFuture ??= _resolveLocalPath();
+
+Future<String> _resolveLocalPath() async {
+  try {
+    final Directory directory = await getApplicationSupportDirectory();
+    return directory.path;
+  } catch (e) {
+    // Look the directory up again next time, in case the failure was
+    // transient.
+    _localPathFuture = null;
+    rethrow;
+  }
 }
 
 Future<File> _localFile(String name, String fileHash) async {
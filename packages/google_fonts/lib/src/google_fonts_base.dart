@@ -3,7 +3,7 @@
 // found in the LICENSE file.
 
 import 'package:crypto/crypto.dart';
-import 'package:flutter/foundation.dart' show kIsWeb;
+import 'package:flutter/foundation.dart' show compute, kIsWeb;
 import 'package:flutter/material.dart';
 import 'package:flutter/services.dart';
 import 'package:http/http.dart' as http;
@@ -22,9 +22,13 @@ import 'google_fonts_variant.dart';
 /// Used to determine whether to load a font or not.
 final Set<String> _loadedFonts = <String>{};
 
-/// Clears any previously loaded fonts.
+/// Clears any previously loaded fonts, and the location of the fonts cached on
+/// the device.
 @visibleForTesting
-void clearCache() => _loadedFonts.clear();
+void clearCache() {
+  _loadedFonts.clear();
+  file_io.clearDeviceFileSystemCache();
+}
 
 /// Set of [Future]s corresponding to fonts that are loading.
 ///
@@ -40,6 +44,49 @@ http.Client httpClient = http.Client();
 @visibleForTesting
 AssetManifest? assetManifest;
 
+/// The length in bytes from which downloaded fonts are verified on a
+/// background isolate.
+///
+/// Hashing a large font, such as a CJK font, can take long enough to drop
+/// frames. Smaller fonts are verified directly, as that is quicker than
+/// starting an isolate.
+@visibleForTesting
+int backgroundVerificationMinLength = 1024 * 1024;
+
+// The font files listed in _fontAssetsManifest. Apps can bundle many assets,
+// so they are only listed and filtered once rather than for every font.
+List<String>? _fontAssets;
+AssetManifest? _fontAssetsManifest;
+
+List<String>? _listFontAssets(AssetManifest? manifest) {
+  if (manifest == null) {
+    return null;
+  }
+  if (!identical(manifest, _fontAssetsManifest)) {
+    _fontAssetsManifest = manifest;
+    final List<String> fileTypes = _fontFileTypesFor(kIsWeb);
+    _fontAssets = manifest
+        .listAssets()
+        .where((String asset) => fileTypes.any(asset.endsWith))
+        .toList();
+  }
+  return _fontAssets;
+}
+
+// The file types of fonts that can be bundled as assets. WOFF fonts can only
+// be used on the web.
+List<String> _fontFileTypesFor(bool isWeb) {
+  return isWeb ? _webFontFileTypes : _fontFileTypes;
+}
+
+const List<String> _webFontFileTypes = <String>[
+  '.woff2',
+  '.woff',
+  '.ttf',
+  '.otf',
+];
+const List<String> _fontFileTypes = <String>['.ttf', '.otf'];
+
 /// Creates a [TextStyle] that either uses the [fontFamily] for the requested
 /// GoogleFont, or falls back to the pre-bundled [fontFamily].
 ///
@@ -145,7 +192,7 @@ Future<void> loadFontIfNecessary(GoogleFontsDescriptor descriptor) async {
     assetManifest ??= await AssetManifest.loadFromAssetBundle(rootBundle);
     final String? assetPath = findFamilyWithVariantAssetPath(
       descriptor.familyWithVariant,
-      assetManifest?.listAssets(),
+      _listFontAssets(assetManifest),
     );
     if (assetPath != null) {
       byteData = rootBundle.load(assetPath);
@@ -266,7 +313,8 @@ Future<ByteData> _httpFetchFontAndSaveToDevice(
     throw Exception('Failed to load font with url ${file.url}: $e');
   }
   if (response.statusCode == 200) {
-    if (!_isFileSecure(file, response.bodyBytes)) {
+    final Uint8List bytes = response.bodyBytes;
+    if (!await _isFileSecure(file, bytes)) {
       throw Exception(
         'File from ${file.url} did not match expected length and checksum.',
       );
@@ -276,11 +324,11 @@ Future<ByteData> _httpFetchFontAndSaveToDevice(
       file_io.saveFontToDeviceFileSystem(
         name: fontName,
         fileHash: file.expectedFileHash,
-        bytes: response.bodyBytes,
+        bytes: bytes,
       ),
     );
 
-    return ByteData.view(response.bodyBytes.buffer);
+    return ByteData.sublistView(bytes);
   } else {
     // If that call was not successful, throw an error.
     throw Exception('Failed to load font with url: ${file.url}');
@@ -314,9 +362,7 @@ String? findFamilyWithVariantAssetPath(
   }
 
   final String apiFilenamePrefix = familyWithVariant.toApiFilenamePrefix();
-  final fileTypes = isWeb
-      ? ['.woff2', '.woff', '.ttf', '.otf']
-      : ['.ttf', '.otf'];
+  final List<String> fileTypes = _fontFileTypesFor(isWeb);
 
   for (final String asset in manifestValues) {
     for (final String matchingSuffix in fileTypes.where(asset.endsWith)) {
@@ -333,11 +379,16 @@ String? findFamilyWithVariantAssetPath(
   return null;
 }
 
-bool _isFileSecure(GoogleFontsFile file, Uint8List bytes) {
-  final int actualFileLength = bytes.length;
-  final actualFileHash = sha256.convert(bytes).toString();
-  return file.expectedLength == actualFileLength &&
-      file.expectedFileHash == actualFileHash;
+Future<bool> _isFileSecure(GoogleFontsFile file, Uint8List bytes) async {
+  if (file.expectedLength != bytes.length) {
+    return false;
+  }
+  final String actualFileHash = bytes.length < backgroundVerificationMinLength
+      ? _sha256Hash(bytes)
+      : await compute(_sha256Hash, bytes);
+  return file.expectedFileHash == actualFileHash;
 }
 
+String _sha256Hash(Uint8List bytes) => sha256.convert(bytes).toString();
+
 void _unawaited(Future<void> future) {}
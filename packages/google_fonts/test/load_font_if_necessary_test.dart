@@ -36,8 +36,11 @@ class MockHttpClient extends Mock implements http.Client {
 }
 
 class MockAssetManifest extends Mock implements AssetManifest {
+  int listAssetsCallCount = 0;
+
   @override
   List<String> listAssets() {
+    listAssetsCallCount++;
     return <String>[];
   }
 }
@@ -49,8 +52,11 @@ class FakePathProviderPlatform extends Fake
 
   final String _applicationSupportPath;
 
+  int getApplicationSupportPathCallCount = 0;
+
   @override
   Future<String?> getApplicationSupportPath() async {
+    getApplicationSupportPathCallCount++;
     return _applicationSupportPath;
   }
 }
@@ -309,6 +315,87 @@ void main() {
     verifyNever(mockHttpClient.gets(anything));
   });
 
+  test('loadFontIfNecessary only lists the bundled assets once', () async {
+    await loadFontIfNecessary(fakeDescriptor);
+    await loadFontIfNecessary(
+      GoogleFontsDescriptor(
+        familyWithVariant: const GoogleFontsFamilyWithVariant(
+          family: 'Bar',
+          googleFontsVariant: GoogleFontsVariant(
+            fontWeight: FontWeight.w400,
+            fontStyle: FontStyle.normal,
+          ),
+        ),
+        file: _fakeResponseFile,
+      ),
+    );
+    expect((assetManifest! as MockAssetManifest).listAssetsCallCount, 1);
+  });
+
+  test('loadFontIfNecessary only looks up the cache directory once', () async {
+    final pathProvider =
+        PathProviderPlatform.instance as FakePathProviderPlatform;
+    final Directory directoryContents = await getApplicationSupportDirectory();
+    File(
+      '${directoryContents.path}/$expectedCachedFile',
+    ).writeAsStringSync('file contents');
+    File(
+      '${directoryContents.path}/Bar_regular_$_fakeResponseHash.ttf',
+    ).writeAsStringSync('file contents');
+    final int callCount = pathProvider.getApplicationSupportPathCallCount;
+
+    await loadFontIfNecessary(fakeDescriptor);
+    await loadFontIfNecessary(
+      GoogleFontsDescriptor(
+        familyWithVariant: const GoogleFontsFamilyWithVariant(
+          family: 'Bar',
+          googleFontsVariant: GoogleFontsVariant(
+            fontWeight: FontWeight.w400,
+            fontStyle: FontStyle.normal,
+          ),
+        ),
+        file: _fakeResponseFile,
+      ),
+    );
+    verifyNever(mockHttpClient.gets(anything));
+    expect(pathProvider.getApplicationSupportPathCallCount, callCount + 1);
+  });
+
+  test('loadFontIfNecessary verifies large fonts in the background', () async {
+    final int minLength = backgroundVerificationMinLength;
+    addTearDown(() => backgroundVerificationMinLength = minLength);
+    backgroundVerificationMinLength = 0;
+
+    await loadFontIfNecessary(fakeDescriptor);
+    verify(mockHttpClient.gets(anything)).called(1);
+    // Give enough time for the file to be saved
+    await Future<void>.delayed(const Duration(seconds: 1), () {});
+    final Directory directoryContents = await getApplicationSupportDirectory();
+    expect(
+      directoryContents.listSync().single.toString(),
+      contains(expectedCachedFile),
+    );
+  });
+
+  test(
+    'loadFontIfNecessary rejects large fonts that fail background '
+    'verification',
+    () async {
+      final int minLength = backgroundVerificationMinLength;
+      addTearDown(() => backgroundVerificationMinLength = minLength);
+      backgroundVerificationMinLength = 0;
+      // Same length as _fakeResponse, but a different hash.
+      when(mockHttpClient.gets(any)).thenAnswer((_) async {
+        return http.Response('fake response body - failure', 200);
+      });
+
+      await expectLater(loadFontIfNecessary(fakeDescriptor), throwsException);
+      final Directory directoryContents =
+          await getApplicationSupportDirectory();
+      expect(directoryContents.listSync().isEmpty, isTrue);
+    },
+  );
+
   test('loadFontIfNecessary method re-caches when font file changes', () async {
     when(mockHttpClient.gets(any)).thenAnswer((_) async {
       return http.Response(_fakeResponseDifferent, 200);
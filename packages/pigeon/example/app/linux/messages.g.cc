@@ -92,8 +92,8 @@ static FlValue* pigeon_example_package_message_data_to_list(
                                    : fl_value_new_null());
   fl_value_append_take(values,
                        fl_value_new_custom(pigeon_example_package_code_type_id,
-                                           fl_value_new_int(self->code),
-                                           (GDestroyNotify)fl_value_unref));
+                                           GINT_TO_POINTER(self->code),
+                                           nullptr));
   fl_value_append_take(values, fl_value_ref(self->data));
   return values;
 }
@@ -112,8 +112,7 @@ pigeon_example_package_message_data_new_from_list(FlValue* values) {
   }
   FlValue* value2 = fl_value_get_list_value(values, 2);
   PigeonExamplePackageCode code = static_cast<PigeonExamplePackageCode>(
-      fl_value_get_int(reinterpret_cast<FlValue*>(
-          const_cast<gpointer>(fl_value_get_custom_value(value2)))));
+      GPOINTER_TO_INT(fl_value_get_custom_value(value2)));
   FlValue* value3 = fl_value_get_list_value(values, 3);
   FlValue* data = value3;
   return pigeon_example_package_message_data_new(name, description, code, data);
@@ -130,13 +129,55 @@ G_DEFINE_TYPE(PigeonExamplePackageMessageCodec,
 const int pigeon_example_package_code_type_id = 129;
 const int pigeon_example_package_message_data_type_id = 130;
 
+// The standard codec type tag for a 32-bit integer, used to encode enum values.
+static const uint8_t pigeon_example_package_message_codec_int32_type = 3;
+
+static gboolean pigeon_example_package_message_codec_write_enum_index(
+    GByteArray* buffer, int index) {
+  uint8_t type = pigeon_example_package_message_codec_int32_type;
+  g_byte_array_append(buffer, &type, sizeof(uint8_t));
+  int32_t value = index;
+  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
+                      sizeof(int32_t));
+  return TRUE;
+}
+
+static gboolean pigeon_example_package_message_codec_read_enum_index(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, int* index,
+    GError** error) {
+  size_t data_length;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(buffer, &data_length));
+  if (*offset + sizeof(uint8_t) + sizeof(int32_t) <= data_length &&
+      data[*offset] == pigeon_example_package_message_codec_int32_type) {
+    int32_t value;
+    memcpy(&value, data + *offset + sizeof(uint8_t), sizeof(int32_t));
+    *offset += sizeof(uint8_t) + sizeof(int32_t);
+    *index = value;
+    return TRUE;
+  }
+
+  g_autoptr(FlValue) value =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value == nullptr) {
+    return FALSE;
+  }
+  if (fl_value_get_type(value) != FL_VALUE_TYPE_INT) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
+                "Invalid data received for enum");
+    return FALSE;
+  }
+  *index = fl_value_get_int(value);
+  return TRUE;
+}
+
 static gboolean
 pigeon_example_package_message_codec_write_pigeon_example_package_code(
-    FlStandardMessageCodec* codec, GByteArray* buffer, FlValue* value,
+    FlStandardMessageCodec* codec, GByteArray* buffer, int value,
     GError** error) {
   uint8_t type = pigeon_example_package_code_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  return fl_standard_message_codec_write_value(codec, buffer, value, error);
+  return pigeon_example_package_message_codec_write_enum_index(buffer, value);
 }
 
 static gboolean
@@ -157,9 +198,7 @@ static gboolean pigeon_example_package_message_codec_write_value(
     switch (fl_value_get_custom_type(value)) {
       case pigeon_example_package_code_type_id:
         return pigeon_example_package_message_codec_write_pigeon_example_package_code(
-            codec, buffer,
-            reinterpret_cast<FlValue*>(
-                const_cast<gpointer>(fl_value_get_custom_value(value))),
+            codec, buffer, GPOINTER_TO_INT(fl_value_get_custom_value(value)),
             error);
       case pigeon_example_package_message_data_type_id:
         return pigeon_example_package_message_codec_write_pigeon_example_package_message_data(
@@ -179,10 +218,14 @@ static FlValue*
 pigeon_example_package_message_codec_read_pigeon_example_package_code(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  return fl_value_new_custom(
-      pigeon_example_package_code_type_id,
-      fl_standard_message_codec_read_value(codec, buffer, offset, error),
-      (GDestroyNotify)fl_value_unref);
+  int index;
+  if (!pigeon_example_package_message_codec_read_enum_index(
+          codec, buffer, offset, &index, error)) {
+    return nullptr;
+  }
+
+  return fl_value_new_custom(pigeon_example_package_code_type_id,
+                             GINT_TO_POINTER(index), nullptr);
 }
 
 static FlValue*
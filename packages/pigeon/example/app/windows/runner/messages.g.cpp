@@ -102,13 +102,21 @@ MessageData MessageData::FromEncodableList(const EncodableList& list) {
   return decoded;
 }
 
+// The standard codec type tag for a 32-bit integer, used to encode enum
+// values.
+constexpr uint8_t kEncodedInt32Type = 3;
+
 PigeonInternalCodecSerializer::PigeonInternalCodecSerializer() {}
 
 EncodableValue PigeonInternalCodecSerializer::ReadValueOfType(
     uint8_t type, flutter::ByteStreamReader* stream) const {
   switch (type) {
     case 129: {
-      const auto& encodable_enum_arg = ReadValue(stream);
+      const uint8_t enum_arg_type = stream->ReadByte();
+      if (enum_arg_type == kEncodedInt32Type) {
+        return CustomEncodableValue(static_cast<Code>(stream->ReadInt32()));
+      }
+      const auto& encodable_enum_arg = ReadValueOfType(enum_arg_type, stream);
       const int64_t enum_arg_value =
           encodable_enum_arg.IsNull() ? 0 : encodable_enum_arg.LongValue();
       return encodable_enum_arg.IsNull()
@@ -130,9 +138,9 @@ void PigeonInternalCodecSerializer::WriteValue(
           std::get_if<CustomEncodableValue>(&value)) {
     if (custom_value->type() == typeid(Code)) {
       stream->WriteByte(129);
-      WriteValue(
-          EncodableValue(static_cast<int>(std::any_cast<Code>(*custom_value))),
-          stream);
+      stream->WriteByte(kEncodedInt32Type);
+      stream->WriteInt32(
+          static_cast<int32_t>(std::any_cast<Code>(*custom_value)));
       return;
     }
     if (custom_value->type() == typeid(MessageData)) {
@@ -109,6 +109,7 @@ class AstHostApi extends Api {
     required super.name,
     required super.methods,
     super.documentationComments = const <String>[],
+    super.compressionThreshold,
     this.dartHostTestHandler,
   });
 
@@ -128,6 +129,7 @@ class AstFlutterApi extends Api {
     required super.name,
     required super.methods,
     super.documentationComments = const <String>[],
+    super.compressionThreshold,
   });
 
   @override
@@ -453,6 +455,7 @@ sealed class Api extends Node {
     required this.name,
     required this.methods,
     this.documentationComments = const <String>[],
+    this.compressionThreshold,
   });
 
   /// The name of the API.
@@ -468,6 +471,10 @@ sealed class Api extends Node {
   /// For example: [" List of documentation comments, separated by line.", ...]
   List<String> documentationComments;
 
+  /// The encoded size in bytes above which host-to-Flutter messages of this
+  /// API are compressed, or null if they are never compressed.
+  int? compressionThreshold;
+
   @override
   String toString() {
     return '(Api name:$name methods:$methods documentationComments:$documentationComments)';
@@ -727,6 +734,7 @@ class Class extends Node {
     this.isSealed = false,
     this.isReferenced = true,
     this.isSwiftClass = false,
+    this.isSynced = false,
     this.documentationComments = const <String>[],
   });
 
@@ -759,6 +767,10 @@ class Class extends Node {
   /// Defaults to false, which would represent a struct.
   bool isSwiftClass;
 
+  /// Whether the class is sent to Flutter as field level patches when passed
+  /// to a Flutter API, see `@Synced`.
+  bool isSynced;
+
   /// List of documentation comments, separated by line.
   ///
   /// Lines should not include the comment marker itself, but should include any
@@ -768,7 +780,7 @@ class Class extends Node {
 
   @override
   String toString() {
-    return '(Class name:$name fields:$fields superClass:$superClassName children:$children isSealed:$isSealed isReferenced:$isReferenced documentationComments:$documentationComments)';
+    return '(Class name:$name fields:$fields superClass:$superClassName children:$children isSealed:$isSealed isReferenced:$isReferenced isSynced:$isSynced documentationComments:$documentationComments)';
   }
 }
 
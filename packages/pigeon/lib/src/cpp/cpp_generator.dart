@@ -27,6 +27,25 @@ const String _codecSerializerName = '${classNamePrefix}CodecSerializer';
 
 const String _overflowClassName = '${classNamePrefix}CodecOverflow';
 
+/// The name of the constant holding the standard codec's type tag for 32-bit
+/// integers, which is how enum values are sent.
+const String _encodedInt32TypeName = 'kEncodedInt32Type';
+
+/// The name of the type holding a message that is compressed by the codec if
+/// its encoding is longer than its API's `compressionThreshold`.
+const String _compressibleMessageClassName =
+    'PigeonInternalCompressibleMessage';
+
+/// The name of the stream writer collecting an encoding into a vector.
+const String _vectorWriterClassName = 'PigeonInternalVectorWriter';
+
+/// The name of the function compressing data using the LZ4 block format.
+const String _compressLz4FunctionName = 'PigeonInternalCompressLz4';
+
+/// The name of the function marking a message to be compressed if it is large
+/// enough.
+const String _compressMessageFunctionName = 'PigeonInternalCompressMessage';
+
 final NamedType _overflowType = NamedType(
   name: 'type',
   type: const TypeDeclaration(baseName: 'int', isNullable: false),
@@ -58,6 +77,8 @@ class CppOptions {
     this.namespace,
     this.copyrightHeader,
     this.headerOutPath,
+    this.cancellableFlutterApis,
+    this.channelNameTables,
   });
 
   /// The path to the header that will get placed in the source file (example:
@@ -73,6 +94,20 @@ class CppOptions {
   /// The path to the output header file location.
   final String? headerOutPath;
 
+  /// Whether Flutter API methods take a `FlutterApiCallOptions` with an
+  /// optional deadline and cancellation token.
+  ///
+  /// Calls that pass their deadline or are cancelled fail with an error and
+  /// release their callbacks, even if Dart never replies.
+  final bool? cancellableFlutterApis;
+
+  /// Whether each API gets a `constexpr` table of its channel names and method
+  /// signatures.
+  ///
+  /// Flutter APIs then build their suffixed channel names once per instance
+  /// rather than on every call.
+  final bool? channelNameTables;
+
   /// Creates a [CppOptions] from a Map representation where:
   /// `x = CppOptions.fromMap(x.toMap())`.
   static CppOptions fromMap(Map<String, Object> map) {
@@ -81,6 +116,8 @@ class CppOptions {
       namespace: map['namespace'] as String?,
       copyrightHeader: map['copyrightHeader'] as Iterable<String>?,
       headerOutPath: map['cppHeaderOut'] as String?,
+      cancellableFlutterApis: map['cancellableFlutterApis'] as bool?,
+      channelNameTables: map['channelNameTables'] as bool?,
     );
   }
 
@@ -91,6 +128,9 @@ class CppOptions {
       if (headerIncludePath != null) 'headerIncludePath': headerIncludePath!,
       if (namespace != null) 'namespace': namespace!,
       if (copyrightHeader != null) 'copyrightHeader': copyrightHeader!,
+      if (cancellableFlutterApis != null)
+        'cancellableFlutterApis': cancellableFlutterApis!,
+      if (channelNameTables != null) 'channelNameTables': channelNameTables!,
     };
     return result;
   }
@@ -114,6 +154,8 @@ class InternalCppOptions extends InternalOptions {
     this.namespace,
     this.copyrightHeader,
     this.headerOutPath,
+    this.cancellableFlutterApis = false,
+    this.channelNameTables = false,
   });
 
   /// Creates InternalCppOptions from CppOptions.
@@ -126,7 +168,9 @@ class InternalCppOptions extends InternalOptions {
            options.headerIncludePath ?? path.basename(cppHeaderOut),
        namespace = options.namespace,
        copyrightHeader = options.copyrightHeader ?? copyrightHeader,
-       headerOutPath = options.headerOutPath;
+       headerOutPath = options.headerOutPath,
+       cancellableFlutterApis = options.cancellableFlutterApis ?? false,
+       channelNameTables = options.channelNameTables ?? false;
 
   /// The path to the header that will get placed in the source file (example:
   /// "foo.h").
@@ -146,6 +190,12 @@ class InternalCppOptions extends InternalOptions {
 
   /// The path to the output header file location.
   final String? headerOutPath;
+
+  /// Whether Flutter API methods take a deadline and cancellation token.
+  final bool cancellableFlutterApis;
+
+  /// Whether each API gets a table of its channel names and method signatures.
+  final bool channelNameTables;
 }
 
 /// Class that manages all Cpp code generation.
@@ -221,10 +271,20 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
       'flutter/standard_message_codec.h',
     ]);
     indent.newln();
+    final bool cancellable = _hasCancellableFlutterApis(
+      generatorOptions,
+      root,
+    );
+    final bool flutterApiChannelNames =
+        generatorOptions.channelNameTables &&
+        root.apis.any((Api api) => api is AstFlutterApi);
     _writeSystemHeaderIncludeBlock(indent, <String>[
+      if (cancellable) 'chrono',
       'map',
+      if (cancellable || flutterApiChannelNames) 'memory',
       'string',
       'optional',
+      if (cancellable || flutterApiChannelNames) 'vector',
     ]);
     indent.newln();
     if (generatorOptions.namespace != null) {
@@ -278,6 +338,9 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
     required String dartPackageName,
   }) {
     _writeFlutterError(indent);
+    if (_hasCancellableFlutterApis(generatorOptions, root)) {
+      _writeFlutterApiCallOptions(indent);
+    }
     if (root.containsHostApi) {
       _writeErrorOr(
         indent,
@@ -613,6 +676,9 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
             'const std::string& message_channel_suffix',
           ],
         );
+        if (hasSyncedArguments(api)) {
+          _writeFunctionDeclaration(indent, '~${api.name}');
+        }
         _writeFunctionDeclaration(
           indent,
           'GetCodec',
@@ -646,6 +712,8 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
           final parameters = <String>[
             ...map2(argTypes, argNames, (String x, String y) => '$x $y'),
             ..._flutterApiCallbackParameters(returnType),
+            if (generatorOptions.cancellableFlutterApis)
+              'const FlutterApiCallOptions& call_options = {}',
           ];
           _writeFunctionDeclaration(
             indent,
@@ -654,10 +722,36 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
             parameters: parameters,
           );
         }
+        if (generatorOptions.cancellableFlutterApis) {
+          indent.writeln(
+            '$_commentPrefix Fails the calls whose deadline has passed with a "timeout" error.',
+          );
+          indent.writeln(
+            '$_commentPrefix Returns the number of calls that were failed.',
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'ReapExpiredCalls',
+            returnType: 'size_t',
+          );
+        }
       });
       indent.addScoped(' private:', null, () {
         indent.writeln('flutter::BinaryMessenger* binary_messenger_;');
         indent.writeln('std::string message_channel_suffix_;');
+        if (generatorOptions.channelNameTables) {
+          indent.writeln(
+            '$_commentPrefix The suffixed channel name of each method, in declaration order.',
+          );
+          indent.writeln(
+            'std::shared_ptr<const std::vector<std::string>> channel_names_;',
+          );
+        }
+        if (generatorOptions.cancellableFlutterApis) {
+          indent.writeln(
+            'std::shared_ptr<PigeonInternalPendingCalls> pending_calls_;',
+          );
+        }
       });
     }, nestCount: 0);
     indent.newln();
@@ -853,6 +947,40 @@ class FlutterError {
 };''');
   }
 
+  void _writeFlutterApiCallOptions(Indent indent) {
+    indent.format('''
+
+class PigeonInternalCancellationState;
+class PigeonInternalPendingCalls;
+
+$_commentPrefix Cancels the Flutter API calls it is passed to.
+$_commentPrefix
+$_commentPrefix Copies of a token share their state, so one token can cancel several calls.
+class CancellationToken {
+ public:
+	CancellationToken();
+
+	$_commentPrefix Fails the pending calls made with this token with a "cancelled" error.
+	$_commentPrefix Later calls made with this token fail without being sent.
+	void Cancel();
+	bool is_cancelled() const;
+
+ private:
+	friend class PigeonInternalPendingCalls;
+	std::shared_ptr<PigeonInternalCancellationState> state_;
+};
+
+$_commentPrefix Options for a call to a Flutter API.
+struct FlutterApiCallOptions {
+	$_commentPrefix If set, the call fails with a "timeout" error when no reply has been
+	$_commentPrefix received by this time. Expired calls are failed together by the next
+	$_commentPrefix call to the same API instance, or by its ReapExpiredCalls method.
+	std::optional<std::chrono::steady_clock::time_point> deadline;
+	$_commentPrefix If set, cancelling this token fails the call with a "cancelled" error.
+	std::optional<CancellationToken> cancellation_token;
+};''');
+  }
+
   void _writeErrorOr(
     Indent indent, {
     Iterable<String> friends = const <String>[],
@@ -936,10 +1064,27 @@ class CppSourceGenerator extends StructuredGenerator<InternalCppOptions> {
       'flutter/standard_message_codec.h',
     ]);
     indent.newln();
+    final bool cancellable = _hasCancellableFlutterApis(
+      generatorOptions,
+      root,
+    );
+    final bool channelNameTables = _hasChannelNameTables(
+      generatorOptions,
+      root,
+    );
+    final bool synced = hasSyncedFlutterApiArguments(root);
     _writeSystemHeaderIncludeBlock(indent, <String>[
+      if (hasCompressedApis(root) || cancellable) 'algorithm',
+      if (cancellable) 'chrono',
+      if (hasCompressedApis(root)) 'cstring',
       'map',
+      if (cancellable || channelNameTables || synced) 'memory',
       'string',
+      if (channelNameTables) 'string_view',
       'optional',
+      if (synced) 'tuple',
+      if (hasCompressedApis(root) || cancellable || channelNameTables)
+        'vector',
     ]);
     indent.newln();
   }
@@ -988,6 +1133,391 @@ class CppSourceGenerator extends StructuredGenerator<InternalCppOptions> {
       EncodableValue(""));''');
       },
     );
+    if (_hasChannelNameTables(generatorOptions, root)) {
+      _writeChannelNameTableUtilities(indent);
+    }
+    if (_hasCancellableFlutterApis(generatorOptions, root)) {
+      _writeCancellationUtilities(indent);
+    }
+    if (hasCompressedApis(root)) {
+      _writeCompressionUtilities(indent);
+    }
+    if (hasSyncedFlutterApiArguments(root)) {
+      _writeSyncedUtilities(indent);
+    }
+  }
+
+  void _writeSyncedUtilities(Indent indent) {
+    indent.format('''
+$_commentPrefix Returns the last value sent for each @Synced argument, keyed by the
+$_commentPrefix messenger, channel and argument index it was sent with.
+std::map<std::tuple<flutter::BinaryMessenger*, std::string, size_t>, std::shared_ptr<std::shared_ptr<const EncodableList>>>& GetSyncedSnapshots() {
+	static auto* snapshots = new std::map<std::tuple<flutter::BinaryMessenger*, std::string, size_t>, std::shared_ptr<std::shared_ptr<const EncodableList>>>();
+	return *snapshots;
+}
+
+$_commentPrefix Returns where the last value sent for the @Synced argument at `index` of
+$_commentPrefix the method on `channel_name` is stored. Flutter keeps one value per
+$_commentPrefix channel, so it is shared by every API instance that sends on the channel.
+$_commentPrefix Calls in flight hold on to the returned storage, so it stays valid after
+$_commentPrefix ClearSyncedSnapshots removes it.
+std::shared_ptr<std::shared_ptr<const EncodableList>> GetSyncedSnapshot(flutter::BinaryMessenger* binary_messenger, const std::string& channel_name, size_t index) {
+	std::shared_ptr<std::shared_ptr<const EncodableList>>& snapshot = GetSyncedSnapshots()[std::make_tuple(binary_messenger, channel_name, index)];
+	if (!snapshot) {
+		snapshot = std::make_shared<std::shared_ptr<const EncodableList>>();
+	}
+	return snapshot;
+}
+
+$_commentPrefix Forgets the values sent on `channel_name` with `binary_messenger`, so the
+$_commentPrefix next call sends them in full.
+void ClearSyncedSnapshots(flutter::BinaryMessenger* binary_messenger, const std::string& channel_name) {
+	auto& snapshots = GetSyncedSnapshots();
+	auto it = snapshots.lower_bound(std::make_tuple(binary_messenger, channel_name, size_t{0}));
+	while (it != snapshots.end() && std::get<0>(it->first) == binary_messenger && std::get<1>(it->first) == channel_name) {
+		it = snapshots.erase(it);
+	}
+}
+
+$_commentPrefix Returns the fields of `values` that differ from `snapshot` as a flat list
+$_commentPrefix of alternating field indices and values, or std::nullopt if the full
+$_commentPrefix value has to be sent. Stores `values` as the new snapshot.
+std::optional<EncodableList> CreateSyncedPatch(std::shared_ptr<const EncodableList>* snapshot, EncodableList values) {
+	std::optional<EncodableList> patch;
+	if (*snapshot && (*snapshot)->size() == values.size()) {
+		patch = EncodableList();
+		for (size_t i = 0; i < values.size(); ++i) {
+			if (!(values[i] == (**snapshot)[i])) {
+				patch->push_back(EncodableValue(static_cast<int32_t>(i)));
+				patch->push_back(values[i]);
+			}
+		}
+	}
+	*snapshot = std::make_shared<const EncodableList>(std::move(values));
+	return patch;
+}
+
+$_commentPrefix Returns the reply handler of a Flutter API call with @Synced arguments,
+$_commentPrefix which passes the decoded reply to `on_reply`. `resend_in_full` is set
+$_commentPrefix if the call sent patches. If Flutter replies that it no longer has the
+$_commentPrefix values they were made against, e.g. after a hot restart, it is called to
+$_commentPrefix send the full values instead, and its reply is handled in the same way.
+flutter::BinaryReply CreateSyncedReplyHandler(const flutter::MessageCodec<EncodableValue>* codec, std::function<void(flutter::BinaryReply)> resend_in_full, std::function<void(std::unique_ptr<EncodableValue>)> on_reply) {
+	return [codec, resend_in_full = std::move(resend_in_full), on_reply = std::move(on_reply)](const uint8_t* reply, size_t reply_size) {
+		std::unique_ptr<EncodableValue> response = codec->DecodeMessage(reply, reply_size);
+		const auto* list = std::get_if<EncodableList>(response.get());
+		const auto* code = list && list->size() > 1 ? std::get_if<std::string>(&list->at(0)) : nullptr;
+		if (resend_in_full && code && *code == "synced-state-missing") {
+			resend_in_full(CreateSyncedReplyHandler(codec, nullptr, on_reply));
+			return;
+		}
+		on_reply(std::move(response));
+	};
+}''');
+    indent.newln();
+  }
+
+  void _writeChannelNameTableUtilities(Indent indent) {
+    indent.format('''
+$_commentPrefix The channel name and signature of an API method.
+struct PigeonInternalMethodInfo {
+	std::string_view channel_name;
+	$_commentPrefix The number of arguments the method takes.
+	size_t arity;
+	$_commentPrefix The Dart signature of the method, e.g. `int add(int a, int b)`.
+	std::string_view signature;
+};
+
+$_commentPrefix Returns the channel names of `methods` with `suffix` appended.
+template <size_t N>
+std::shared_ptr<const std::vector<std::string>> PigeonInternalCreateChannelNames(const PigeonInternalMethodInfo (&methods)[N], const std::string& suffix) {
+	auto channel_names = std::make_shared<std::vector<std::string>>();
+	channel_names->reserve(N);
+	for (const PigeonInternalMethodInfo& method : methods) {
+		std::string channel_name(method.channel_name);
+		channel_name += suffix;
+		channel_names->push_back(std::move(channel_name));
+	}
+	return channel_names;
+}''');
+    indent.newln();
+  }
+
+  // Writes the table of the channel names and signatures of [api]'s methods.
+  void _writeMethodTable(Indent indent, Api api, String dartPackageName) {
+    indent.writeln(
+      '$_commentPrefix The channel names and signatures of the methods of ${api.name}.',
+    );
+    indent.writeScoped(
+      'constexpr PigeonInternalMethodInfo ${_methodTableName(api)}[] = {',
+      '};',
+      () {
+        for (final Method method in api.methods) {
+          final String parameters = method.parameters
+              .map(
+                (Parameter parameter) =>
+                    '${_dartTypeName(parameter.type)} ${parameter.name}',
+              )
+              .join(', ');
+          indent.writeln(
+            '{"${makeChannelName(api, method, dartPackageName)}", ${method.parameters.length}, "${_dartTypeName(method.returnType)} ${method.name}($parameters)"},',
+          );
+        }
+      },
+    );
+    indent.newln();
+  }
+
+  void _writeCancellationUtilities(Indent indent) {
+    indent.format('''
+FlutterError CreateTimeoutError(const std::string channel_name) {
+	return FlutterError(
+			"timeout",
+			"Timed out waiting for a reply on channel: '" + channel_name + "'.",
+			EncodableValue(""));
+}
+
+FlutterError CreateCancelledError(const std::string channel_name) {
+	return FlutterError(
+			"cancelled",
+			"The call on channel: '" + channel_name + "' was cancelled.",
+			EncodableValue(""));
+}
+
+$_commentPrefix A Flutter API call made with a deadline or cancellation token.
+struct PigeonInternalPendingCall {
+	std::string channel_name;
+	$_commentPrefix Handles the reply to the call. Cleared when the call completes, which
+	$_commentPrefix releases the callbacks it holds even if Dart never replies.
+	flutter::BinaryReply reply;
+	std::optional<std::chrono::steady_clock::time_point> deadline;
+};
+
+$_commentPrefix Completes `call` with `reply` unless it has already completed.
+void PigeonInternalCompleteCall(PigeonInternalPendingCall* call, const uint8_t* reply, size_t reply_size) {
+	if (!call->reply) {
+		return;
+	}
+	flutter::BinaryReply handler = std::move(call->reply);
+	call->reply = nullptr;
+	handler(reply, reply_size);
+}
+
+$_commentPrefix Completes `call` with the reply Dart sends for `error`, unless it has
+$_commentPrefix already completed.
+void PigeonInternalFailCall(PigeonInternalPendingCall* call, const FlutterError& error) {
+	std::unique_ptr<std::vector<uint8_t>> reply = flutter::StandardMessageCodec::GetInstance().EncodeMessage(EncodableValue(EncodableList{
+		EncodableValue(error.code()),
+		EncodableValue(error.message()),
+		error.details(),
+	}));
+	PigeonInternalCompleteCall(call, reply->data(), reply->size());
+}
+
+class PigeonInternalCancellationState {
+ public:
+	bool cancelled = false;
+	$_commentPrefix The calls made with the token. Completed calls are pruned when the
+	$_commentPrefix list needs to grow.
+	std::vector<std::weak_ptr<PigeonInternalPendingCall>> calls;
+};
+
+CancellationToken::CancellationToken()
+		: state_(std::make_shared<PigeonInternalCancellationState>()) {}
+
+void CancellationToken::Cancel() {
+	if (state_->cancelled) {
+		return;
+	}
+	state_->cancelled = true;
+	$_commentPrefix Take the list first, since the error callbacks may make new calls.
+	std::vector<std::weak_ptr<PigeonInternalPendingCall>> calls = std::move(state_->calls);
+	state_->calls.clear();
+	for (const std::weak_ptr<PigeonInternalPendingCall>& weak_call : calls) {
+		if (std::shared_ptr<PigeonInternalPendingCall> call = weak_call.lock()) {
+			PigeonInternalFailCall(call.get(), CreateCancelledError(call->channel_name));
+		}
+	}
+}
+
+bool CancellationToken::is_cancelled() const { return state_->cancelled; }
+
+$_commentPrefix The calls with a deadline made on one Flutter API instance.
+class PigeonInternalPendingCalls {
+ public:
+	$_commentPrefix Returns the reply handler to send a call on `channel_name` with. It
+	$_commentPrefix forwards to `reply` unless the call has timed out or been cancelled.
+	flutter::BinaryReply Track(const std::string& channel_name, flutter::BinaryReply reply, const FlutterApiCallOptions& options) {
+		ReapExpired();
+		if (!options.deadline && !options.cancellation_token) {
+			return reply;
+		}
+		auto call = std::make_shared<PigeonInternalPendingCall>();
+		call->channel_name = channel_name;
+		call->reply = std::move(reply);
+		call->deadline = options.deadline;
+		if (options.deadline) {
+			calls_.push_back(call);
+			next_deadline_ = std::min(next_deadline_, *options.deadline);
+		}
+		if (options.cancellation_token) {
+			std::vector<std::weak_ptr<PigeonInternalPendingCall>>& token_calls = options.cancellation_token->state_->calls;
+			if (token_calls.size() == token_calls.capacity()) {
+				token_calls.erase(std::remove_if(token_calls.begin(), token_calls.end(), [](const std::weak_ptr<PigeonInternalPendingCall>& weak_call) {
+					std::shared_ptr<PigeonInternalPendingCall> token_call = weak_call.lock();
+					return !token_call || !token_call->reply;
+				}), token_calls.end());
+			}
+			token_calls.push_back(call);
+		}
+		return [call](const uint8_t* reply, size_t reply_size) {
+			PigeonInternalCompleteCall(call.get(), reply, reply_size);
+		};
+	}
+
+	$_commentPrefix Fails the calls whose deadline has passed, and returns how many there
+	$_commentPrefix were.
+	$_commentPrefix
+	$_commentPrefix The calls are only swept once the earliest deadline has passed, or
+	$_commentPrefix once enough calls may have completed to be worth pruning.
+	size_t ReapExpired() {
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now < next_deadline_ && calls_.size() < sweep_size_) {
+			return 0;
+		}
+		std::vector<std::shared_ptr<PigeonInternalPendingCall>> expired;
+		next_deadline_ = std::chrono::steady_clock::time_point::max();
+		calls_.erase(std::remove_if(calls_.begin(), calls_.end(), [&](const std::shared_ptr<PigeonInternalPendingCall>& call) {
+			if (!call->reply) {
+				return true;
+			}
+			if (*call->deadline <= now) {
+				expired.push_back(call);
+				return true;
+			}
+			next_deadline_ = std::min(next_deadline_, *call->deadline);
+			return false;
+		}), calls_.end());
+		sweep_size_ = std::max(kMinimumSweepSize, calls_.size() * 2);
+		$_commentPrefix Fail the calls after updating the list, since the error callbacks may
+		$_commentPrefix make new calls.
+		for (const std::shared_ptr<PigeonInternalPendingCall>& call : expired) {
+			PigeonInternalFailCall(call.get(), CreateTimeoutError(call->channel_name));
+		}
+		return expired.size();
+	}
+
+ private:
+	static constexpr size_t kMinimumSweepSize = 16;
+
+	std::vector<std::shared_ptr<PigeonInternalPendingCall>> calls_;
+	std::chrono::steady_clock::time_point next_deadline_ = std::chrono::steady_clock::time_point::max();
+	size_t sweep_size_ = kMinimumSweepSize;
+};''');
+    indent.newln();
+  }
+
+  void _writeCompressionUtilities(Indent indent) {
+    indent.format('''
+$_commentPrefix A message that the codec LZ4 compresses if its encoding is larger than
+$_commentPrefix the compression threshold of its API.
+struct $_compressibleMessageClassName {
+	EncodableValue value;
+	size_t threshold;
+};''');
+    indent.newln();
+    indent.format('''
+$_commentPrefix Collects the bytes written to it at the end of `buffer`.
+class $_vectorWriterClassName : public flutter::ByteStreamWriter {
+ public:
+	explicit $_vectorWriterClassName(std::vector<uint8_t>* buffer) : buffer_(buffer) {}
+
+	void WriteByte(uint8_t byte) override { buffer_->push_back(byte); }
+
+	void WriteBytes(const uint8_t* bytes, size_t length) override {
+		buffer_->insert(buffer_->end(), bytes, bytes + length);
+	}
+
+	void WriteAlignment(uint8_t alignment) override {
+		buffer_->resize((buffer_->size() + alignment - 1) / alignment * alignment);
+	}
+
+ private:
+	std::vector<uint8_t>* buffer_;
+};''');
+    indent.newln();
+    indent.format('''
+$_commentPrefix Compresses `length` bytes of `input` using the LZ4 block format.
+std::vector<uint8_t> $_compressLz4FunctionName(const uint8_t* input, size_t length) {
+	constexpr size_t kHashBits = 12;
+	$_commentPrefix The last match must start at least 12 bytes before the end of the
+	$_commentPrefix input, and the last 5 bytes are always literals.
+	constexpr size_t kMatchStartLimit = 12;
+	constexpr size_t kLastLiterals = 5;
+	std::vector<uint8_t> output;
+	output.reserve(length + length / 255 + 16);
+	auto write_length = [&output](size_t value) {
+		for (; value >= 255; value -= 255) {
+			output.push_back(255);
+		}
+		output.push_back(static_cast<uint8_t>(value));
+	};
+	$_commentPrefix Positions are stored plus one so that zero means no entry.
+	std::vector<size_t> table(size_t{1} << kHashBits, 0);
+	size_t anchor = 0;
+	size_t position = 0;
+	while (length > kMatchStartLimit && position < length - kMatchStartLimit) {
+		uint32_t sequence;
+		memcpy(&sequence, input + position, sizeof(sequence));
+		const size_t hash = (sequence * 2654435761u) >> (32 - kHashBits);
+		const size_t candidate = table[hash];
+		table[hash] = position + 1;
+		if (candidate == 0 || position + 1 - candidate > 65535 ||
+				memcmp(input + candidate - 1, input + position, 4) != 0) {
+			position++;
+			continue;
+		}
+		const size_t match = candidate - 1;
+		size_t match_length = 4;
+		while (position + match_length < length - kLastLiterals &&
+				input[match + match_length] == input[position + match_length]) {
+			match_length++;
+		}
+		const size_t literal_length = position - anchor;
+		output.push_back(static_cast<uint8_t>(
+				(std::min<size_t>(literal_length, 15) << 4) |
+				std::min<size_t>(match_length - 4, 15)));
+		if (literal_length >= 15) {
+			write_length(literal_length - 15);
+		}
+		output.insert(output.end(), input + anchor, input + position);
+		const size_t offset = position - match;
+		output.push_back(static_cast<uint8_t>(offset & 0xff));
+		output.push_back(static_cast<uint8_t>(offset >> 8));
+		if (match_length - 4 >= 15) {
+			write_length(match_length - 4 - 15);
+		}
+		position += match_length;
+		anchor = position;
+	}
+	const size_t literal_length = length - anchor;
+	output.push_back(
+			static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4));
+	if (literal_length >= 15) {
+		write_length(literal_length - 15);
+	}
+	output.insert(output.end(), input + anchor, input + length);
+	return output;
+}''');
+    indent.newln();
+    indent.format('''
+$_commentPrefix Returns `value` wrapped so that the codec LZ4 compresses its encoding if
+$_commentPrefix it is longer than `threshold` bytes and compression makes it smaller.
+EncodableValue $_compressMessageFunctionName(EncodableValue value, size_t threshold) {
+	return CustomEncodableValue(
+			$_compressibleMessageClassName{std::move(value), threshold});
+}''');
+    indent.newln();
   }
 
   @override
@@ -1236,9 +1766,10 @@ EncodableValue $_overflowClassName::FromEncodableList(
   void _writeCodecDecode(
     Indent indent,
     EnumeratedType customType,
-    String value,
-  ) {
-    indent.addScoped('{', '}', () {
+    String value, {
+    bool scoped = true,
+  }) {
+    void writeDecode() {
       if (customType.type == CustomTypes.customClass) {
         if (customType.name == _overflowClassName) {
           indent.writeln(
@@ -1258,6 +1789,35 @@ EncodableValue $_overflowClassName::FromEncodableList(
           'return encodable_enum_arg.IsNull() ? EncodableValue() : CustomEncodableValue(static_cast<${customType.name}>(enum_arg_value));',
         );
       }
+    }
+
+    if (scoped) {
+      indent.addScoped('{', '}', writeDecode);
+    } else {
+      writeDecode();
+    }
+  }
+
+  // Writes the decoding of an enum value that reads the integer directly from
+  // [stream], rather than going through an intermediate [EncodableValue].
+  void _writeCodecEnumDecode(Indent indent, EnumeratedType customType) {
+    indent.addScoped('{', '}', () {
+      indent.writeln('const uint8_t enum_arg_type = stream->ReadByte();');
+      indent.writeScoped(
+        'if (enum_arg_type == $_encodedInt32TypeName) {',
+        '}',
+        () {
+          indent.writeln(
+            'return CustomEncodableValue(static_cast<${customType.name}>(stream->ReadInt32()));',
+          );
+        },
+      );
+      _writeCodecDecode(
+        indent,
+        customType,
+        'ReadValueOfType(enum_arg_type, stream)',
+        scoped: false,
+      );
     });
   }
 
@@ -1282,6 +1842,17 @@ EncodableValue $_overflowClassName::FromEncodableList(
         dartPackageName: dartPackageName,
       );
     }
+    if (enumeratedTypes.any(
+      (EnumeratedType t) =>
+          t.type == CustomTypes.customEnum &&
+          t.enumeration < maximumCodecFieldKey,
+    )) {
+      indent.writeln(
+        '$_commentPrefix The standard codec type tag for a 32-bit integer, used to encode enum values.',
+      );
+      indent.writeln('constexpr uint8_t $_encodedInt32TypeName = 3;');
+      indent.newln();
+    }
     _writeFunctionDefinition(
       indent,
       _codecSerializerName,
@@ -1302,7 +1873,11 @@ EncodableValue $_overflowClassName::FromEncodableList(
             if (customType.enumeration < maximumCodecFieldKey) {
               indent.write('case ${customType.enumeration}: ');
               indent.nest(1, () {
-                _writeCodecDecode(indent, customType, 'ReadValue(stream)');
+                if (customType.type == CustomTypes.customEnum) {
+                  _writeCodecEnumDecode(indent, customType);
+                } else {
+                  _writeCodecDecode(indent, customType, 'ReadValue(stream)');
+                }
               });
             }
           }
@@ -1334,7 +1909,7 @@ EncodableValue $_overflowClassName::FromEncodableList(
       ],
       isConst: true,
       body: () {
-        if (enumeratedTypes.isNotEmpty) {
+        if (enumeratedTypes.isNotEmpty || hasCompressedApis(root)) {
           indent.write(
             'if (const CustomEncodableValue* custom_value = std::get_if<CustomEncodableValue>(&value)) ',
           );
@@ -1355,6 +1930,15 @@ EncodableValue $_overflowClassName::FromEncodableList(
               );
               indent.addScoped('{', '}', () {
                 indent.writeln('stream->WriteByte($enumeration);');
+                if (customType.type == CustomTypes.customEnum &&
+                    enumeration != maximumCodecFieldKey) {
+                  indent.writeln('stream->WriteByte($_encodedInt32TypeName);');
+                  indent.writeln(
+                    'stream->WriteInt32(static_cast<int32_t>(std::any_cast<${customType.name}>(*custom_value)));',
+                  );
+                  indent.writeln('return;');
+                  return;
+                }
                 if (enumeration == maximumCodecFieldKey) {
                   indent.writeln(
                     'const auto wrap = $_overflowClassName(${customType.enumeration - maximumCodecFieldKey}, $encodeString);',
@@ -1366,6 +1950,54 @@ EncodableValue $_overflowClassName::FromEncodableList(
                 indent.writeln('return;');
               });
             }
+            if (hasCompressedApis(root)) {
+              indent.write(
+                'if (custom_value->type() == typeid($_compressibleMessageClassName)) ',
+              );
+              indent.addScoped('{', '}', () {
+                indent.writeln(
+                  'const auto& message = std::any_cast<const $_compressibleMessageClassName&>(*custom_value);',
+                );
+                indent.writeln(
+                  '$_commentPrefix The message is always the whole value being encoded, so its',
+                );
+                indent.writeln(
+                  '$_commentPrefix encoding also starts at offset zero of `stream` and can be copied',
+                );
+                indent.writeln('$_commentPrefix unchanged.');
+                indent.writeln('std::vector<uint8_t> encoded;');
+                indent.writeln('$_vectorWriterClassName writer(&encoded);');
+                indent.writeln('WriteValue(message.value, &writer);');
+                indent.writeScoped(
+                  'if (encoded.size() > message.threshold) {',
+                  '}',
+                  () {
+                    indent.writeln(
+                      'std::vector<uint8_t> compressed = $_compressLz4FunctionName(encoded.data(), encoded.size());',
+                    );
+                    indent.writeScoped(
+                      'if (compressed.size() < encoded.size()) {',
+                      '}',
+                      () {
+                        indent.writeln(
+                          'stream->WriteByte($compressedMessageCodecKey);',
+                        );
+                        indent.writeln('WriteSize(encoded.size(), stream);');
+                        indent.writeln('WriteSize(compressed.size(), stream);');
+                        indent.writeln(
+                          'stream->WriteBytes(compressed.data(), compressed.size());',
+                        );
+                        indent.writeln('return;');
+                      },
+                    );
+                  },
+                );
+                indent.writeln(
+                  'stream->WriteBytes(encoded.data(), encoded.size());',
+                );
+                indent.writeln('return;');
+              });
+            }
           });
         }
         indent.writeln('$_standardCodecSerializer::WriteValue(value, stream);');
@@ -1381,6 +2013,13 @@ EncodableValue $_overflowClassName::FromEncodableList(
     AstFlutterApi api, {
     required String dartPackageName,
   }) {
+    final pendingCallsInitializers = <String>[
+      if (generatorOptions.cancellableFlutterApis)
+        'pending_calls_(std::make_shared<PigeonInternalPendingCalls>())',
+    ];
+    if (_hasMethodTable(generatorOptions, api)) {
+      _writeMethodTable(indent, api, dartPackageName);
+    }
     indent.writeln(
       '$_commentPrefix Generated class from Pigeon that represents Flutter messages that can be called from C++.',
     );
@@ -1392,6 +2031,9 @@ EncodableValue $_overflowClassName::FromEncodableList(
       initializers: <String>[
         'binary_messenger_(binary_messenger)',
         'message_channel_suffix_("")',
+        if (_hasMethodTable(generatorOptions, api))
+          'channel_names_(PigeonInternalCreateChannelNames(${_methodTableName(api)}, message_channel_suffix_))',
+        ...pendingCallsInitializers,
       ],
     );
     _writeFunctionDefinition(
@@ -1405,8 +2047,36 @@ EncodableValue $_overflowClassName::FromEncodableList(
       initializers: <String>[
         'binary_messenger_(binary_messenger)',
         'message_channel_suffix_(message_channel_suffix.length() > 0 ? std::string(".") + message_channel_suffix : "")',
+        if (_hasMethodTable(generatorOptions, api))
+          'channel_names_(PigeonInternalCreateChannelNames(${_methodTableName(api)}, message_channel_suffix_))',
+        ...pendingCallsInitializers,
       ],
     );
+    if (hasSyncedArguments(api)) {
+      _writeFunctionDefinition(
+        indent,
+        '~${api.name}',
+        scope: api.name,
+        body: () {
+          indent.writeln(
+            '$_commentPrefix Forget the @Synced values sent by this instance, since a later messenger may be allocated at the same address.',
+          );
+          for (final Method func in api.methods) {
+            if (!func.parameters.any(
+              (Parameter param) => isSyncedArgumentType(param.type),
+            )) {
+              continue;
+            }
+            final String channelName = generatorOptions.channelNameTables
+                ? '(*channel_names_)[${api.methods.indexOf(func)}]'
+                : '"${makeChannelName(api, func, dartPackageName)}" + message_channel_suffix_';
+            indent.writeln(
+              'ClearSyncedSnapshots(binary_messenger_, $channelName);',
+            );
+          }
+        },
+      );
+    }
     _writeFunctionDefinition(
       indent,
       'GetCodec',
@@ -1446,6 +2116,8 @@ EncodableValue $_overflowClassName::FromEncodableList(
               '${_flutterApiArgumentType(arg.hostType)} ${arg.name}',
         ),
         ..._flutterApiCallbackParameters(returnType),
+        if (generatorOptions.cancellableFlutterApis)
+          'const FlutterApiCallOptions& call_options',
       ];
       _writeFunctionDefinition(
         indent,
@@ -1454,55 +2126,213 @@ EncodableValue $_overflowClassName::FromEncodableList(
         returnType: _voidType,
         parameters: parameters,
         body: () {
-          indent.writeln(
-            'const std::string channel_name = "${makeChannelName(api, func, dartPackageName)}" + message_channel_suffix_;',
-          );
+          final int methodIndex = api.methods.indexOf(func);
+          if (generatorOptions.channelNameTables) {
+            indent.writeln(
+              'const std::string& channel_name = (*channel_names_)[$methodIndex];',
+            );
+          } else {
+            indent.writeln(
+              'const std::string channel_name = "${makeChannelName(api, func, dartPackageName)}" + message_channel_suffix_;',
+            );
+          }
+          if (generatorOptions.cancellableFlutterApis) {
+            indent.writeScoped(
+              'if (call_options.cancellation_token && call_options.cancellation_token->is_cancelled()) {',
+              '}',
+              () {
+                indent.writeln('on_error(CreateCancelledError(channel_name));');
+                indent.writeln('return;');
+              },
+            );
+          }
           indent.writeln(
             'BasicMessageChannel<> channel(binary_messenger_, '
             'channel_name, &GetCodec());',
           );
 
-          // Convert arguments to EncodableValue versions.
+          // Diff @Synced arguments against the last values sent on the
+          // channel.
+          final List<_HostNamedType> parameterList = hostParameters.toList();
+          final syncedIndices = <int>[
+            for (var i = 0; i < parameterList.length; i++)
+              if (isSyncedArgumentType(parameterList[i].originalType)) i,
+          ];
+          final List<_HostNamedType> syncedParameters = syncedIndices
+              .map((int i) => parameterList[i])
+              .toList();
+          final bool hasSyncedParameters = syncedParameters.isNotEmpty;
+          for (final int index in syncedIndices) {
+            final _HostNamedType param = parameterList[index];
+            indent.writeln(
+              'std::shared_ptr<std::shared_ptr<const EncodableList>> ${param.name}_snapshot = GetSyncedSnapshot(binary_messenger_, channel_name, $index);',
+            );
+            indent.writeln(
+              'std::optional<EncodableList> ${param.name}_patch = CreateSyncedPatch(${param.name}_snapshot.get(), ${param.name}.ToEncodableList());',
+            );
+          }
+
+          // Convert arguments to EncodableValue versions. The arguments of
+          // calls with @Synced arguments are shared with the resend below.
           const argumentListVariableName = 'encoded_api_arguments';
-          indent.write('EncodableValue $argumentListVariableName = ');
+          if (hasSyncedParameters) {
+            indent.write(
+              'auto $argumentListVariableName = std::make_shared<EncodableValue>(',
+            );
+          } else {
+            indent.write('EncodableValue $argumentListVariableName = ');
+          }
+          final String argumentListEnd = hasSyncedParameters ? '}));' : '});';
           if (func.parameters.isEmpty) {
             indent.addln('EncodableValue();');
           } else {
-            indent.addScoped('EncodableValue(EncodableList{', '});', () {
-              for (final param in hostParameters) {
-                final String encodedArgument =
-                    _wrappedHostApiArgumentExpression(
-                      root,
-                      param.name,
-                      param.originalType,
-                      param.hostType,
-                      false,
+            indent.addScoped(
+              'EncodableValue(EncodableList{',
+              argumentListEnd,
+              () {
+                for (final param in hostParameters) {
+                  final String encodedArgument =
+                      _wrappedHostApiArgumentExpression(
+                        root,
+                        param.name,
+                        param.originalType,
+                        param.hostType,
+                        false,
+                      );
+                  if (isSyncedArgumentType(param.originalType)) {
+                    indent.writeln(
+                      '${param.name}_patch ? EncodableValue(std::move(*${param.name}_patch)) : EncodableValue($encodedArgument),',
                     );
-                indent.writeln('$encodedArgument,');
-              }
+                  } else {
+                    indent.writeln('$encodedArgument,');
+                  }
+                }
+              },
+            );
+          }
+
+          // The message sent for the arguments.
+          String message = hasSyncedParameters
+              ? '*$argumentListVariableName'
+              : argumentListVariableName;
+          if (api.compressionThreshold != null) {
+            if (hasSyncedParameters) {
+              message =
+                  '$_compressMessageFunctionName(EncodableValue($message), ${api.compressionThreshold})';
+            } else {
+              indent.writeln(
+                '$argumentListVariableName = $_compressMessageFunctionName(std::move($argumentListVariableName), ${api.compressionThreshold});',
+              );
+            }
+          }
+
+          final String channelNameCapture = generatorOptions.channelNameTables
+              ? 'channel_names = channel_names_'
+              : 'channel_name';
+          final String capturedChannelName = generatorOptions.channelNameTables
+              ? '(*channel_names)[$methodIndex]'
+              : 'channel_name';
+          if (hasSyncedParameters) {
+            indent.writeln(
+              '$_commentPrefix Sends the arguments again with the @Synced arguments in full, if Flutter no longer has the values the patches were made against.',
+            );
+            indent.writeln(
+              'std::function<void(flutter::BinaryReply)> resend_in_full;',
+            );
+            final String anyPatch = syncedParameters
+                .map((_HostNamedType param) => '${param.name}_patch')
+                .join(' || ');
+            final String fullCaptures = syncedParameters
+                .map(
+                  (_HostNamedType param) =>
+                      ', ${param.name}_snapshot, ${param.name}_full = *${param.name}_snapshot',
+                )
+                .join();
+            // The resend is tracked like the call it replaces, so it still
+            // fails at the deadline or when cancelled.
+            final String trackCaptures = generatorOptions.cancellableFlutterApis
+                ? ', pending_calls = pending_calls_, call_options'
+                : '';
+            indent.writeScoped('if ($anyPatch) {', '}', () {
+              indent.writeScoped(
+                'resend_in_full = [binary_messenger = binary_messenger_, $channelNameCapture, $argumentListVariableName$fullCaptures$trackCaptures](flutter::BinaryReply reply) {',
+                '};',
+                () {
+                  indent.writeln(
+                    'auto& arguments = std::get<EncodableList>(*$argumentListVariableName);',
+                  );
+                  for (final int index in syncedIndices) {
+                    final _HostNamedType param = parameterList[index];
+                    // Later calls must not send patches against a value that
+                    // Flutter receives out of order.
+                    indent.writeln('*${param.name}_snapshot = nullptr;');
+                    indent.writeln(
+                      'arguments[$index] = CustomEncodableValue(${param.hostType.datatype}::FromEncodableList(*${param.name}_full));',
+                    );
+                  }
+                  indent.writeln(
+                    'BasicMessageChannel<> channel(binary_messenger, $capturedChannelName, &GetCodec());',
+                  );
+                  if (generatorOptions.cancellableFlutterApis) {
+                    indent.writeln(
+                      'channel.Send($message, pending_calls->Track($capturedChannelName, std::move(reply), call_options));',
+                    );
+                  } else {
+                    indent.writeln('channel.Send($message, std::move(reply));');
+                  }
+                },
+              );
             });
           }
 
-          indent.write(
-            'channel.Send($argumentListVariableName, '
-            // ignore: missing_whitespace_between_adjacent_strings
-            '[channel_name, on_success = std::move(on_success), on_error = std::move(on_error)]'
-            '(const uint8_t* reply, size_t reply_size) ',
-          );
-          indent.addScoped('{', '});', () {
+          final String syncedSnapshotCaptures = syncedParameters
+              .map((_HostNamedType param) => ', ${param.name}_snapshot')
+              .join();
+          void writeSyncedSnapshotResets() {
+            for (final _HostNamedType param in syncedParameters) {
+              indent.writeln('*${param.name}_snapshot = nullptr;');
+            }
+          }
+
+          // Calls with a deadline or cancellation token are tracked, so their
+          // callbacks can be released if Dart never replies.
+          final String trackCall = generatorOptions.cancellableFlutterApis
+              ? 'pending_calls_->Track(channel_name, '
+              : '';
+          final captures =
+              '[$channelNameCapture, on_success = std::move(on_success), on_error = std::move(on_error)$syncedSnapshotCaptures]';
+          if (hasSyncedParameters) {
+            indent.write(
+              'channel.Send($message, ${trackCall}CreateSyncedReplyHandler(&GetCodec(), std::move(resend_in_full), '
+              '$captures(std::unique_ptr<EncodableValue> response) ',
+            );
+          } else {
+            indent.write(
+              'channel.Send($message, $trackCall'
+              '$captures(const uint8_t* reply, size_t reply_size) ',
+            );
+          }
+          final String replyHandlerEnd = hasSyncedParameters ? '})' : '}';
+          final String sendEnd = generatorOptions.cancellableFlutterApis
+              ? '$replyHandlerEnd, call_options));'
+              : '$replyHandlerEnd);';
+          indent.addScoped('{', sendEnd, () {
             String successCallbackArgument;
             successCallbackArgument = 'return_value';
             final encodedReplyName = 'encodable_$successCallbackArgument';
             final listReplyName = 'list_$successCallbackArgument';
-            indent.writeln(
-              'std::unique_ptr<EncodableValue> response = GetCodec().DecodeMessage(reply, reply_size);',
-            );
+            if (!hasSyncedParameters) {
+              indent.writeln(
+                'std::unique_ptr<EncodableValue> response = GetCodec().DecodeMessage(reply, reply_size);',
+              );
+            }
             indent.writeln('const auto& $encodedReplyName = *response;');
             indent.writeln(
               'const auto* $listReplyName = std::get_if<EncodableList>(&$encodedReplyName);',
             );
             indent.writeScoped('if ($listReplyName) {', '} ', () {
               indent.writeScoped('if ($listReplyName->size() > 1) {', '} ', () {
+                writeSyncedSnapshotResets();
                 indent.writeln(
                   'on_error(FlutterError(std::get<std::string>($listReplyName->at(0)), std::get<std::string>($listReplyName->at(1)), $listReplyName->at(2)));',
                 );
@@ -1524,12 +2354,28 @@ EncodableValue $_overflowClassName::FromEncodableList(
               });
             }, addTrailingNewline: false);
             indent.addScoped('else {', '} ', () {
-              indent.writeln('on_error(CreateConnectionError(channel_name));');
+              writeSyncedSnapshotResets();
+              indent.writeln(
+                generatorOptions.channelNameTables
+                    ? 'on_error(CreateConnectionError((*channel_names)[$methodIndex]));'
+                    : 'on_error(CreateConnectionError(channel_name));',
+              );
             });
           });
         },
       );
     }
+    if (generatorOptions.cancellableFlutterApis) {
+      _writeFunctionDefinition(
+        indent,
+        'ReapExpiredCalls',
+        scope: api.name,
+        returnType: 'size_t',
+        body: () {
+          indent.writeln('return pending_calls_->ReapExpired();');
+        },
+      );
+    }
   }
 
   @override
@@ -1540,6 +2386,9 @@ EncodableValue $_overflowClassName::FromEncodableList(
     AstHostApi api, {
     required String dartPackageName,
   }) {
+    if (_hasMethodTable(generatorOptions, api)) {
+      _writeMethodTable(indent, api, dartPackageName);
+    }
     indent.writeln('/// The codec used by ${api.name}.');
     _writeFunctionDefinition(
       indent,
@@ -1583,15 +2432,13 @@ EncodableValue $_overflowClassName::FromEncodableList(
           'const std::string prepended_suffix = message_channel_suffix.length() > 0 ? std::string(".") + message_channel_suffix : "";',
         );
         for (final Method method in api.methods) {
-          final String channelName = makeChannelName(
-            api,
-            method,
-            dartPackageName,
-          );
+          final String channelName = generatorOptions.channelNameTables
+              ? 'std::string(${_methodTableName(api)}[${api.methods.indexOf(method)}].channel_name)'
+              : '"${makeChannelName(api, method, dartPackageName)}"';
           indent.writeScoped('{', '}', () {
             indent.writeln(
               'BasicMessageChannel<> channel(binary_messenger, '
-              '"$channelName" + prepended_suffix, &GetCodec());',
+              '$channelName + prepended_suffix, &GetCodec());',
             );
             indent.writeScoped('if (api != nullptr) {', '} else {', () {
               indent.write(
@@ -1652,7 +2499,7 @@ EncodableValue $_overflowClassName::FromEncodableList(
                   if (method.isAsynchronous) {
                     methodArgument.add(
                       '[reply]($returnTypeName&& output) {${indent.newline}'
-                      '${_wrapResponse(indent, root, method.returnType, prefix: '\t')}${indent.newline}'
+                      '${_wrapResponse(indent, root, method.returnType, prefix: '\t', compressionThreshold: api.compressionThreshold)}${indent.newline}'
                       '}',
                     );
                   }
@@ -1663,7 +2510,12 @@ EncodableValue $_overflowClassName::FromEncodableList(
                   } else {
                     indent.writeln('$returnTypeName output = $call;');
                     indent.format(
-                      _wrapResponse(indent, root, method.returnType),
+                      _wrapResponse(
+                        indent,
+                        root,
+                        method.returnType,
+                        compressionThreshold: api.compressionThreshold,
+                      ),
                     );
                   }
                 }, addTrailingNewline: false);
@@ -1913,6 +2765,7 @@ return EncodableValue(EncodableList{
     Root root,
     TypeDeclaration returnType, {
     String prefix = '',
+    int? compressionThreshold,
   }) {
     final String nonErrorPath;
     final String errorCondition;
@@ -1951,6 +2804,9 @@ $prefix}''';
       errorCondition = 'output.has_error()';
       errorGetter = 'error';
     }
+    final replyValue = compressionThreshold == null
+        ? 'EncodableValue(std::move(wrapped))'
+        : '$_compressMessageFunctionName(EncodableValue(std::move(wrapped)), $compressionThreshold)';
     // Ideally this code would use an initializer list to create
     // an EncodableList inline, which would be less code. However,
     // that would always copy the element, so the slightly more
@@ -1962,7 +2818,7 @@ $prefix\treturn;
 $prefix}
 ${prefix}EncodableList wrapped;
 $nonErrorPath
-${prefix}reply(EncodableValue(std::move(wrapped)));''';
+${prefix}reply($replyValue);''';
   }
 
   @override
@@ -2168,6 +3024,36 @@ bool _isReferenceType(String dataType) {
   }
 }
 
+/// Returns true if [root] has APIs that get a table of their channel names.
+bool _hasChannelNameTables(InternalCppOptions options, Root root) {
+  return options.channelNameTables &&
+      root.apis.any((Api api) => api is AstHostApi || api is AstFlutterApi);
+}
+
+/// Returns true if [api] gets a table of its channel names and signatures.
+bool _hasMethodTable(InternalCppOptions options, Api api) {
+  // The table can't be empty, and APIs without methods don't use it.
+  return options.channelNameTables && api.methods.isNotEmpty;
+}
+
+/// Returns the name of the table of [api]'s channel names and signatures.
+String _methodTableName(Api api) => 'k${api.name}Methods';
+
+/// Returns the Dart spelling of [type], as used in method signatures.
+String _dartTypeName(TypeDeclaration type) {
+  final String typeArguments = type.typeArguments.isEmpty
+      ? ''
+      : '<${type.typeArguments.map(_dartTypeName).join(', ')}>';
+  return '${type.baseName}$typeArguments${type.isNullable ? '?' : ''}';
+}
+
+/// Returns true if [root] has Flutter APIs whose methods take a deadline and
+/// cancellation token.
+bool _hasCancellableFlutterApis(InternalCppOptions options, Root root) {
+  return options.cancellableFlutterApis &&
+      root.apis.any((Api api) => api is AstFlutterApi);
+}
+
 /// Returns the parameters to use for the success and error callbacks in a
 /// Flutter API function signature.
 List<String> _flutterApiCallbackParameters(HostDatatype returnType) {
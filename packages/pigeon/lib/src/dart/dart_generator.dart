@@ -498,6 +498,21 @@ class DartGenerator extends StructuredGenerator<InternalDartOptions> {
           if (root.requiresOverflowClass) {
             writeDecodeLogic(overflowClass, 0);
           }
+          if (hasCompressedApis(root)) {
+            indent.writeln('case $compressedMessageCodecKey: ');
+            indent.nest(1, () {
+              indent.writeln('final int length = readSize(buffer);');
+              indent.writeln(
+                'final Uint8List compressed = buffer.getUint8List(readSize(buffer));',
+              );
+              indent.writeln(
+                'final Uint8List message = _decompressLz4(compressed, length);',
+              );
+              indent.writeln(
+                'return readValue(ReadBuffer(message.buffer.asByteData()));',
+              );
+            });
+          }
           indent.writeln('default:');
           indent.nest(1, () {
             indent.writeln('return super.readValueOfType(type, buffer);');
@@ -583,6 +598,7 @@ class DartGenerator extends StructuredGenerator<InternalDartOptions> {
                 : channelNameFunc(func),
             isMockHandler: isMockHandler,
             isAsynchronous: func.isAsynchronous,
+            syncArguments: !isMockHandler,
           );
         }
       });
@@ -1126,6 +1142,12 @@ final BinaryMessenger? ${varNamePrefix}binaryMessenger;
     if (root.classes.isNotEmpty) {
       _writeDeepEquals(indent);
     }
+    if (hasSyncedFlutterApiArguments(root)) {
+      _writeApplySyncedPatch(indent);
+    }
+    if (hasCompressedApis(root)) {
+      _writeDecompressLz4(indent);
+    }
     if (root.containsProxyApi) {
       proxy_api_helper.writeProxyApiPigeonOverrides(
         indent,
@@ -1173,6 +1195,65 @@ bool _deepEquals(Object? a, Object? b) {
 ''');
   }
 
+  /// Writes the function used to apply a `@Synced` field patch, a flat list
+  /// of alternating field indices and values, to a field list.
+  void _writeApplySyncedPatch(Indent indent) {
+    indent.newln();
+    indent.format('''
+List<Object?> _applySyncedPatch(List<Object?> values, List<Object?> patch) {
+  final List<Object?> patched = List<Object?>.of(values);
+  for (int i = 0; i + 1 < patch.length; i += 2) {
+    patched[patch[i]! as int] = patch[i + 1];
+  }
+  return patched;
+}''');
+  }
+
+  /// Writes the decoder for messages the host compressed using the LZ4 block
+  /// format.
+  void _writeDecompressLz4(Indent indent) {
+    indent.newln();
+    indent.format('''
+Uint8List _decompressLz4(Uint8List input, int length) {
+  final Uint8List output = Uint8List(length);
+  int inputIndex = 0;
+  int outputIndex = 0;
+  while (inputIndex < input.length) {
+    final int token = input[inputIndex++];
+    int literalLength = token >> 4;
+    if (literalLength == 15) {
+      int byte;
+      do {
+        byte = input[inputIndex++];
+        literalLength += byte;
+      } while (byte == 255);
+    }
+    output.setRange(outputIndex, outputIndex + literalLength, input, inputIndex);
+    inputIndex += literalLength;
+    outputIndex += literalLength;
+    if (inputIndex >= input.length) {
+      break;
+    }
+    final int offset = input[inputIndex] | (input[inputIndex + 1] << 8);
+    inputIndex += 2;
+    int matchLength = (token & 0x0f) + 4;
+    if (matchLength == 19) {
+      int byte;
+      do {
+        byte = input[inputIndex++];
+        matchLength += byte;
+      } while (byte == 255);
+    }
+    // Matches may overlap the bytes they produce, so copy one byte at a time.
+    for (int i = 0; i < matchLength; i++) {
+      output[outputIndex] = output[outputIndex - offset];
+      outputIndex++;
+    }
+  }
+  return output;
+}''');
+  }
+
   void _writeCreateConnectionError(Indent indent) {
     indent.newln();
     indent.format('''
@@ -1369,6 +1450,7 @@ if (${varNamePrefix}replyList == null) {
     required bool isMockHandler,
     required bool isAsynchronous,
     bool addSuffixVariable = false,
+    bool syncArguments = false,
     String nullHandlerExpression = 'api == null',
     String Function(
           String methodName,
@@ -1388,6 +1470,15 @@ if (${varNamePrefix}replyList == null) {
         indent.writeln("'$channelName$channelSuffix', $pigeonChannelCodec,");
         indent.writeln('binaryMessenger: binaryMessenger);');
       });
+      bool isSyncedArgument(NamedType arg) =>
+          syncArguments && isSyncedArgumentType(arg.type);
+      enumerate(parameters, (int count, NamedType arg) {
+        if (isSyncedArgument(arg)) {
+          indent.writeln(
+            '${_addGenericTypes(arg.type)}? ${_getSyncedVariableName(count, arg)};',
+          );
+        }
+      });
       final messageHandlerSetterWithOpeningParentheses = isMockHandler
           ? '_testBinaryMessengerBinding!.defaultBinaryMessenger.setMockDecodedMessageHandler<Object?>(${varNamePrefix}channel, '
           : '${varNamePrefix}channel.setMessageHandler(';
@@ -1424,9 +1515,19 @@ if (${varNamePrefix}replyList == null) {
 
               final leftHandSide = 'final $argType? $argName';
 
-              indent.writeln(
-                '$leftHandSide = ($argsArray[$count] as $genericArgType?)${castCall.isEmpty ? '' : '?$castCall'};',
-              );
+              if (isSyncedArgument(arg)) {
+                _writeSyncedArgumentDecode(
+                  indent,
+                  arg,
+                  argName: argName,
+                  encodedArgument: '$argsArray[$count]',
+                  syncedVariableName: _getSyncedVariableName(count, arg),
+                );
+              } else {
+                indent.writeln(
+                  '$leftHandSide = ($argsArray[$count] as $genericArgType?)${castCall.isEmpty ? '' : '?$castCall'};',
+                );
+              }
 
               if (!arg.type.isNullable) {
                 indent.writeln('assert($argName != null,');
@@ -1480,6 +1581,41 @@ if (${varNamePrefix}replyList == null) {
     });
   }
 
+  /// Writes the decoding of a `@Synced` argument, which is either a full
+  /// value or a patch against the last value received on the channel.
+  static void _writeSyncedArgumentDecode(
+    Indent indent,
+    NamedType arg, {
+    required String argName,
+    required String encodedArgument,
+    required String syncedVariableName,
+  }) {
+    final String className = arg.type.baseName;
+    final messageName = '${varNamePrefix}message_$argName';
+    final baseName = '${varNamePrefix}base_$argName';
+    indent.writeln('final $className? $argName;');
+    indent.writeln('final Object? $messageName = $encodedArgument;');
+    indent.writeScoped('if ($messageName is List<Object?>) {', '} ', () {
+      indent.writeln('final $className? $baseName = $syncedVariableName;');
+      indent.writeScoped('if ($baseName == null) {', '}', () {
+        indent.writeln(
+          "return wrapResponse(error: PlatformException(code: 'synced-state-missing', message: 'Received a patch for ${arg.name} without a previous value.'));",
+        );
+      });
+      indent.writeln(
+        '$argName = $className.decode(_applySyncedPatch($baseName._toList(), $messageName));',
+      );
+    }, addTrailingNewline: false);
+    indent.addScoped('else {', '}', () {
+      indent.writeln('$argName = $messageName as $className?;');
+    });
+    indent.writeScoped('if ($argName != null) {', '}', () {
+      indent.writeln(
+        '$syncedVariableName = $className.decode($argName._toList());',
+      );
+    });
+  }
+
   static String _createFlutterApiMethodCall(
     String methodName,
     Iterable<Parameter> parameters,
@@ -1521,6 +1657,11 @@ String _makeGenericCastCall(TypeDeclaration type) {
 String _getSafeArgumentName(int count, NamedType field) =>
     field.name.isEmpty ? 'arg$count' : 'arg_${field.name}';
 
+/// Returns the name of the variable caching the last value received for a
+/// `@Synced` argument.
+String _getSyncedVariableName(int count, NamedType field) =>
+    '${varNamePrefix}synced_${_getSafeArgumentName(count, field)}';
+
 /// Generates a parameter name if one isn't defined.
 String getParameterName(int count, NamedType field) =>
     field.name.isEmpty ? 'arg$count' : field.name;
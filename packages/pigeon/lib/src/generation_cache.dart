@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:path/path.dart' as path;
+
+import 'generator_tools.dart';
+import 'pigeon_lib.dart';
+
+/// A cache of the files generated for a pigeon input, so unchanged inputs can
+/// skip parsing and generation.
+///
+/// Each entry is keyed on the pigeon version and the options used for the run,
+/// and records the contents of the files the outputs were generated from. An
+/// entry is only used while all of those files are unchanged, so stale entries
+/// never need to be cleared.
+class GenerationCache {
+  /// Creates a cache stored in [directory] for a run with [options].
+  GenerationCache(this.directory, PigeonOptions options)
+    : _key = jsonEncode(<String, Object>{
+        'pigeonVersion': pigeonVersion,
+        'includeVersionInGeneratedWarning': includeVersionInGeneratedWarning,
+        'options': options.toMap()..remove('cacheDir'),
+      });
+
+  /// The directory entries are stored in.
+  final String directory;
+
+  /// Identifies the pigeon version and options of the run.
+  final String _key;
+
+  File get _entryFile =>
+      File(path.join(directory, '${_fnv1aHash(_key)}.json'));
+
+  /// Writes the cached outputs for this run if the files they were generated
+  /// from are unchanged.
+  ///
+  /// Returns false if there is no usable entry, in which case the outputs need
+  /// to be generated.
+  bool restore() {
+    final Map<String, Object?>? entry = _readEntry();
+    if (entry == null || entry['key'] != _key) {
+      return false;
+    }
+
+    final dependencies = entry['dependencies']! as Map<String, Object?>;
+    for (final MapEntry<String, Object?> dependency in dependencies.entries) {
+      final file = File(dependency.key);
+      if (!file.existsSync() || file.readAsStringSync() != dependency.value) {
+        return false;
+      }
+    }
+
+    final outputs = entry['outputs']! as Map<String, Object?>;
+    for (final MapEntry<String, Object?> output in outputs.entries) {
+      final file = File(output.key);
+      final contents = output.value! as String;
+      // Leave identical outputs untouched so build systems don't see them as
+      // modified.
+      if (file.existsSync() && file.readAsStringSync() == contents) {
+        continue;
+      }
+      file.createSync(recursive: true);
+      file.writeAsStringSync(contents);
+    }
+    return true;
+  }
+
+  /// Stores the current contents of [outputs], which were generated from
+  /// [dependencies].
+  ///
+  /// Nothing is stored if any output was written to `stdout`.
+  void store({
+    required Iterable<String> dependencies,
+    required Iterable<String> outputs,
+  }) {
+    if (outputs.contains('stdout')) {
+      return;
+    }
+
+    final entry = <String, Object>{
+      'key': _key,
+      'dependencies': <String, String>{
+        for (final String dependency in dependencies)
+          dependency: File(dependency).readAsStringSync(),
+      },
+      'outputs': <String, String>{
+        for (final String output in outputs)
+          output: File(output).readAsStringSync(),
+      },
+    };
+    final File file = _entryFile;
+    file.createSync(recursive: true);
+    // Write to a temporary file first, so a concurrent run never reads a
+    // partially written entry.
+    final temporaryFile = File('${file.path}.$pid.tmp');
+    temporaryFile.writeAsStringSync(jsonEncode(entry));
+    temporaryFile.renameSync(file.path);
+  }
+
+  Map<String, Object?>? _readEntry() {
+    final File file = _entryFile;
+    if (!file.existsSync()) {
+      return null;
+    }
+    try {
+      return jsonDecode(file.readAsStringSync()) as Map<String, Object?>;
+    } on FormatException {
+      return null;
+    }
+  }
+}
+
+/// Returns the 64-bit FNV-1a hash of [key] as a hex string.
+String _fnv1aHash(String key) {
+  var hash = 0xcbf29ce484222325;
+  for (final int byte in utf8.encode(key)) {
+    hash ^= byte;
+    hash *= 0x100000001b3;
+  }
+  return hash.toUnsigned(64).toRadixString(16).padLeft(16, '0');
+}
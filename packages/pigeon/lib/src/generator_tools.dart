@@ -15,7 +15,7 @@ import 'generator.dart';
 /// The current version of pigeon.
 ///
 /// This must match the version in pubspec.yaml.
-const String pigeonVersion = '26.1.7';
+const String pigeonVersion = '27.7.0';
 
 /// Read all the content from [stdin] to a String.
 String readStdin() {
@@ -490,6 +490,13 @@ const List<String> validTypes = <String>[
 /// for more information on keys in MessageCodecs.
 const int proxyApiCodecInstanceManagerKey = 128;
 
+/// The codec key of a message that the host compressed because it was larger
+/// than the API's `compressionThreshold`.
+///
+/// This is the same key as [proxyApiCodecInstanceManagerKey], which is why
+/// compression can not be used in files that define ProxyApis.
+const int compressedMessageCodecKey = 128;
+
 /// Custom codecs' custom types are enumerations begin at this number to
 /// avoid collisions with the StandardMessageCodec.
 const int minimumCodecFieldKey = proxyApiCodecInstanceManagerKey + 1;
@@ -901,3 +908,32 @@ bool isCollectionType(TypeDeclaration type) {
       !type.isProxyApi &&
       (type.baseName.contains('List') || type.baseName == 'Map');
 }
+
+/// Whether a Flutter API argument of [type] is sent as field level patches.
+///
+/// Only non-nullable `@Synced` data classes are synced, so that a null value
+/// never has to be represented as a patch.
+bool isSyncedArgumentType(TypeDeclaration type) {
+  return !type.isNullable && (type.associatedClass?.isSynced ?? false);
+}
+
+/// Whether a method of [api] takes an argument that is sent as field level
+/// patches, see [isSyncedArgumentType].
+bool hasSyncedArguments(Api api) {
+  return api.methods.any(
+    (Method method) => method.parameters.any(
+      (Parameter parameter) => isSyncedArgumentType(parameter.type),
+    ),
+  );
+}
+
+/// Whether any Flutter API in [root] takes an argument that is sent as field
+/// level patches, see [isSyncedArgumentType].
+bool hasSyncedFlutterApiArguments(Root root) {
+  return root.apis.whereType<AstFlutterApi>().any(hasSyncedArguments);
+}
+
+/// Whether any API in [root] compresses the messages it sends to Flutter.
+bool hasCompressedApis(Root root) {
+  return root.apis.any((Api api) => api.compressionThreshold != null);
+}
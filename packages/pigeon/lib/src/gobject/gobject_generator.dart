@@ -30,6 +30,7 @@ class GObjectOptions {
     this.module,
     this.copyrightHeader,
     this.headerOutPath,
+    this.resultStructs,
   });
 
   /// The path to the header that will get placed in the source file (example:
@@ -45,6 +46,14 @@ class GObjectOptions {
   /// The path to the output header file location.
   final String? headerOutPath;
 
+  /// Whether synchronous host API methods that return void, a bool, an int, a
+  /// double or an enum can also be implemented with a handler that writes its
+  /// result into a stack allocated struct.
+  ///
+  /// This avoids allocating a response object on each call, which can be
+  /// significant for small, frequently called methods.
+  final bool? resultStructs;
+
   /// Creates a [GObjectOptions] from a Map representation where:
   /// `x = GObjectOptions.fromMap(x.toMap())`.
   static GObjectOptions fromMap(Map<String, Object> map) {
@@ -54,6 +63,7 @@ class GObjectOptions {
       module: map['module'] as String?,
       copyrightHeader: copyrightHeader?.cast<String>(),
       headerOutPath: map['gobjectHeaderOut'] as String?,
+      resultStructs: map['resultStructs'] as bool?,
     );
   }
 
@@ -64,6 +74,7 @@ class GObjectOptions {
       if (headerIncludePath != null) 'header': headerIncludePath!,
       if (module != null) 'module': module!,
       if (copyrightHeader != null) 'copyrightHeader': copyrightHeader!,
+      if (resultStructs != null) 'resultStructs': resultStructs!,
     };
     return result;
   }
@@ -85,6 +96,7 @@ class InternalGObjectOptions extends InternalOptions {
     this.module,
     this.copyrightHeader,
     this.headerOutPath,
+    this.resultStructs = false,
   });
 
   /// Creates InternalGObjectOptions from GObjectOptions.
@@ -97,7 +109,8 @@ class InternalGObjectOptions extends InternalOptions {
            options.headerIncludePath ?? path.basename(gobjectHeaderOut),
        module = options.module,
        copyrightHeader = options.copyrightHeader ?? copyrightHeader,
-       headerOutPath = options.headerOutPath;
+       headerOutPath = options.headerOutPath,
+       resultStructs = options.resultStructs ?? false;
 
   /// The path to the header that will get placed in the source file (example:
   /// "foo.h").
@@ -117,6 +130,9 @@ class InternalGObjectOptions extends InternalOptions {
 
   /// The path to the output header file location.
   final String? headerOutPath;
+
+  /// Whether to generate result struct handlers for host API methods.
+  final bool resultStructs;
 }
 
 /// Class that manages all GObject code generation.
@@ -327,6 +343,82 @@ class GObjectHeaderGenerator
         '$returnType ${methodPrefix}_get_$fieldName(${getterArgs.join(', ')});',
       );
     }
+
+    for (final NamedType field in classDefinition.fields) {
+      if (!_isStringKeyedMapType(field.type)) {
+        continue;
+      }
+      final String fieldName = _getFieldName(field.name);
+
+      final TypeDeclaration valueType = field.type.typeArguments[1];
+      final String valueCType = _getType(module, valueType, primitive: true);
+      final bool valueHasLength = _isNumericListType(valueType);
+      final String funcName = _getMapForeachFuncName(
+        module,
+        classDefinition.name,
+        field.name,
+      );
+
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '$funcName:',
+        '@key: the key of the entry.',
+        '@value: the value of the entry.',
+        if (valueHasLength) '@value_length: the length of @value.',
+        '@user_data: user data passed to ${methodPrefix}_foreach_$fieldName().',
+        '',
+        'The function called for each entry in the ${field.name} field of a',
+        '#$className.',
+      ], _docCommentSpec);
+      final funcArgs = <String>[
+        'const gchar* key',
+        '$valueCType value',
+        if (valueHasLength) 'size_t value_length',
+        'gpointer user_data',
+      ];
+      indent.writeln('typedef void (*$funcName)(${funcArgs.join(', ')});');
+
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '${methodPrefix}_lookup_$fieldName',
+        '@object: a #$className.',
+        '@key: the key to look up.',
+        '@value: (out) (optional): location to write the value for @key.',
+        if (valueHasLength)
+          '@value_length: (out) (optional): location to write the length of @value.',
+        '',
+        'Looks up the value for @key in the ${field.name} field of @object. If',
+        'the map has more than one entry for @key the first is used, as',
+        'fl_value_lookup_string() does. An index of the map is built on the',
+        'first call, and rebuilt if entries are added to the map, so later',
+        'lookups do not need to scan the map.',
+        '',
+        'Returns: %TRUE if @key is present with a non-null value.',
+      ], _docCommentSpec);
+      final lookupArgs = <String>[
+        '$className* object',
+        'const gchar* key',
+        '$valueCType* value',
+        if (valueHasLength) 'size_t* value_length',
+      ];
+      indent.writeln(
+        'gboolean ${methodPrefix}_lookup_$fieldName(${lookupArgs.join(', ')});',
+      );
+
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '${methodPrefix}_foreach_$fieldName',
+        '@object: a #$className.',
+        '@func: (scope call): the function to call for each entry.',
+        '@user_data: (closure): user data to pass to @func.',
+        '',
+        'Calls @func for each entry in the ${field.name} field of @object, in',
+        'map order. Entries with a null value are skipped.',
+      ], _docCommentSpec);
+      indent.writeln(
+        'void ${methodPrefix}_foreach_$fieldName($className* object, $funcName func, gpointer user_data);',
+      );
+    }
   }
 
   @override
@@ -598,8 +690,14 @@ class GObjectHeaderGenerator
       _writeHostApiRespondClass(indent, module, api, method);
     }
 
+    for (final Method method in api.methods.where(
+      (Method method) => _hasResultStruct(generatorOptions, method),
+    )) {
+      _writeHostApiResultStruct(indent, module, api, method);
+    }
+
     indent.newln();
-    _writeApiVTable(indent, module, api);
+    _writeApiVTable(generatorOptions, indent, module, api);
 
     indent.newln();
     addDocumentationComments(indent, <String>[
@@ -684,8 +782,46 @@ class GObjectHeaderGenerator
     );
   }
 
+  // Write the struct a result struct handler writes its result into.
+  void _writeHostApiResultStruct(
+    Indent indent,
+    String module,
+    Api api,
+    Method method,
+  ) {
+    final String resultClassName = _getClassName(
+      module,
+      _getResultName(api.name, method.name),
+    );
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '$resultClassName:',
+      if (!method.returnType.isVoid)
+        '@return_value: the value returned by this method.',
+      '@error_code: (allow-none): error code, or %NULL if the method succeeded. Must remain valid after the handler returns, e.g. a string literal.',
+      '@error_message: (allow-none): error message. Must remain valid after the handler returns.',
+      '@error_details: (transfer full) (allow-none): error details or %NULL.',
+      '',
+      'The result of a call to ${api.name}.${method.name}, written by a result struct handler. The struct is zero initialized before the handler is called.',
+    ], _docCommentSpec);
+    indent.writeScoped('typedef struct {', '} $resultClassName;', () {
+      if (!method.returnType.isVoid) {
+        indent.writeln('${_getType(module, method.returnType)} return_value;');
+      }
+      indent.writeln('const gchar* error_code;');
+      indent.writeln('const gchar* error_message;');
+      indent.writeln('FlValue* error_details;');
+    });
+  }
+
   // Write the vtable for an API.
-  void _writeApiVTable(Indent indent, String module, Api api) {
+  void _writeApiVTable(
+    InternalGObjectOptions generatorOptions,
+    Indent indent,
+    String module,
+    Api api,
+  ) {
     final String className = _getClassName(module, api.name);
     final String vtableName = _getVTableName(module, api.name);
 
@@ -718,6 +854,34 @@ class GObjectHeaderGenerator
             : '$responseClassName*';
         indent.writeln("$returnType (*$methodName)(${methodArgs.join(', ')});");
       }
+
+      // Result struct handlers are added after the other handlers so the
+      // layout of the existing members doesn't change.
+      for (final Method method in api.methods.where(
+        (Method method) => _hasResultStruct(generatorOptions, method),
+      )) {
+        final String methodName = _getMethodName(method.name);
+        final String resultClassName = _getClassName(
+          module,
+          _getResultName(api.name, method.name),
+        );
+
+        final methodArgs = <String>[];
+        for (final Parameter param in method.parameters) {
+          final String name = _snakeCaseFromCamelCase(param.name);
+          methodArgs.add('${_getType(module, param.type)} $name');
+          if (_isNumericListType(param.type)) {
+            methodArgs.add('size_t ${name}_length');
+          }
+        }
+        methodArgs.addAll(<String>[
+          '$resultClassName* result',
+          'gpointer user_data',
+        ]);
+        indent.writeln(
+          "void (*${methodName}_with_result)(${methodArgs.join(', ')});",
+        );
+      }
     });
   }
 
@@ -821,6 +985,217 @@ class GObjectSourceGenerator
     indent.writeln('#include "${generatorOptions.headerIncludePath}"');
   }
 
+  @override
+  void writeGeneralUtilities(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    if (!hasSyncedFlutterApiArguments(root)) {
+      return;
+    }
+    final String module = _getModule(generatorOptions, dartPackageName);
+
+    final String syncedCallClassName = _getClassName(module, 'SyncedCall');
+    final String syncedCallPrefix = _getMethodPrefix(module, 'SyncedCall');
+
+    indent.newln();
+    indent.writeln(
+      '// Returns the table holding the last value sent for each @Synced argument,',
+    );
+    indent.writeln(
+      '// keyed by the messenger, channel and argument index it was sent with.',
+    );
+    indent.writeScoped(
+      'static GHashTable* ${_getMethodPrefix(module, 'GetSyncedSnapshots')}() {',
+      '}',
+      () {
+        indent.writeln('static GHashTable* snapshots = nullptr;');
+        indent.writeScoped('if (snapshots == nullptr) {', '}', () {
+          indent.writeln(
+            'snapshots = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, reinterpret_cast<GDestroyNotify>(fl_value_unref));',
+          );
+        });
+        indent.writeln('return snapshots;');
+      },
+    );
+
+    indent.newln();
+    indent.writeln(
+      '// Returns the fields of @values that differ from the last value sent as',
+    );
+    indent.writeln(
+      '// argument @index on @channel_key as a list of alternating field indices',
+    );
+    indent.writeln(
+      '// and values, or %NULL if the full value has to be sent. Takes ownership of',
+    );
+    indent.writeln('// @values and stores it as the new snapshot.');
+    indent.writeScoped(
+      'static FlValue* ${_getSyncedPatchFunctionName(module)}(const gchar* channel_key, int index, FlValue* values) {',
+      '}',
+      () {
+        indent.writeln(
+          'GHashTable* snapshots = ${_getMethodPrefix(module, 'GetSyncedSnapshots')}();',
+        );
+        indent.writeln(
+          'g_autofree gchar* key = g_strdup_printf("%s#%d", channel_key, index);',
+        );
+        indent.writeln(
+          'FlValue* snapshot = static_cast<FlValue*>(g_hash_table_lookup(snapshots, key));',
+        );
+        indent.writeln('FlValue* patch = nullptr;');
+        indent.writeScoped(
+          'if (snapshot != nullptr && fl_value_get_length(snapshot) == fl_value_get_length(values)) {',
+          '}',
+          () {
+            indent.writeln('patch = fl_value_new_list();');
+            indent.writeScoped(
+              'for (size_t i = 0; i < fl_value_get_length(values); i++) {',
+              '}',
+              () {
+                indent.writeln(
+                  'FlValue* value = fl_value_get_list_value(values, i);',
+                );
+                indent.writeScoped(
+                  'if (!fl_value_equal(value, fl_value_get_list_value(snapshot, i))) {',
+                  '}',
+                  () {
+                    indent.writeln(
+                      'fl_value_append_take(patch, fl_value_new_int(i));',
+                    );
+                    indent.writeln('fl_value_append(patch, value);');
+                  },
+                );
+              },
+            );
+          },
+        );
+        indent.writeln(
+          'g_hash_table_replace(snapshots, g_steal_pointer(&key), values);',
+        );
+        indent.writeln('return patch;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static gboolean ${_getMethodPrefix(module, 'HasSyncedKeyPrefix')}(gpointer key, gpointer value, gpointer user_data) {',
+      '}',
+      () {
+        indent.writeln(
+          'return g_str_has_prefix(static_cast<const gchar*>(key), static_cast<const gchar*>(user_data));',
+        );
+      },
+    );
+
+    indent.newln();
+    indent.writeln(
+      '// Forgets the values sent on @channel_key so the next call sends them in',
+    );
+    indent.writeln('// full.');
+    indent.writeScoped(
+      'static void ${_getMethodPrefix(module, 'ClearSyncedSnapshots')}(const gchar* channel_key) {',
+      '}',
+      () {
+        indent.writeln(
+          'g_autofree gchar* prefix = g_strdup_printf("%s#", channel_key);',
+        );
+        indent.writeln(
+          'g_hash_table_foreach_remove(${_getMethodPrefix(module, 'GetSyncedSnapshots')}(), ${_getMethodPrefix(module, 'HasSyncedKeyPrefix')}, prefix);',
+        );
+      },
+    );
+
+    indent.newln();
+    indent.writeln(
+      '// State of a Flutter API call with @Synced arguments, held as task data.',
+    );
+    indent.writeScoped('typedef struct {', '} $syncedCallClassName;', () {
+      indent.writeln('FlBasicMessageChannel* channel;');
+      indent.writeln('gchar* channel_key;');
+      indent.writeln(
+        '// The message with every @Synced argument in full, or %NULL if it was',
+      );
+      indent.writeln('// already sent that way.');
+      indent.writeln('FlValue* full_message;');
+    });
+
+    indent.newln();
+    indent.writeScoped(
+      'static void ${syncedCallPrefix}_free($syncedCallClassName* call) {',
+      '}',
+      () {
+        indent.writeln('g_object_unref(call->channel);');
+        indent.writeln('g_free(call->channel_key);');
+        indent.writeln('g_clear_pointer(&call->full_message, fl_value_unref);');
+        indent.writeln('g_free(call);');
+      },
+    );
+
+    indent.newln();
+    indent.writeln(
+      '// Completes a call with @Synced arguments. Forgets the values sent on the',
+    );
+    indent.writeln(
+      '// channel if the call failed, and sends the full message again if Dart no',
+    );
+    indent.writeln(
+      '// longer has the values the patches were made against, e.g. after a hot',
+    );
+    indent.writeln('// restart.');
+    indent.writeScoped(
+      'static void ${syncedCallPrefix}_cb(GObject* object, GAsyncResult* result, gpointer user_data) {',
+      '}',
+      () {
+        indent.writeln('GTask* task = G_TASK(user_data);');
+        indent.writeln(
+          '$syncedCallClassName* call = static_cast<$syncedCallClassName*>(g_task_get_task_data(task));',
+        );
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeln(
+          'g_autoptr(FlValue) response = fl_basic_message_channel_send_finish(call->channel, result, &error);',
+        );
+        indent.writeScoped('if (response == nullptr) {', '}', () {
+          indent.writeln(
+            '${_getMethodPrefix(module, 'ClearSyncedSnapshots')}(call->channel_key);',
+          );
+          indent.writeln('g_task_return_error(task, g_steal_pointer(&error));');
+          indent.writeln('return;');
+        });
+        indent.writeScoped(
+          'if (fl_value_get_length(response) > 1) {',
+          '}',
+          () {
+            indent.writeln(
+              '${_getMethodPrefix(module, 'ClearSyncedSnapshots')}(call->channel_key);',
+            );
+            indent.writeln(
+              'FlValue* code = fl_value_get_list_value(response, 0);',
+            );
+            indent.writeScoped(
+              'if (call->full_message != nullptr && fl_value_get_type(code) == FL_VALUE_TYPE_STRING && g_strcmp0(fl_value_get_string(code), "synced-state-missing") == 0) {',
+              '}',
+              () {
+                indent.writeln(
+                  'g_autoptr(FlValue) message = g_steal_pointer(&call->full_message);',
+                );
+                indent.writeln(
+                  'fl_basic_message_channel_send(call->channel, message, g_task_get_cancellable(task), ${syncedCallPrefix}_cb, task);',
+                );
+                indent.writeln('return;');
+              },
+            );
+          },
+        );
+        indent.writeln(
+          'g_task_return_pointer(task, g_steal_pointer(&response), reinterpret_cast<GDestroyNotify>(fl_value_unref));',
+        );
+      },
+    );
+  }
+
   @override
   void writeDataClass(
     InternalGObjectOptions generatorOptions,
@@ -841,12 +1216,31 @@ class GObjectSourceGenerator
     _writeObjectStruct(indent, module, classDefinition.name, () {
       for (final NamedType field in classDefinition.fields) {
         final String fieldName = _getFieldName(field.name);
-        final String fieldType = _getType(module, field.type, isOutput: true);
+        // Nullable primitives are stored inline, with their presence tracked
+        // in the bitfield below, to avoid a heap allocation per field.
+        final String fieldType = _getType(
+          module,
+          field.type,
+          isOutput: true,
+          primitive: _isNullablePrimitiveType(field.type),
+        );
         indent.writeln('$fieldType $fieldName;');
         if (_isNumericListType(field.type)) {
           indent.writeln('size_t ${fieldName}_length;');
         }
       }
+      for (final NamedType field in classDefinition.fields) {
+        if (_isStringKeyedMapType(field.type)) {
+          final String indexFieldName = _getIndexFieldName(field.name);
+          indent.writeln('GHashTable* $indexFieldName;');
+          indent.writeln('size_t ${indexFieldName}_length;');
+        }
+      }
+      for (final NamedType field in classDefinition.fields) {
+        if (_isNullablePrimitiveType(field.type)) {
+          indent.writeln('guint ${_getPresenceFieldName(field.name)} : 1;');
+        }
+      }
     });
 
     indent.newln();
@@ -866,6 +1260,17 @@ class GObjectSourceGenerator
           indent.writeln('$clear;');
         }
       }
+      for (final NamedType field in classDefinition.fields) {
+        if (_isStringKeyedMapType(field.type)) {
+          if (!haveSelf) {
+            _writeCastSelf(indent, module, classDefinition.name, 'object');
+            haveSelf = true;
+          }
+          indent.writeln(
+            'g_clear_pointer(&self->${_getIndexFieldName(field.name)}, g_hash_table_unref);',
+          );
+        }
+      }
     });
 
     indent.newln();
@@ -898,19 +1303,13 @@ class GObjectSourceGenerator
           );
 
           if (_isNullablePrimitiveType(field.type)) {
-            final String primitiveType = _getType(
-              module,
-              field.type,
-              primitive: true,
-            );
+            final String presenceFieldName = _getPresenceFieldName(field.name);
             indent.writeScoped('if ($value != nullptr) {', '}', () {
-              indent.writeln(
-                'self->$fieldName = static_cast<$primitiveType*>(malloc(sizeof($primitiveType)));',
-              );
-              indent.writeln('*self->$fieldName = *$value;');
+              indent.writeln('self->$fieldName = *$value;');
+              indent.writeln('self->$presenceFieldName = TRUE;');
             });
             indent.writeScoped('else {', '}', () {
-              indent.writeln('self->$fieldName = nullptr;');
+              indent.writeln('self->$presenceFieldName = FALSE;');
             });
           } else if (field.type.isNullable) {
             indent.writeScoped('if ($fieldName != nullptr) {', '}', () {
@@ -959,7 +1358,167 @@ class GObjectSourceGenerator
           if (_isNumericListType(field.type)) {
             indent.writeln('*length = self->${fieldName}_length;');
           }
-          indent.writeln('return self->$fieldName;');
+          if (_isNullablePrimitiveType(field.type)) {
+            indent.writeln(
+              'return self->${_getPresenceFieldName(field.name)} ? &self->$fieldName : nullptr;',
+            );
+          } else {
+            indent.writeln('return self->$fieldName;');
+          }
+        },
+      );
+    }
+
+    for (final NamedType field in classDefinition.fields) {
+      if (!_isStringKeyedMapType(field.type)) {
+        continue;
+      }
+      final String fieldName = _getFieldName(field.name);
+      final String indexFieldName = _getIndexFieldName(field.name);
+
+      final TypeDeclaration valueType = field.type.typeArguments[1];
+      final String valueCType = _getType(module, valueType, primitive: true);
+      final bool valueHasLength = _isNumericListType(valueType);
+      final String funcName = _getMapForeachFuncName(
+        module,
+        classDefinition.name,
+        field.name,
+      );
+
+      indent.newln();
+      final lookupArgs = <String>[
+        '$className* self',
+        'const gchar* key',
+        '$valueCType* value',
+        if (valueHasLength) 'size_t* value_length',
+      ];
+      indent.writeScoped(
+        'gboolean ${methodPrefix}_lookup_$fieldName(${lookupArgs.join(', ')}) {',
+        '}',
+        () {
+          indent.writeln('g_return_val_if_fail($testMacro(self), FALSE);');
+          if (field.type.isNullable) {
+            indent.writeScoped('if (self->$fieldName == nullptr) {', '}', () {
+              indent.writeln('return FALSE;');
+            });
+          }
+          indent.newln();
+          indent.writeln(
+            'size_t length = fl_value_get_length(self->$fieldName);',
+          );
+          indent.writeln(
+            '// Entries can be added to the map after the index is built, so it is',
+          );
+          indent.writeln('// rebuilt when the length of the map changes.');
+          indent.writeScoped(
+            'if (self->$indexFieldName == nullptr || self->${indexFieldName}_length != length) {',
+            '}',
+            () {
+              indent.writeln(
+                'g_clear_pointer(&self->$indexFieldName, g_hash_table_unref);',
+              );
+              indent.writeln(
+                'self->$indexFieldName = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, nullptr);',
+              );
+              indent.writeln('self->${indexFieldName}_length = length;');
+              indent.writeScoped(
+                'for (size_t i = 0; i < length; i++) {',
+                '}',
+                () {
+                  indent.writeln(
+                    'FlValue* map_key = fl_value_get_map_key(self->$fieldName, i);',
+                  );
+                  indent.writeln(
+                    '// The first entry for a key is used, as fl_value_lookup_string() does.',
+                  );
+                  indent.writeScoped(
+                    'if (fl_value_get_type(map_key) == FL_VALUE_TYPE_STRING && !g_hash_table_contains(self->$indexFieldName, fl_value_get_string(map_key))) {',
+                    '}',
+                    () {
+                      indent.writeln(
+                        'g_hash_table_insert(self->$indexFieldName, g_strdup(fl_value_get_string(map_key)), GSIZE_TO_POINTER(i + 1));',
+                      );
+                    },
+                  );
+                },
+              );
+            },
+          );
+          indent.newln();
+          indent.writeln(
+            '// The index holds positions plus one, so zero means not present. The',
+          );
+          indent.writeln(
+            '// value is read from the map as it can be replaced after the index is',
+          );
+          indent.writeln('// built.');
+          indent.writeln(
+            'size_t position = GPOINTER_TO_SIZE(g_hash_table_lookup(self->$indexFieldName, key));',
+          );
+          indent.writeScoped('if (position == 0) {', '}', () {
+            indent.writeln('return FALSE;');
+          });
+          indent.writeln(
+            'FlValue* map_value = fl_value_get_map_value(self->$fieldName, position - 1);',
+          );
+          indent.writeScoped(
+            'if (fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {',
+            '}',
+            () {
+              indent.writeln('return FALSE;');
+            },
+          );
+          indent.writeScoped('if (value != nullptr) {', '}', () {
+            indent.writeln(
+              '*value = ${_fromFlValue(module, valueType, 'map_value')};',
+            );
+          });
+          if (valueHasLength) {
+            indent.writeScoped('if (value_length != nullptr) {', '}', () {
+              indent.writeln('*value_length = fl_value_get_length(map_value);');
+            });
+          }
+          indent.writeln('return TRUE;');
+        },
+      );
+
+      indent.newln();
+      indent.writeScoped(
+        'void ${methodPrefix}_foreach_$fieldName($className* self, $funcName func, gpointer user_data) {',
+        '}',
+        () {
+          indent.writeln('g_return_if_fail($testMacro(self));');
+          if (field.type.isNullable) {
+            indent.writeScoped('if (self->$fieldName == nullptr) {', '}', () {
+              indent.writeln('return;');
+            });
+          }
+          indent.newln();
+          indent.writeln(
+            'size_t length = fl_value_get_length(self->$fieldName);',
+          );
+          indent.writeScoped('for (size_t i = 0; i < length; i++) {', '}', () {
+            indent.writeln(
+              'FlValue* map_key = fl_value_get_map_key(self->$fieldName, i);',
+            );
+            indent.writeln(
+              'FlValue* map_value = fl_value_get_map_value(self->$fieldName, i);',
+            );
+            indent.writeScoped(
+              'if (fl_value_get_type(map_key) != FL_VALUE_TYPE_STRING || fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {',
+              '}',
+              () {
+                indent.writeln('continue;');
+              },
+            );
+            final callArgs = <String>[
+              'fl_value_get_string(map_key)',
+              _fromFlValue(module, valueType, 'map_value'),
+              if (valueHasLength) 'fl_value_get_length(map_value)',
+              'user_data',
+            ];
+            indent.writeln('func(${callArgs.join(', ')});');
+          });
         },
       );
     }
@@ -972,9 +1531,21 @@ class GObjectSourceGenerator
         indent.writeln('FlValue* values = fl_value_new_list();');
         for (final NamedType field in classDefinition.fields) {
           final String fieldName = _getFieldName(field.name);
-          indent.writeln(
-            'fl_value_append_take(values, ${_makeFlValue(root, module, field.type, 'self->$fieldName', lengthVariableName: 'self->${fieldName}_length')});',
-          );
+          if (_isNullablePrimitiveType(field.type)) {
+            final String value = _makeFlValue(
+              root,
+              module,
+              _getNonNullableType(field.type),
+              'self->$fieldName',
+            );
+            indent.writeln(
+              'fl_value_append_take(values, self->${_getPresenceFieldName(field.name)} ? $value : fl_value_new_null());',
+            );
+          } else {
+            indent.writeln(
+              'fl_value_append_take(values, ${_makeFlValue(root, module, field.type, 'self->$fieldName', lengthVariableName: 'self->${fieldName}_length')});',
+            );
+          }
         }
         indent.writeln('return values;');
       },
@@ -1080,6 +1651,17 @@ class GObjectSourceGenerator
       indent.writeln('const int $customTypeId = ${customType.enumeration};');
     }
 
+    if (customTypes.any(
+      (EnumeratedType t) => t.type == CustomTypes.customEnum,
+    )) {
+      _writeEnumIndexCodecFunctions(indent, codecMethodPrefix);
+    }
+
+    final bool compressMessages = hasCompressedApis(root);
+    if (compressMessages) {
+      _writeCompressedMessageCodecFunctions(indent, codecMethodPrefix);
+    }
+
     for (final customType in customTypes) {
       final String customTypeName = _getClassName(module, customType.name);
       final String snakeCustomTypeName = _snakeCaseFromCamelCase(
@@ -1090,7 +1672,7 @@ class GObjectSourceGenerator
       indent.newln();
       final valueType = customType.type == CustomTypes.customClass
           ? '$customTypeName*'
-          : 'FlValue*';
+          : 'int';
       indent.writeScoped(
         'static gboolean ${codecMethodPrefix}_write_$snakeCustomTypeName($_standardCodecName* codec, GByteArray* buffer, $valueType value, GError** error) {',
         '}',
@@ -1108,7 +1690,7 @@ class GObjectSourceGenerator
             );
           } else if (customType.type == CustomTypes.customEnum) {
             indent.writeln(
-              'return fl_standard_message_codec_write_value(codec, buffer, value, error);',
+              'return ${codecMethodPrefix}_write_enum_index(buffer, value);',
             );
           }
         },
@@ -1152,11 +1734,21 @@ class GObjectSourceGenerator
                       );
                     } else if (customType.type == CustomTypes.customEnum) {
                       indent.writeln(
-                        'return ${codecMethodPrefix}_write_$snakeCustomTypeName(codec, buffer, reinterpret_cast<FlValue*>(const_cast<gpointer>(fl_value_get_custom_value(value))), error);',
+                        'return ${codecMethodPrefix}_write_$snakeCustomTypeName(codec, buffer, GPOINTER_TO_INT(fl_value_get_custom_value(value)), error);',
                       );
                     }
                   });
                 }
+                if (compressMessages) {
+                  indent.writeln(
+                    'case ${codecMethodPrefix}_compressed_message_type:',
+                  );
+                  indent.nest(1, () {
+                    indent.writeln(
+                      'return ${codecMethodPrefix}_write_compressed_message(codec, buffer, static_cast<FlValue*>(const_cast<gpointer>(fl_value_get_custom_value(value))), error);',
+                    );
+                  });
+                }
               },
             );
           },
@@ -1202,8 +1794,17 @@ class GObjectSourceGenerator
               'return fl_value_new_custom_object($customTypeId, G_OBJECT(value));',
             );
           } else if (customType.type == CustomTypes.customEnum) {
+            indent.writeln('int index;');
+            indent.writeScoped(
+              'if (!${codecMethodPrefix}_read_enum_index(codec, buffer, offset, &index, error)) {',
+              '}',
+              () {
+                indent.writeln('return nullptr;');
+              },
+            );
+            indent.newln();
             indent.writeln(
-              'return fl_value_new_custom($customTypeId, fl_standard_message_codec_read_value(codec, buffer, offset, error), (GDestroyNotify)fl_value_unref);',
+              'return fl_value_new_custom($customTypeId, GINT_TO_POINTER(index), nullptr);',
             );
           }
         },
@@ -1265,6 +1866,10 @@ class GObjectSourceGenerator
         indent.writeln('return self;');
       },
     );
+
+    if (compressMessages) {
+      _writeCompressMessageFunctions(indent, codecMethodPrefix);
+    }
   }
 
   @override
@@ -1293,6 +1898,32 @@ class GObjectSourceGenerator
     indent.newln();
     _writeDispose(indent, module, api.name, () {
       _writeCastSelf(indent, module, api.name, 'object');
+      if (hasSyncedArguments(api)) {
+        indent.writeln(
+          '// Forget the @Synced values sent by this instance, since a later messenger may be allocated at the same address.',
+        );
+        indent.writeScoped('if (self->messenger != nullptr) {', '}', () {
+          for (final Method method in api.methods) {
+            if (!method.parameters.any(
+              (Parameter param) => isSyncedArgumentType(param.type),
+            )) {
+              continue;
+            }
+            final String channelName = makeChannelName(
+              api,
+              method,
+              dartPackageName,
+            );
+            final String name = _getMethodName(method.name);
+            indent.writeln(
+              'g_autofree gchar* ${name}_channel_key = g_strdup_printf("%p:$channelName%s", self->messenger, self->suffix);',
+            );
+            indent.writeln(
+              '${_getMethodPrefix(module, 'ClearSyncedSnapshots')}(${name}_channel_key);',
+            );
+          }
+        });
+      }
       indent.writeln('g_clear_object(&self->messenger);');
       indent.writeln('g_clear_pointer(&self->suffix, g_free);');
     });
@@ -1502,17 +2133,22 @@ class GObjectSourceGenerator
         );
       }
 
-      indent.newln();
-      indent.writeScoped(
-        'static void ${methodPrefix}_${methodName}_cb(GObject* object, GAsyncResult* result, gpointer user_data) {',
-        '}',
-        () {
-          indent.writeln('GTask* task = G_TASK(user_data);');
-          indent.writeln(
-            'g_task_return_pointer(task, result, g_object_unref);',
-          );
-        },
+      final bool synced = method.parameters.any(
+        (Parameter param) => isSyncedArgumentType(param.type),
       );
+      if (!synced) {
+        indent.newln();
+        indent.writeScoped(
+          'static void ${methodPrefix}_${methodName}_cb(GObject* object, GAsyncResult* result, gpointer user_data) {',
+          '}',
+          () {
+            indent.writeln('GTask* task = G_TASK(user_data);');
+            indent.writeln(
+              'g_task_return_pointer(task, result, g_object_unref);',
+            );
+          },
+        );
+      }
 
       final asyncArgs = <String>['$className* self'];
       for (final Parameter param in method.parameters) {
@@ -1532,8 +2168,25 @@ class GObjectSourceGenerator
         "void ${methodPrefix}_$methodName(${asyncArgs.join(', ')}) {",
         '}',
         () {
+          final String channelName = makeChannelName(
+            api,
+            method,
+            dartPackageName,
+          );
+          if (synced) {
+            indent.writeln(
+              'g_autofree gchar* channel_name = g_strdup_printf("$channelName%s", self->suffix);',
+            );
+            indent.writeln(
+              'g_autofree gchar* channel_key = g_strdup_printf("%p:%s", self->messenger, channel_name);',
+            );
+            indent.writeln(
+              'g_autoptr(FlValue) full_args = fl_value_new_list();',
+            );
+          }
           indent.writeln('g_autoptr(FlValue) args = fl_value_new_list();');
-          for (final Parameter param in method.parameters) {
+          final patchNames = <String>[];
+          method.parameters.asMap().forEach((int index, Parameter param) {
             final String name = _snakeCaseFromCamelCase(param.name);
             final String value = _makeFlValue(
               root,
@@ -1542,16 +2195,33 @@ class GObjectSourceGenerator
               name,
               lengthVariableName: '${name}_length',
             );
-            indent.writeln('fl_value_append_take(args, $value);');
+            if (isSyncedArgumentType(param.type)) {
+              final String classMethodPrefix = _getMethodPrefix(
+                module,
+                param.type.baseName,
+              );
+              indent.writeln(
+                'FlValue* ${name}_patch = ${_getSyncedPatchFunctionName(module)}(channel_key, $index, ${classMethodPrefix}_to_list($name));',
+              );
+              indent.writeln('fl_value_append_take(full_args, $value);');
+              indent.writeln(
+                'fl_value_append_take(args, ${name}_patch != nullptr ? ${name}_patch : fl_value_ref(fl_value_get_list_value(full_args, $index)));',
+              );
+              patchNames.add('${name}_patch');
+            } else if (synced) {
+              indent.writeln('fl_value_append_take(args, $value);');
+              indent.writeln(
+                'fl_value_append(full_args, fl_value_get_list_value(args, $index));',
+              );
+            } else {
+              indent.writeln('fl_value_append_take(args, $value);');
+            }
+          });
+          if (!synced) {
+            indent.writeln(
+              'g_autofree gchar* channel_name = g_strdup_printf("$channelName%s", self->suffix);',
+            );
           }
-          final String channelName = makeChannelName(
-            api,
-            method,
-            dartPackageName,
-          );
-          indent.writeln(
-            'g_autofree gchar* channel_name = g_strdup_printf("$channelName%s", self->suffix);',
-          );
           indent.writeln(
             'g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();',
           );
@@ -1561,11 +2231,52 @@ class GObjectSourceGenerator
           indent.writeln(
             'GTask* task = g_task_new(self, cancellable, callback, user_data);',
           );
+          String compress(String value) => api.compressionThreshold != null
+              ? '${codecMethodPrefix}_compress_message($value, ${api.compressionThreshold})'
+              : 'fl_value_ref($value)';
+          if (synced) {
+            final String syncedCallClassName = _getClassName(
+              module,
+              'SyncedCall',
+            );
+            final String syncedCallPrefix = _getMethodPrefix(
+              module,
+              'SyncedCall',
+            );
+            indent.writeln(
+              '$syncedCallClassName* call = g_new0($syncedCallClassName, 1);',
+            );
+            indent.writeln('call->channel = channel;');
+            indent.writeln(
+              'call->channel_key = g_steal_pointer(&channel_key);',
+            );
+            indent.writeScoped(
+              'if (${patchNames.map((String name) => '$name != nullptr').join(' || ')}) {',
+              '}',
+              () {
+                indent.writeln(
+                  'call->full_message = ${compress('full_args')};',
+                );
+              },
+            );
+            indent.writeln(
+              'g_task_set_task_data(task, call, reinterpret_cast<GDestroyNotify>(${syncedCallPrefix}_free));',
+            );
+          } else {
+            indent.writeln(
+              'g_task_set_task_data(task, channel, g_object_unref);',
+            );
+          }
+          if (api.compressionThreshold != null) {
+            indent.writeln(
+              'g_autoptr(FlValue) message = ${codecMethodPrefix}_compress_message(args, ${api.compressionThreshold});',
+            );
+          }
+          final String sendCallback = synced
+              ? '${_getMethodPrefix(module, 'SyncedCall')}_cb'
+              : '${methodPrefix}_${methodName}_cb';
           indent.writeln(
-            'g_task_set_task_data(task, channel, g_object_unref);',
-          );
-          indent.writeln(
-            'fl_basic_message_channel_send(channel, args, cancellable, ${methodPrefix}_${methodName}_cb, task);',
+            'fl_basic_message_channel_send(channel, ${api.compressionThreshold != null ? 'message' : 'args'}, cancellable, $sendCallback, task);',
           );
         },
       );
@@ -1581,15 +2292,21 @@ class GObjectSourceGenerator
         '}',
         () {
           indent.writeln('g_autoptr(GTask) task = G_TASK(result);');
-          indent.writeln(
-            'GAsyncResult* r = G_ASYNC_RESULT(g_task_propagate_pointer(task, nullptr));',
-          );
-          indent.writeln(
-            'FlBasicMessageChannel* channel = FL_BASIC_MESSAGE_CHANNEL(g_task_get_task_data(task));',
-          );
-          indent.writeln(
-            'g_autoptr(FlValue) response = fl_basic_message_channel_send_finish(channel, r, error);',
-          );
+          if (synced) {
+            indent.writeln(
+              'g_autoptr(FlValue) response = static_cast<FlValue*>(g_task_propagate_pointer(task, error));',
+            );
+          } else {
+            indent.writeln(
+              'GAsyncResult* r = G_ASYNC_RESULT(g_task_propagate_pointer(task, nullptr));',
+            );
+            indent.writeln(
+              'FlBasicMessageChannel* channel = FL_BASIC_MESSAGE_CHANNEL(g_task_get_task_data(task));',
+            );
+            indent.writeln(
+              'g_autoptr(FlValue) response = fl_basic_message_channel_send_finish(channel, r, error);',
+            );
+          }
           indent.writeScoped('if (response == nullptr) { ', '}', () {
             indent.writeln('return nullptr;');
           });
@@ -1615,6 +2332,31 @@ class GObjectSourceGenerator
 
     final String codecClassName = _getClassName(module, _codecBaseName);
     final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+    // Returns the value to respond with in place of [value].
+    String responseValue([String value = 'response->value']) =>
+        api.compressionThreshold != null ? 'message' : value;
+    void writeCompressResponse([String value = 'response->value']) {
+      if (api.compressionThreshold != null) {
+        indent.writeln(
+          'g_autoptr(FlValue) message = ${codecMethodPrefix}_compress_message($value, ${api.compressionThreshold});',
+        );
+      }
+    }
+
+    // Writes the response to a synchronous call.
+    void writeRespond(Method method, String value) {
+      writeCompressResponse(value);
+      indent.writeln('g_autoptr(GError) error = NULL;');
+      indent.writeScoped(
+        'if (!fl_basic_message_channel_respond(channel, response_handle, ${responseValue(value)}, &error)) {',
+        '}',
+        () {
+          indent.writeln(
+            'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
+          );
+        },
+      );
+    }
 
     final bool hasAsyncMethod = api.methods.any(
       (Method method) => method.isAsynchronous,
@@ -1774,6 +2516,7 @@ class GObjectSourceGenerator
       final String methodName = _getMethodName(method.name);
       final String responseName = _getResponseName(api.name, method.name);
       final String responseClassName = _getClassName(module, responseName);
+      final bool hasResultStruct = _hasResultStruct(generatorOptions, method);
 
       indent.newln();
       indent.writeScoped(
@@ -1784,7 +2527,9 @@ class GObjectSourceGenerator
 
           indent.newln();
           indent.writeScoped(
-            'if (self->vtable == nullptr || self->vtable->$methodName == nullptr) {',
+            hasResultStruct
+                ? 'if (self->vtable == nullptr || (self->vtable->$methodName == nullptr && self->vtable->${methodName}_with_result == nullptr)) {'
+                : 'if (self->vtable == nullptr || self->vtable->$methodName == nullptr) {',
             '}',
             () {
               indent.writeln('return;');
@@ -1848,6 +2593,54 @@ class GObjectSourceGenerator
               "self->vtable->$methodName(${vfuncArgs.join(', ')});",
             );
           } else {
+            if (hasResultStruct) {
+              final String resultClassName = _getClassName(
+                module,
+                _getResultName(api.name, method.name),
+              );
+              indent.writeScoped(
+                'if (self->vtable->${methodName}_with_result != nullptr) {',
+                '}',
+                () {
+                  indent.writeln('$resultClassName result = {};');
+                  indent.writeln(
+                    "self->vtable->${methodName}_with_result(${<String>[...methodArgs, '&result', 'self->user_data'].join(', ')});",
+                  );
+                  indent.newln();
+                  indent.writeln(
+                    'g_autoptr(FlValue) response = fl_value_new_list();',
+                  );
+                  indent.writeScoped(
+                    'if (result.error_code != nullptr) {',
+                    '} else {',
+                    () {
+                      indent.writeln(
+                        'fl_value_append_take(response, fl_value_new_string(result.error_code));',
+                      );
+                      indent.writeln(
+                        'fl_value_append_take(response, fl_value_new_string(result.error_message != nullptr ? result.error_message : ""));',
+                      );
+                      indent.writeln(
+                        'fl_value_append_take(response, result.error_details != nullptr ? result.error_details : fl_value_new_null());',
+                      );
+                    },
+                  );
+                  indent.nest(1, () {
+                    indent.writeln(
+                      'g_clear_pointer(&result.error_details, fl_value_unref);',
+                    );
+                    indent.writeln(
+                      "fl_value_append_take(response, ${_makeFlValue(root, module, method.returnType, 'result.return_value')});",
+                    );
+                  });
+                  indent.writeln('}');
+                  writeRespond(method, 'response');
+                  indent.writeln('return;');
+                },
+              );
+              indent.newln();
+            }
+
             final vfuncArgs = <String>[];
             vfuncArgs.addAll(methodArgs);
             vfuncArgs.add('self->user_data');
@@ -1862,16 +2655,7 @@ class GObjectSourceGenerator
             });
 
             indent.newln();
-            indent.writeln('g_autoptr(GError) error = NULL;');
-            indent.writeScoped(
-              'if (!fl_basic_message_channel_respond(channel, response_handle, response->value, &error)) {',
-              '}',
-              () {
-                indent.writeln(
-                  'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
-                );
-              },
-            );
+            writeRespond(method, 'response->value');
           }
         },
       );
@@ -1975,9 +2759,10 @@ class GObjectSourceGenerator
           indent.writeln(
             'g_autoptr($responseClassName) response = ${responseMethodPrefix}_new(${returnArgs.join(', ')});',
           );
+          writeCompressResponse();
           indent.writeln('g_autoptr(GError) error = nullptr;');
           indent.writeScoped(
-            'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, response->value, &error)) {',
+            'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, ${responseValue()}, &error)) {',
             '}',
             () {
               indent.writeln(
@@ -2002,9 +2787,10 @@ class GObjectSourceGenerator
           indent.writeln(
             'g_autoptr($responseClassName) response = ${responseMethodPrefix}_new_error(code, message, details);',
           );
+          writeCompressResponse();
           indent.writeln('g_autoptr(GError) error = nullptr;');
           indent.writeScoped(
-            'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, response->value, &error)) {',
+            'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, ${responseValue()}, &error)) {',
             '}',
             () {
               indent.writeln(
@@ -2203,6 +2989,33 @@ String _getFieldName(String name) {
   return _snakeCaseFromCamelCase(name);
 }
 
+// Returns the name of the function that diffs `@Synced` arguments.
+String _getSyncedPatchFunctionName(String module) {
+  return _getMethodPrefix(module, 'MakeSyncedPatch');
+}
+
+// Returns the name of the member holding the lazily built lookup index for the
+// map field [name].
+String _getIndexFieldName(String name) {
+  return '${_getFieldName(name)}_index';
+}
+
+// Returns the name of the callback type for iterating the map field
+// [fieldName] of the class [className].
+String _getMapForeachFuncName(
+  String module,
+  String className,
+  String fieldName,
+) {
+  return _getClassName(module, '$className${toUpperCamelCase(fieldName)}Func');
+}
+
+// Returns the name of the bitfield member recording whether the nullable
+// primitive field [name] has a value.
+String _getPresenceFieldName(String name) {
+  return 'has_${_getFieldName(name)}';
+}
+
 // Returns the name to user for a class method with [name]
 String _getMethodName(String name) {
   final reservedNames = <String>['new', 'get_type'];
@@ -2296,6 +3109,18 @@ bool _isNumericListType(TypeDeclaration type) {
       type.baseName == 'Float64List';
 }
 
+// Returns a copy of [type] that is not nullable.
+TypeDeclaration _getNonNullableType(TypeDeclaration type) {
+  return TypeDeclaration(
+    baseName: type.baseName,
+    isNullable: false,
+    associatedEnum: type.associatedEnum,
+    associatedClass: type.associatedClass,
+    associatedProxyApi: type.associatedProxyApi,
+    typeArguments: type.typeArguments,
+  );
+}
+
 // Returns true if [type] is a nullable type with a primitive native data type.
 bool _isNullablePrimitiveType(TypeDeclaration type) {
   if (!type.isNullable) {
@@ -2308,6 +3133,31 @@ bool _isNullablePrimitiveType(TypeDeclaration type) {
       type.baseName == 'double';
 }
 
+// Whether [method] can also be implemented with a result struct handler.
+//
+// Only return types that can be stored in the struct without transferring
+// ownership are supported.
+bool _hasResultStruct(InternalGObjectOptions options, Method method) {
+  if (!options.resultStructs || method.isAsynchronous) {
+    return false;
+  }
+
+  final TypeDeclaration type = method.returnType;
+  return type.isVoid ||
+      (!type.isNullable &&
+          (type.isEnum ||
+              type.baseName == 'bool' ||
+              type.baseName == 'int' ||
+              type.baseName == 'double'));
+}
+
+// Returns true if [type] is a map with [String] keys.
+bool _isStringKeyedMapType(TypeDeclaration type) {
+  return type.baseName == 'Map' &&
+      type.typeArguments.length == 2 &&
+      type.typeArguments[0].baseName == 'String';
+}
+
 // Whether [type] is a type that needs to stay an FlValue* since it can't be
 // expressed as a more concrete type.
 bool _isFlValueWrappedType(TypeDeclaration type) {
@@ -2324,8 +3174,6 @@ String? _getClearFunction(TypeDeclaration type, String variableName) {
     return 'g_clear_pointer(&$variableName, fl_value_unref)';
   } else if (type.baseName == 'String') {
     return 'g_clear_pointer(&$variableName, g_free)';
-  } else if (_isNullablePrimitiveType(type)) {
-    return 'g_clear_pointer(&$variableName, g_free)';
   } else {
     return null;
   }
@@ -2433,7 +3281,7 @@ String _makeFlValue(
       module,
     );
     value =
-        'fl_value_new_custom($customTypeId, fl_value_new_int(${type.isNullable ? '*$variableName' : variableName}), (GDestroyNotify)fl_value_unref)';
+        'fl_value_new_custom($customTypeId, GINT_TO_POINTER(${type.isNullable ? '*$variableName' : variableName}), nullptr)';
   } else if (_isFlValueWrappedType(type)) {
     value = 'fl_value_ref($variableName)';
   } else if (type.baseName == 'void') {
@@ -2480,7 +3328,7 @@ String _fromFlValue(String module, TypeDeclaration type, String variableName) {
     return '$castMacro(fl_value_get_custom_value_object($variableName))';
   } else if (type.isEnum) {
     final String enumName = _getClassName(module, type.baseName);
-    return 'static_cast<$enumName>(fl_value_get_int(reinterpret_cast<FlValue*>(const_cast<gpointer>(fl_value_get_custom_value($variableName)))))';
+    return 'static_cast<$enumName>(GPOINTER_TO_INT(fl_value_get_custom_value($variableName)))';
   } else if (_isFlValueWrappedType(type)) {
     return variableName;
   } else if (type.baseName == 'bool') {
@@ -2506,9 +3354,300 @@ String _fromFlValue(String module, TypeDeclaration type, String variableName) {
   }
 }
 
+// Writes the functions used by the codec to encode compressed messages.
+//
+// A compressed message is a custom value holding a list of the message and the
+// compression threshold of its API. The codec encodes the message and replaces
+// the encoding with its LZ4 block format compression, which is decompressed by
+// the generated Dart codec, if it is larger than the threshold.
+void _writeCompressedMessageCodecFunctions(
+  Indent indent,
+  String codecMethodPrefix,
+) {
+  indent.newln();
+  indent.writeln(
+    'static const uint8_t ${codecMethodPrefix}_compressed_message_type = $compressedMessageCodecKey;',
+  );
+  indent.newln();
+  indent.writeScoped(
+    'static void ${codecMethodPrefix}_write_lz4_length(GByteArray* output, size_t length) {',
+    '}',
+    () {
+      indent.writeln('uint8_t byte = 255;');
+      indent.writeScoped('for (; length >= 255; length -= 255) {', '}', () {
+        indent.writeln('g_byte_array_append(output, &byte, 1);');
+      });
+      indent.writeln('byte = length;');
+      indent.writeln('g_byte_array_append(output, &byte, 1);');
+    },
+  );
+
+  indent.newln();
+  indent.writeScoped(
+    'static void ${codecMethodPrefix}_write_lz4_literals(GByteArray* output, const uint8_t* literals, size_t length, size_t match_length) {',
+    '}',
+    () {
+      indent.writeln(
+        'uint8_t token = (MIN(length, 15) << 4) | MIN(match_length, 15);',
+      );
+      indent.writeln('g_byte_array_append(output, &token, 1);');
+      indent.writeScoped('if (length >= 15) {', '}', () {
+        indent.writeln(
+          '${codecMethodPrefix}_write_lz4_length(output, length - 15);',
+        );
+      });
+      indent.writeln('g_byte_array_append(output, literals, length);');
+    },
+  );
+
+  indent.newln();
+  indent.writeScoped(
+    'static uint32_t ${codecMethodPrefix}_read_lz4_sequence(const uint8_t* data) {',
+    '}',
+    () {
+      indent.writeln(
+        'return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);',
+      );
+    },
+  );
+
+  indent.newln();
+  indent.writeln('// Compresses [input] using the LZ4 block format.');
+  indent.writeScoped(
+    'static GByteArray* ${codecMethodPrefix}_compress_lz4(const uint8_t* input, size_t length) {',
+    '}',
+    () {
+      indent.writeln('const int hash_bits = 12;');
+      indent.writeln(
+        '// The last match must start at least 12 bytes before the end of the',
+      );
+      indent.writeln('// input, and the last 5 bytes are always literals.');
+      indent.writeln('const size_t match_start_limit = 12;');
+      indent.writeln('const size_t last_literals = 5;');
+      indent.writeln('const size_t max_offset = 65535;');
+      indent.newln();
+      indent.writeln(
+        'GByteArray* output = g_byte_array_sized_new(length + length / 255 + 16);',
+      );
+      indent.writeln('// Positions are stored plus one so zero means unset.');
+      indent.writeln(
+        'g_autofree size_t* table = g_new0(size_t, 1 << hash_bits);',
+      );
+      indent.writeln('size_t anchor = 0;');
+      indent.writeln('size_t position = 0;');
+      indent.writeScoped(
+        'while (length > match_start_limit && position < length - match_start_limit) {',
+        '}',
+        () {
+          indent.writeln(
+            'uint32_t sequence = ${codecMethodPrefix}_read_lz4_sequence(input + position);',
+          );
+          indent.writeln(
+            'size_t hash = (sequence * 2654435761u) >> (32 - hash_bits);',
+          );
+          indent.writeln('size_t candidate = table[hash];');
+          indent.writeln('table[hash] = position + 1;');
+          indent.writeScoped(
+            'if (candidate == 0 || position + 1 - candidate > max_offset || ${codecMethodPrefix}_read_lz4_sequence(input + candidate - 1) != sequence) {',
+            '}',
+            () {
+              indent.writeln('position++;');
+              indent.writeln('continue;');
+            },
+          );
+          indent.newln();
+          indent.writeln('size_t match = candidate - 1;');
+          indent.writeln('size_t match_length = 4;');
+          indent.writeScoped(
+            'while (position + match_length < length - last_literals && input[match + match_length] == input[position + match_length]) {',
+            '}',
+            () {
+              indent.writeln('match_length++;');
+            },
+          );
+          indent.writeln(
+            '${codecMethodPrefix}_write_lz4_literals(output, input + anchor, position - anchor, match_length - 4);',
+          );
+          indent.writeln('size_t offset = position - match;');
+          indent.writeln(
+            'uint8_t offset_bytes[2] = {static_cast<uint8_t>(offset & 0xff), static_cast<uint8_t>(offset >> 8)};',
+          );
+          indent.writeln('g_byte_array_append(output, offset_bytes, 2);');
+          indent.writeScoped('if (match_length - 4 >= 15) {', '}', () {
+            indent.writeln(
+              '${codecMethodPrefix}_write_lz4_length(output, match_length - 4 - 15);',
+            );
+          });
+          indent.writeln('position += match_length;');
+          indent.writeln('anchor = position;');
+        },
+      );
+      indent.writeln(
+        '${codecMethodPrefix}_write_lz4_literals(output, input + anchor, length - anchor, 0);',
+      );
+      indent.writeln('return output;');
+    },
+  );
+
+  indent.newln();
+  indent.writeScoped(
+    'static gboolean ${codecMethodPrefix}_write_compressed_message(FlStandardMessageCodec* codec, GByteArray* buffer, FlValue* message, GError** error) {',
+    '}',
+    () {
+      indent.writeln(
+        '// The message is always the whole value being encoded, so it is encoded',
+      );
+      indent.writeln(
+        '// in place and only copied if compression makes it smaller.',
+      );
+      indent.writeln('size_t start = buffer->len;');
+      indent.writeScoped(
+        'if (!fl_standard_message_codec_write_value(codec, buffer, fl_value_get_list_value(message, 0), error)) {',
+        '}',
+        () {
+          indent.writeln('return FALSE;');
+        },
+      );
+      indent.writeln('size_t length = buffer->len - start;');
+      indent.writeln(
+        'size_t threshold = fl_value_get_int(fl_value_get_list_value(message, 1));',
+      );
+      indent.writeScoped('if (length <= threshold) {', '}', () {
+        indent.writeln('return TRUE;');
+      });
+      indent.writeln(
+        'g_autoptr(GByteArray) compressed = ${codecMethodPrefix}_compress_lz4(buffer->data + start, length);',
+      );
+      indent.writeScoped('if (compressed->len >= length) {', '}', () {
+        indent.writeln('return TRUE;');
+      });
+      indent.newln();
+      indent.writeln('g_byte_array_set_size(buffer, start);');
+      indent.writeln(
+        'uint8_t type = ${codecMethodPrefix}_compressed_message_type;',
+      );
+      indent.writeln('g_byte_array_append(buffer, &type, sizeof(uint8_t));');
+      indent.writeln(
+        'fl_standard_message_codec_write_size(codec, buffer, length);',
+      );
+      indent.writeln(
+        'fl_standard_message_codec_write_size(codec, buffer, compressed->len);',
+      );
+      indent.writeln(
+        'g_byte_array_append(buffer, compressed->data, compressed->len);',
+      );
+      indent.writeln('return TRUE;');
+    },
+  );
+}
+
+// Writes the function used to mark messages sent to Flutter for compression.
+void _writeCompressMessageFunctions(Indent indent, String codecMethodPrefix) {
+  indent.newln();
+  indent.writeln(
+    '// Returns [value] wrapped so that the codec compresses its encoding if it is',
+  );
+  indent.writeln(
+    '// larger than [threshold] bytes and compression makes it smaller.',
+  );
+  indent.writeScoped(
+    'static FlValue* ${codecMethodPrefix}_compress_message(FlValue* value, size_t threshold) {',
+    '}',
+    () {
+      indent.writeln('FlValue* message = fl_value_new_list();');
+      indent.writeln('fl_value_append(message, value);');
+      indent.writeln(
+        'fl_value_append_take(message, fl_value_new_int(threshold));',
+      );
+      indent.writeln(
+        'return fl_value_new_custom(${codecMethodPrefix}_compressed_message_type, message, reinterpret_cast<GDestroyNotify>(fl_value_unref));',
+      );
+    },
+  );
+}
+
+// Writes the functions used by the codec to encode and decode enum indexes.
+//
+// Enum values are sent as integers, these are read and written directly so no
+// intermediate FlValue is required.
+void _writeEnumIndexCodecFunctions(Indent indent, String codecMethodPrefix) {
+  indent.newln();
+  indent.writeln(
+    '// The standard codec type tag for a 32-bit integer, used to encode enum values.',
+  );
+  indent.writeln('static const uint8_t ${codecMethodPrefix}_int32_type = 3;');
+
+  indent.newln();
+  indent.writeScoped(
+    'static gboolean ${codecMethodPrefix}_write_enum_index(GByteArray* buffer, int index) {',
+    '}',
+    () {
+      indent.writeln('uint8_t type = ${codecMethodPrefix}_int32_type;');
+      indent.writeln('g_byte_array_append(buffer, &type, sizeof(uint8_t));');
+      indent.writeln('int32_t value = index;');
+      indent.writeln(
+        'g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value), sizeof(int32_t));',
+      );
+      indent.writeln('return TRUE;');
+    },
+  );
+
+  indent.newln();
+  indent.writeScoped(
+    'static gboolean ${codecMethodPrefix}_read_enum_index(FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, int* index, GError** error) {',
+    '}',
+    () {
+      indent.writeln('size_t data_length;');
+      indent.writeln(
+        'const uint8_t* data = static_cast<const uint8_t*>(g_bytes_get_data(buffer, &data_length));',
+      );
+      indent.writeScoped(
+        'if (*offset + sizeof(uint8_t) + sizeof(int32_t) <= data_length && data[*offset] == ${codecMethodPrefix}_int32_type) {',
+        '}',
+        () {
+          indent.writeln('int32_t value;');
+          indent.writeln(
+            'memcpy(&value, data + *offset + sizeof(uint8_t), sizeof(int32_t));',
+          );
+          indent.writeln('*offset += sizeof(uint8_t) + sizeof(int32_t);');
+          indent.writeln('*index = value;');
+          indent.writeln('return TRUE;');
+        },
+      );
+      indent.newln();
+      indent.writeln(
+        'g_autoptr(FlValue) value = fl_standard_message_codec_read_value(codec, buffer, offset, error);',
+      );
+      indent.writeScoped('if (value == nullptr) {', '}', () {
+        indent.writeln('return FALSE;');
+      });
+      indent.writeScoped(
+        'if (fl_value_get_type(value) != FL_VALUE_TYPE_INT) {',
+        '}',
+        () {
+          indent.writeln(
+            'g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Invalid data received for enum");',
+          );
+          indent.writeln('return FALSE;');
+        },
+      );
+      indent.writeln('*index = fl_value_get_int(value);');
+      indent.writeln('return TRUE;');
+    },
+  );
+}
+
 // Returns the name of a GObject class used to send responses to [methodName].
 String _getResponseName(String name, String methodName) {
   final String upperMethodName =
       methodName[0].toUpperCase() + methodName.substring(1);
   return '$name${upperMethodName}Response';
 }
+
+// Returns the name of the struct a result struct handler for [methodName]
+// writes into.
+String _getResultName(String name, String methodName) {
+  final String upperMethodName =
+      methodName[0].toUpperCase() + methodName.substring(1);
+  return '$name${upperMethodName}Result';
+}
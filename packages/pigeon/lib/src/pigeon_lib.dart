@@ -5,6 +5,7 @@
 // ignore_for_file: avoid_print
 
 import 'dart:io';
+import 'dart:isolate';
 import 'dart:mirrors';
 
 import 'package:analyzer/dart/analysis/analysis_context.dart'
@@ -22,6 +23,7 @@ import 'package:path/path.dart' as path;
 import 'ast.dart';
 import 'cpp/cpp_generator.dart';
 import 'dart/dart_generator.dart';
+import 'generation_cache.dart';
 import 'generator_tools.dart';
 import 'generator_tools.dart' as generator_tools;
 import 'gobject/gobject_generator.dart';
@@ -99,6 +101,7 @@ class HostApi {
   const HostApi({
     @Deprecated('Mock/fake the generated Dart API instead.')
     this.dartHostTestHandler,
+    this.compressionThreshold,
   });
 
   /// The name of an interface generated for tests. Implement this
@@ -116,6 +119,15 @@ class HostApi {
   /// Defaults to `null` in which case no handler will be generated.
   @Deprecated('Mock/fake the generated Dart API instead.')
   final String? dartHostTestHandler;
+
+  /// The encoded size in bytes above which replies sent from the host to
+  /// Flutter are LZ4 compressed.
+  ///
+  /// Only the C++ and GObject generators compress messages; the generated Dart
+  /// code decompresses them. Messages sent from Dart are never compressed.
+  ///
+  /// Defaults to `null`, in which case messages are never compressed.
+  final int? compressionThreshold;
 }
 
 /// Metadata to annotate a Pigeon API implemented by Flutter.
@@ -126,7 +138,16 @@ class HostApi {
 /// generated Dart interface.
 class FlutterApi {
   /// Parametric constructor for [FlutterApi].
-  const FlutterApi();
+  const FlutterApi({this.compressionThreshold});
+
+  /// The encoded size in bytes above which calls sent from the host to
+  /// Flutter are LZ4 compressed.
+  ///
+  /// Only the C++ and GObject generators compress messages; the generated Dart
+  /// code decompresses them. Replies sent from Dart are never compressed.
+  ///
+  /// Defaults to `null`, in which case messages are never compressed.
+  final int? compressionThreshold;
 }
 
 /// Metadata to annotate a ProxyAPI.
@@ -224,6 +245,20 @@ class SwiftClass {
   const SwiftClass();
 }
 
+/// Metadata to annotate data classes whose values are kept in sync with Dart.
+///
+/// When a `@Synced` class is passed as a non-nullable argument to a
+/// `@FlutterApi` method, hosts that support it (C++ and GObject) remember the
+/// last value sent on that channel and only send the fields that changed. The
+/// generated Dart handler applies the patch to its cached copy of the value.
+///
+/// Hosts without support keep sending the full value, which the Dart side
+/// also accepts.
+class Synced {
+  /// Constructor.
+  const Synced();
+}
+
 /// Metadata annotation to control how handlers are dispatched for HostApi's.
 /// Note that the TaskQueue API might not be available on the target version of
 /// Flutter, see also:
@@ -264,6 +299,7 @@ class PigeonOptions {
     this.debugGenerators,
     this.basePath,
     String? dartPackageName,
+    this.cacheDir,
   }) : _dartPackageName = dartPackageName;
 
   /// Path to the file which will be processed.
@@ -339,6 +375,13 @@ class PigeonOptions {
   /// The name of the package the pigeon files will be used in.
   final String? _dartPackageName;
 
+  /// A directory to cache generated outputs in.
+  ///
+  /// When set, a run whose input file, options and pigeon version match a
+  /// previous run restores that run's outputs instead of parsing and
+  /// generating them again.
+  final String? cacheDir;
+
   /// Creates a [PigeonOptions] from a Map representation where:
   /// `x = PigeonOptions.fromMap(x.toMap())`.
   static PigeonOptions fromMap(Map<String, Object> map) {
@@ -383,6 +426,7 @@ class PigeonOptions {
       debugGenerators: map['debugGenerators'] as bool?,
       basePath: map['basePath'] as String?,
       dartPackageName: map['dartPackageName'] as String?,
+      cacheDir: map['cacheDir'] as String?,
     );
   }
 
@@ -414,6 +458,7 @@ class PigeonOptions {
       if (debugGenerators != null) 'debugGenerators': debugGenerators!,
       if (basePath != null) 'basePath': basePath!,
       if (_dartPackageName != null) 'dartPackageName': _dartPackageName,
+      if (cacheDir != null) 'cacheDir': cacheDir!,
     };
     return result;
   }
@@ -611,6 +656,13 @@ ${_argParser.usage}''';
     ..addOption(
       'package_name',
       help: 'The package that generated code will be in.',
+    )
+    ..addOption(
+      'cache_dir',
+      help:
+          'Directory to cache generated outputs in. Runs with an unchanged '
+          'input and options reuse the cached outputs.',
+      aliases: const <String>['cache-dir'],
     );
 
   /// Convert command-line arguments to [PigeonOptions].
@@ -652,6 +704,7 @@ ${_argParser.usage}''';
       debugGenerators: results['debug_generators'] as bool?,
       basePath: results['base_path'] as String?,
       dartPackageName: results['package_name'] as String?,
+      cacheDir: results['cache_dir'] as String?,
     );
     return opts;
   }
@@ -723,6 +776,20 @@ ${_argParser.usage}''';
       return 0;
     }
 
+    // Outputs can only be cached when they are fully determined by the input
+    // file and options.
+    final String? cacheDir = options.cacheDir;
+    final GenerationCache? cache =
+        cacheDir != null && adapters == null && parseResults == null
+        ? GenerationCache(cacheDir, options)
+        : null;
+    if (cache != null) {
+      if (cache.restore()) {
+        return 0;
+      }
+      startRecordingOutputs();
+    }
+
     parseResults =
         parseResults ?? pigeon.parseFile(options.input!, sdkPath: sdkPath);
 
@@ -761,6 +828,9 @@ ${_argParser.usage}''';
     }
 
     if (errors.isNotEmpty) {
+      if (cache != null) {
+        stopRecordingOutputs();
+      }
       printErrors(
         errors
             .map(
@@ -786,9 +856,68 @@ ${_argParser.usage}''';
       }
     }
 
+    if (cache != null) {
+      final String? copyrightHeader = options.copyrightHeader;
+      cache.store(
+        dependencies: <String>[
+          options.input!,
+          if (copyrightHeader != null)
+            path.posix.join(options.basePath ?? '', copyrightHeader),
+        ],
+        outputs: stopRecordingOutputs(),
+      );
+    }
+
     return 0;
   }
 
+  /// Runs [runWithOptions] for each of [options], generating independent
+  /// input files in parallel on separate isolates.
+  ///
+  /// At most [concurrency] isolates are used at once, which defaults to the
+  /// number of processors. Returns the first non-zero result, or 0 if every
+  /// run succeeded.
+  static Future<int> runAllWithOptions(
+    List<PigeonOptions> options, {
+    String? sdkPath,
+    int? concurrency,
+  }) async {
+    final results = List<int>.filled(options.length, 0);
+    var nextIndex = 0;
+    Future<void> runNext() async {
+      while (nextIndex < options.length) {
+        final int index = nextIndex++;
+        results[index] = await _runInIsolate(
+          options[index],
+          sdkPath,
+          includeVersionInGeneratedWarning,
+        );
+      }
+    }
+
+    final int workerCount = (concurrency ?? Platform.numberOfProcessors).clamp(
+      1,
+      options.isEmpty ? 1 : options.length,
+    );
+    await Future.wait(
+      List<Future<void>>.generate(workerCount, (_) => runNext()),
+    );
+    return results.firstWhere((int result) => result != 0, orElse: () => 0);
+  }
+
+  static Future<int> _runInIsolate(
+    PigeonOptions options,
+    String? sdkPath,
+    bool includeVersion,
+  ) {
+    // Globals aren't shared between isolates, so carry over the ones that
+    // affect the generated output.
+    return Isolate.run(() {
+      includeVersionInGeneratedWarning = includeVersion;
+      return runWithOptions(options, sdkPath: sdkPath);
+    });
+  }
+
   /// Print a list of errors to stderr.
   static void printErrors(List<Error> errors) {
     for (final err in errors) {
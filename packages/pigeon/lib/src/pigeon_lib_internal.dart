@@ -189,6 +189,24 @@ Iterable<String> _lineReader(String path) sync* {
   }
 }
 
+/// The outputs opened by [_openSink] since [startRecordingOutputs] was called,
+/// or null if outputs aren't being recorded.
+Set<String>? _recordedOutputs;
+
+/// Starts recording the paths of the outputs opened by generator adapters.
+void startRecordingOutputs() {
+  _recordedOutputs = <String>{};
+}
+
+/// Stops recording outputs and returns the paths opened since
+/// [startRecordingOutputs] was called. `stdout` is included if any output was
+/// written to standard output.
+Set<String> stopRecordingOutputs() {
+  final Set<String> outputs = _recordedOutputs ?? <String>{};
+  _recordedOutputs = null;
+  return outputs;
+}
+
 IOSink? _openSink(String? output, {String basePath = ''}) {
   if (output == null) {
     return null;
@@ -197,10 +215,12 @@ IOSink? _openSink(String? output, {String basePath = ''}) {
   File file;
   if (output == 'stdout') {
     sink = stdout;
+    _recordedOutputs?.add(output);
   } else {
     file = File(path.posix.join(basePath, output));
     file.createSync(recursive: true);
     sink = file.openWrite();
+    _recordedOutputs?.add(file.path);
   }
   return sink;
 }
@@ -820,6 +840,25 @@ List<Error> _validateAst(Root root, String source) {
         ),
       );
     }
+    final int? compressionThreshold = api.compressionThreshold;
+    if (compressionThreshold != null) {
+      if (compressionThreshold <= 0) {
+        result.add(
+          Error(
+            message:
+                'compressionThreshold must be positive in API "${api.name}"',
+          ),
+        );
+      }
+      if (root.apis.any((Api api) => api is AstProxyApi)) {
+        result.add(
+          Error(
+            message:
+                'compressionThreshold can not be used in a file that defines ProxyApis, in API "${api.name}"',
+          ),
+        );
+      }
+    }
     if (api is AstEventChannelApi) {
       if (containsEventChannelApi) {
         result.add(
@@ -1592,6 +1631,7 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
           (dart_ast.Annotation element) => element.name.name == 'HostApi',
         );
         String? dartHostTestHandler;
+        int? compressionThreshold;
         if (hostApi.arguments != null) {
           for (final dart_ast.Expression expression
               in hostApi.arguments!.arguments) {
@@ -1603,6 +1643,13 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
                     is dart_ast.SimpleStringLiteral) {
                   dartHostTestHandler = dartHostTestHandlerExpression.value;
                 }
+              } else if (expression.name.label.name == 'compressionThreshold') {
+                final dart_ast.Expression compressionThresholdExpression =
+                    expression.expression;
+                if (compressionThresholdExpression
+                    is dart_ast.IntegerLiteral) {
+                  compressionThreshold = compressionThresholdExpression.value;
+                }
               }
             }
           }
@@ -1612,14 +1659,32 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
           name: node.name.lexeme,
           methods: <Method>[],
           dartHostTestHandler: dartHostTestHandler,
+          compressionThreshold: compressionThreshold,
           documentationComments: _documentationCommentsParser(
             node.documentationComment?.tokens,
           ),
         );
       } else if (_hasMetadata(node.metadata, 'FlutterApi')) {
+        final dart_ast.Annotation flutterApi = node.metadata.firstWhere(
+          (dart_ast.Annotation element) => element.name.name == 'FlutterApi',
+        );
+        int? compressionThreshold;
+        for (final dart_ast.Expression expression
+            in flutterApi.arguments?.arguments ??
+                const <dart_ast.Expression>[]) {
+          if (expression is dart_ast.NamedExpression &&
+              expression.name.label.name == 'compressionThreshold') {
+            final dart_ast.Expression compressionThresholdExpression =
+                expression.expression;
+            if (compressionThresholdExpression is dart_ast.IntegerLiteral) {
+              compressionThreshold = compressionThresholdExpression.value;
+            }
+          }
+        }
         _currentApi = AstFlutterApi(
           name: node.name.lexeme,
           methods: <Method>[],
+          compressionThreshold: compressionThreshold,
           documentationComments: _documentationCommentsParser(
             node.documentationComment?.tokens,
           ),
@@ -1781,6 +1846,7 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
             node.extendsClause?.superclass.name.toString(),
         isSealed: node.sealedKeyword != null,
         isSwiftClass: _hasMetadata(node.metadata, 'SwiftClass'),
+        isSynced: _hasMetadata(node.metadata, 'Synced'),
         documentationComments: _documentationCommentsParser(
           node.documentationComment?.tokens,
         ),
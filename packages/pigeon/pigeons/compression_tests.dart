@@ -0,0 +1,18 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file is used to test the compression of large messages sent by C++ and
+// GObject hosts.
+
+import 'package:pigeon/pigeon.dart';
+
+@HostApi(compressionThreshold: 64)
+abstract class CompressedHostApi {
+  String echoString(String value);
+}
+
+@FlutterApi(compressionThreshold: 64)
+abstract class CompressedFlutterApi {
+  String echoString(String value);
+}
@@ -18,6 +18,7 @@ class UnusedClass {
 }
 
 /// A class containing all supported types.
+@Synced()
 class AllTypes {
   AllTypes({
     this.aBool = false,
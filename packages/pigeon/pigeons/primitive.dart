@@ -4,6 +4,15 @@
 
 import 'package:pigeon/pigeon.dart';
 
+@ConfigurePigeon(
+  PigeonOptions(
+    cppOptions: CppOptions(
+      cancellableFlutterApis: true,
+      channelNameTables: true,
+    ),
+    gobjectOptions: GObjectOptions(resultStructs: true),
+  ),
+)
 @HostApi()
 abstract class PrimitiveHostApi {
   int anInt(int value);
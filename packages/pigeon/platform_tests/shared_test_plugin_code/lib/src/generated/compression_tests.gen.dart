@@ -0,0 +1,201 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Autogenerated from Pigeon, do not edit directly.
+// See also: https://pub.dev/packages/pigeon
+// ignore_for_file: public_member_api_docs, non_constant_identifier_names, avoid_as, unused_import, unnecessary_parenthesis, prefer_null_aware_operators, omit_local_variable_types, omit_obvious_local_variable_types, unused_shown_name, unnecessary_import, no_leading_underscores_for_local_identifiers
+
+import 'dart:async';
+import 'dart:typed_data' show Float64List, Int32List, Int64List, Uint8List;
+
+import 'package:flutter/foundation.dart' show ReadBuffer, WriteBuffer;
+import 'package:flutter/services.dart';
+
+PlatformException _createConnectionError(String channelName) {
+  return PlatformException(
+    code: 'channel-error',
+    message: 'Unable to establish connection on channel: "$channelName".',
+  );
+}
+
+List<Object?> wrapResponse({
+  Object? result,
+  PlatformException? error,
+  bool empty = false,
+}) {
+  if (empty) {
+    return <Object?>[];
+  }
+  if (error == null) {
+    return <Object?>[result];
+  }
+  return <Object?>[error.code, error.message, error.details];
+}
+
+Uint8List _decompressLz4(Uint8List input, int length) {
+  final Uint8List output = Uint8List(length);
+  int inputIndex = 0;
+  int outputIndex = 0;
+  while (inputIndex < input.length) {
+    final int token = input[inputIndex++];
+    int literalLength = token >> 4;
+    if (literalLength == 15) {
+      int byte;
+      do {
+        byte = input[inputIndex++];
+        literalLength += byte;
+      } while (byte == 255);
+    }
+    output.setRange(
+      outputIndex,
+      outputIndex + literalLength,
+      input,
+      inputIndex,
+    );
+    inputIndex += literalLength;
+    outputIndex += literalLength;
+    if (inputIndex >= input.length) {
+      break;
+    }
+    final int offset = input[inputIndex] | (input[inputIndex + 1] << 8);
+    inputIndex += 2;
+    int matchLength = (token & 0x0f) + 4;
+    if (matchLength == 19) {
+      int byte;
+      do {
+        byte = input[inputIndex++];
+        matchLength += byte;
+      } while (byte == 255);
+    }
+    // Matches may overlap the bytes they produce, so copy one byte at a time.
+    for (int i = 0; i < matchLength; i++) {
+      output[outputIndex] = output[outputIndex - offset];
+      outputIndex++;
+    }
+  }
+  return output;
+}
+
+class _PigeonCodec extends StandardMessageCodec {
+  const _PigeonCodec();
+  @override
+  void writeValue(WriteBuffer buffer, Object? value) {
+    if (value is int) {
+      buffer.putUint8(4);
+      buffer.putInt64(value);
+    } else {
+      super.writeValue(buffer, value);
+    }
+  }
+
+  @override
+  Object? readValueOfType(int type, ReadBuffer buffer) {
+    switch (type) {
+      case 128:
+        final int length = readSize(buffer);
+        final Uint8List compressed = buffer.getUint8List(readSize(buffer));
+        final Uint8List message = _decompressLz4(compressed, length);
+        return readValue(ReadBuffer(message.buffer.asByteData()));
+      default:
+        return super.readValueOfType(type, buffer);
+    }
+  }
+}
+
+class CompressedHostApi {
+  /// Constructor for [CompressedHostApi].  The [binaryMessenger] named argument is
+  /// available for dependency injection.  If it is left null, the default
+  /// BinaryMessenger will be used which routes to the host platform.
+  CompressedHostApi({
+    BinaryMessenger? binaryMessenger,
+    String messageChannelSuffix = '',
+  }) : pigeonVar_binaryMessenger = binaryMessenger,
+       pigeonVar_messageChannelSuffix = messageChannelSuffix.isNotEmpty
+           ? '.$messageChannelSuffix'
+           : '';
+  final BinaryMessenger? pigeonVar_binaryMessenger;
+
+  static const MessageCodec<Object?> pigeonChannelCodec = _PigeonCodec();
+
+  final String pigeonVar_messageChannelSuffix;
+
+  Future<String> echoString(String value) async {
+    final pigeonVar_channelName =
+        'dev.flutter.pigeon.pigeon_integration_tests.CompressedHostApi.echoString$pigeonVar_messageChannelSuffix';
+    final pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final Future<Object?> pigeonVar_sendFuture = pigeonVar_channel.send(
+      <Object?>[value],
+    );
+    final pigeonVar_replyList = await pigeonVar_sendFuture as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
+    } else {
+      return (pigeonVar_replyList[0] as String?)!;
+    }
+  }
+}
+
+abstract class CompressedFlutterApi {
+  static const MessageCodec<Object?> pigeonChannelCodec = _PigeonCodec();
+
+  String echoString(String value);
+
+  static void setUp(
+    CompressedFlutterApi? api, {
+    BinaryMessenger? binaryMessenger,
+    String messageChannelSuffix = '',
+  }) {
+    messageChannelSuffix = messageChannelSuffix.isNotEmpty
+        ? '.$messageChannelSuffix'
+        : '';
+    {
+      final pigeonVar_channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.pigeon_integration_tests.CompressedFlutterApi.echoString$messageChannelSuffix',
+        pigeonChannelCodec,
+        binaryMessenger: binaryMessenger,
+      );
+      if (api == null) {
+        pigeonVar_channel.setMessageHandler(null);
+      } else {
+        pigeonVar_channel.setMessageHandler((Object? message) async {
+          assert(
+            message != null,
+            'Argument for dev.flutter.pigeon.pigeon_integration_tests.CompressedFlutterApi.echoString was null.',
+          );
+          final List<Object?> args = (message as List<Object?>?)!;
+          final String? arg_value = (args[0] as String?);
+          assert(
+            arg_value != null,
+            'Argument for dev.flutter.pigeon.pigeon_integration_tests.CompressedFlutterApi.echoString was null, expected non-null String.',
+          );
+          try {
+            final String output = api.echoString(arg_value!);
+            return wrapResponse(result: output);
+          } on PlatformException catch (e) {
+            return wrapResponse(error: e);
+          } catch (e) {
+            return wrapResponse(
+              error: PlatformException(code: 'error', message: e.toString()),
+            );
+          }
+        });
+      }
+    }
+  }
+}
@@ -51,6 +51,14 @@ bool _deepEquals(Object? a, Object? b) {
   return a == b;
 }
 
+List<Object?> _applySyncedPatch(List<Object?> values, List<Object?> patch) {
+  final List<Object?> patched = List<Object?>.of(values);
+  for (int i = 0; i + 1 < patch.length; i += 2) {
+    patched[patch[i]! as int] = patch[i + 1];
+  }
+  return patched;
+}
+
 enum AnEnum { one, two, three, fortyTwo, fourHundredTwentyTwo }
 
 enum AnotherEnum { justInCase }
@@ -5609,6 +5617,7 @@ abstract class FlutterIntegrationCoreApi {
         pigeonChannelCodec,
         binaryMessenger: binaryMessenger,
       );
+      AllTypes? pigeonVar_synced_arg_everything;
       if (api == null) {
         pigeonVar_channel.setMessageHandler(null);
       } else {
@@ -5618,7 +5627,34 @@ abstract class FlutterIntegrationCoreApi {
             'Argument for dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi.echoAllTypes was null.',
           );
           final List<Object?> args = (message as List<Object?>?)!;
-          final AllTypes? arg_everything = (args[0] as AllTypes?);
+          final AllTypes? arg_everything;
+          final Object? pigeonVar_message_arg_everything = args[0];
+          if (pigeonVar_message_arg_everything is List<Object?>) {
+            final AllTypes? pigeonVar_base_arg_everything =
+                pigeonVar_synced_arg_everything;
+            if (pigeonVar_base_arg_everything == null) {
+              return wrapResponse(
+                error: PlatformException(
+                  code: 'synced-state-missing',
+                  message:
+                      'Received a patch for everything without a previous value.',
+                ),
+              );
+            }
+            arg_everything = AllTypes.decode(
+              _applySyncedPatch(
+                pigeonVar_base_arg_everything._toList(),
+                pigeonVar_message_arg_everything,
+              ),
+            );
+          } else {
+            arg_everything = pigeonVar_message_arg_everything as AllTypes?;
+          }
+          if (arg_everything != null) {
+            pigeonVar_synced_arg_everything = AllTypes.decode(
+              arg_everything._toList(),
+            );
+          }
           assert(
             arg_everything != null,
             'Argument for dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi.echoAllTypes was null, expected non-null AllTypes.',
@@ -7,6 +7,112 @@
 
 #include "core_tests.gen.h"
 
+// Returns the table holding the last value sent for each @Synced argument,
+// keyed by the messenger, channel and argument index it was sent with.
+static GHashTable* core_tests_pigeon_test_get_synced_snapshots() {
+  static GHashTable* snapshots = nullptr;
+  if (snapshots == nullptr) {
+    snapshots =
+        g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                              reinterpret_cast<GDestroyNotify>(fl_value_unref));
+  }
+  return snapshots;
+}
+
+// Returns the fields of @values that differ from the last value sent as
+// argument @index on @channel_key as a list of alternating field indices
+// and values, or %NULL if the full value has to be sent. Takes ownership of
+// @values and stores it as the new snapshot.
+static FlValue* core_tests_pigeon_test_make_synced_patch(
+    const gchar* channel_key, int index, FlValue* values) {
+  GHashTable* snapshots = core_tests_pigeon_test_get_synced_snapshots();
+  g_autofree gchar* key = g_strdup_printf("%s#%d", channel_key, index);
+  FlValue* snapshot =
+      static_cast<FlValue*>(g_hash_table_lookup(snapshots, key));
+  FlValue* patch = nullptr;
+  if (snapshot != nullptr &&
+      fl_value_get_length(snapshot) == fl_value_get_length(values)) {
+    patch = fl_value_new_list();
+    for (size_t i = 0; i < fl_value_get_length(values); i++) {
+      FlValue* value = fl_value_get_list_value(values, i);
+      if (!fl_value_equal(value, fl_value_get_list_value(snapshot, i))) {
+        fl_value_append_take(patch, fl_value_new_int(i));
+        fl_value_append(patch, value);
+      }
+    }
+  }
+  g_hash_table_replace(snapshots, g_steal_pointer(&key), values);
+  return patch;
+}
+
+static gboolean core_tests_pigeon_test_has_synced_key_prefix(
+    gpointer key, gpointer value, gpointer user_data) {
+  return g_str_has_prefix(static_cast<const gchar*>(key),
+                          static_cast<const gchar*>(user_data));
+}
+
+// Forgets the values sent on @channel_key so the next call sends them in
+// full.
+static void core_tests_pigeon_test_clear_synced_snapshots(
+    const gchar* channel_key) {
+  g_autofree gchar* prefix = g_strdup_printf("%s#", channel_key);
+  g_hash_table_foreach_remove(core_tests_pigeon_test_get_synced_snapshots(),
+                              core_tests_pigeon_test_has_synced_key_prefix,
+                              prefix);
+}
+
+// State of a Flutter API call with @Synced arguments, held as task data.
+typedef struct {
+  FlBasicMessageChannel* channel;
+  gchar* channel_key;
+  // The message with every @Synced argument in full, or %NULL if it was
+  // already sent that way.
+  FlValue* full_message;
+} CoreTestsPigeonTestSyncedCall;
+
+static void core_tests_pigeon_test_synced_call_free(
+    CoreTestsPigeonTestSyncedCall* call) {
+  g_object_unref(call->channel);
+  g_free(call->channel_key);
+  g_clear_pointer(&call->full_message, fl_value_unref);
+  g_free(call);
+}
+
+// Completes a call with @Synced arguments. Forgets the values sent on the
+// channel if the call failed, and sends the full message again if Dart no
+// longer has the values the patches were made against, e.g. after a hot
+// restart.
+static void core_tests_pigeon_test_synced_call_cb(GObject* object,
+                                                  GAsyncResult* result,
+                                                  gpointer user_data) {
+  GTask* task = G_TASK(user_data);
+  CoreTestsPigeonTestSyncedCall* call =
+      static_cast<CoreTestsPigeonTestSyncedCall*>(g_task_get_task_data(task));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) response =
+      fl_basic_message_channel_send_finish(call->channel, result, &error);
+  if (response == nullptr) {
+    core_tests_pigeon_test_clear_synced_snapshots(call->channel_key);
+    g_task_return_error(task, g_steal_pointer(&error));
+    return;
+  }
+  if (fl_value_get_length(response) > 1) {
+    core_tests_pigeon_test_clear_synced_snapshots(call->channel_key);
+    FlValue* code = fl_value_get_list_value(response, 0);
+    if (call->full_message != nullptr &&
+        fl_value_get_type(code) == FL_VALUE_TYPE_STRING &&
+        g_strcmp0(fl_value_get_string(code), "synced-state-missing") == 0) {
+      g_autoptr(FlValue) message = g_steal_pointer(&call->full_message);
+      fl_basic_message_channel_send(call->channel, message,
+                                    g_task_get_cancellable(task),
+                                    core_tests_pigeon_test_synced_call_cb, task);
+      return;
+    }
+  }
+  g_task_return_pointer(task, g_steal_pointer(&response),
+                        reinterpret_cast<GDestroyNotify>(fl_value_unref));
+}
+
 struct _CoreTestsPigeonTestUnusedClass {
   GObject parent_instance;
 
@@ -104,6 +210,8 @@ struct _CoreTestsPigeonTestAllTypes {
   FlValue* object_map;
   FlValue* list_map;
   FlValue* map_map;
+  GHashTable* string_map_index;
+  size_t string_map_index_length;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestAllTypes, core_tests_pigeon_test_all_types,
@@ -129,6 +237,7 @@ static void core_tests_pigeon_test_all_types_dispose(GObject* object) {
   g_clear_pointer(&self->object_map, fl_value_unref);
   g_clear_pointer(&self->list_map, fl_value_unref);
   g_clear_pointer(&self->map_map, fl_value_unref);
+  g_clear_pointer(&self->string_map_index, g_hash_table_unref);
   G_OBJECT_CLASS(core_tests_pigeon_test_all_types_parent_class)
       ->dispose(object);
 }
@@ -373,6 +482,69 @@ FlValue* core_tests_pigeon_test_all_types_get_map_map(
   return self->map_map;
 }
 
+gboolean core_tests_pigeon_test_all_types_lookup_string_map(
+    CoreTestsPigeonTestAllTypes* self, const gchar* key, const gchar** value) {
+  g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_TYPES(self), FALSE);
+
+  size_t length = fl_value_get_length(self->string_map);
+  // Entries can be added to the map after the index is built, so it is
+  // rebuilt when the length of the map changes.
+  if (self->string_map_index == nullptr ||
+      self->string_map_index_length != length) {
+    g_clear_pointer(&self->string_map_index, g_hash_table_unref);
+    self->string_map_index =
+        g_hash_table_new_full(g_str_hash, g_str_equal, g_free, nullptr);
+    self->string_map_index_length = length;
+    for (size_t i = 0; i < length; i++) {
+      FlValue* map_key = fl_value_get_map_key(self->string_map, i);
+      // The first entry for a key is used, as fl_value_lookup_string() does.
+      if (fl_value_get_type(map_key) == FL_VALUE_TYPE_STRING &&
+          !g_hash_table_contains(self->string_map_index,
+                                 fl_value_get_string(map_key))) {
+        g_hash_table_insert(self->string_map_index,
+                            g_strdup(fl_value_get_string(map_key)),
+                            GSIZE_TO_POINTER(i + 1));
+      }
+    }
+  }
+
+  // The index holds positions plus one, so zero means not present. The
+  // value is read from the map as it can be replaced after the index is
+  // built.
+  size_t position =
+      GPOINTER_TO_SIZE(g_hash_table_lookup(self->string_map_index, key));
+  if (position == 0) {
+    return FALSE;
+  }
+  FlValue* map_value = fl_value_get_map_value(self->string_map, position - 1);
+  if (fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {
+    return FALSE;
+  }
+  if (value != nullptr) {
+    *value = fl_value_get_string(map_value);
+  }
+  return TRUE;
+}
+
+void core_tests_pigeon_test_all_types_foreach_string_map(
+    CoreTestsPigeonTestAllTypes* self,
+    CoreTestsPigeonTestAllTypesStringMapFunc func,
+    gpointer user_data) {
+  g_return_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_TYPES(self));
+
+  size_t length = fl_value_get_length(self->string_map);
+  for (size_t i = 0; i < length; i++) {
+    FlValue* map_key = fl_value_get_map_key(self->string_map, i);
+    FlValue* map_value = fl_value_get_map_value(self->string_map, i);
+    if (fl_value_get_type(map_key) != FL_VALUE_TYPE_STRING ||
+        fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {
+      continue;
+    }
+    func(fl_value_get_string(map_key), fl_value_get_string(map_value),
+         user_data);
+  }
+}
+
 static FlValue* core_tests_pigeon_test_all_types_to_list(
     CoreTestsPigeonTestAllTypes* self) {
   FlValue* values = fl_value_new_list();
@@ -394,12 +566,11 @@ static FlValue* core_tests_pigeon_test_all_types_to_list(
       fl_value_new_float_list(self->a_float_array, self->a_float_array_length));
   fl_value_append_take(
       values, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                  fl_value_new_int(self->an_enum),
-                                  (GDestroyNotify)fl_value_unref));
+                                  GINT_TO_POINTER(self->an_enum), nullptr));
   fl_value_append_take(
       values, fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                  fl_value_new_int(self->another_enum),
-                                  (GDestroyNotify)fl_value_unref));
+                                  GINT_TO_POINTER(self->another_enum),
+                                  nullptr));
   fl_value_append_take(values, fl_value_new_string(self->a_string));
   fl_value_append_take(values, fl_value_ref(self->an_object));
   fl_value_append_take(values, fl_value_ref(self->list));
@@ -445,13 +616,11 @@ core_tests_pigeon_test_all_types_new_from_list(FlValue* values) {
   size_t a_float_array_length = fl_value_get_length(value7);
   FlValue* value8 = fl_value_get_list_value(values, 8);
   CoreTestsPigeonTestAnEnum an_enum = static_cast<CoreTestsPigeonTestAnEnum>(
-      fl_value_get_int(reinterpret_cast<FlValue*>(
-          const_cast<gpointer>(fl_value_get_custom_value(value8)))));
+      GPOINTER_TO_INT(fl_value_get_custom_value(value8)));
   FlValue* value9 = fl_value_get_list_value(values, 9);
   CoreTestsPigeonTestAnotherEnum another_enum =
       static_cast<CoreTestsPigeonTestAnotherEnum>(
-          fl_value_get_int(reinterpret_cast<FlValue*>(
-              const_cast<gpointer>(fl_value_get_custom_value(value9)))));
+          GPOINTER_TO_INT(fl_value_get_custom_value(value9)));
   FlValue* value10 = fl_value_get_list_value(values, 10);
   const gchar* a_string = fl_value_get_string(value10);
   FlValue* value11 = fl_value_get_list_value(values, 11);
@@ -500,10 +669,10 @@ core_tests_pigeon_test_all_types_new_from_list(FlValue* values) {
 struct _CoreTestsPigeonTestAllNullableTypes {
   GObject parent_instance;
 
-  gboolean* a_nullable_bool;
-  int64_t* a_nullable_int;
-  int64_t* a_nullable_int64;
-  double* a_nullable_double;
+  gboolean a_nullable_bool;
+  int64_t a_nullable_int;
+  int64_t a_nullable_int64;
+  double a_nullable_double;
   uint8_t* a_nullable_byte_array;
   size_t a_nullable_byte_array_length;
   int32_t* a_nullable4_byte_array;
@@ -512,8 +681,8 @@ struct _CoreTestsPigeonTestAllNullableTypes {
   size_t a_nullable8_byte_array_length;
   double* a_nullable_float_array;
   size_t a_nullable_float_array_length;
-  CoreTestsPigeonTestAnEnum* a_nullable_enum;
-  CoreTestsPigeonTestAnotherEnum* another_nullable_enum;
+  CoreTestsPigeonTestAnEnum a_nullable_enum;
+  CoreTestsPigeonTestAnotherEnum another_nullable_enum;
   gchar* a_nullable_string;
   FlValue* a_nullable_object;
   CoreTestsPigeonTestAllNullableTypes* all_nullable_types;
@@ -535,6 +704,14 @@ struct _CoreTestsPigeonTestAllNullableTypes {
   FlValue* list_map;
   FlValue* map_map;
   FlValue* recursive_class_map;
+  GHashTable* string_map_index;
+  size_t string_map_index_length;
+  guint has_a_nullable_bool : 1;
+  guint has_a_nullable_int : 1;
+  guint has_a_nullable_int64 : 1;
+  guint has_a_nullable_double : 1;
+  guint has_a_nullable_enum : 1;
+  guint has_another_nullable_enum : 1;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestAllNullableTypes,
@@ -543,12 +720,6 @@ G_DEFINE_TYPE(CoreTestsPigeonTestAllNullableTypes,
 static void core_tests_pigeon_test_all_nullable_types_dispose(GObject* object) {
   CoreTestsPigeonTestAllNullableTypes* self =
       CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES(object);
-  g_clear_pointer(&self->a_nullable_bool, g_free);
-  g_clear_pointer(&self->a_nullable_int, g_free);
-  g_clear_pointer(&self->a_nullable_int64, g_free);
-  g_clear_pointer(&self->a_nullable_double, g_free);
-  g_clear_pointer(&self->a_nullable_enum, g_free);
-  g_clear_pointer(&self->another_nullable_enum, g_free);
   g_clear_pointer(&self->a_nullable_string, g_free);
   g_clear_pointer(&self->a_nullable_object, fl_value_unref);
   g_clear_object(&self->all_nullable_types);
@@ -570,6 +741,7 @@ static void core_tests_pigeon_test_all_nullable_types_dispose(GObject* object) {
   g_clear_pointer(&self->list_map, fl_value_unref);
   g_clear_pointer(&self->map_map, fl_value_unref);
   g_clear_pointer(&self->recursive_class_map, fl_value_unref);
+  g_clear_pointer(&self->string_map_index, g_hash_table_unref);
   G_OBJECT_CLASS(core_tests_pigeon_test_all_nullable_types_parent_class)
       ->dispose(object);
 }
@@ -605,28 +777,28 @@ core_tests_pigeon_test_all_nullable_types_new(
       CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES(g_object_new(
           core_tests_pigeon_test_all_nullable_types_get_type(), nullptr));
   if (a_nullable_bool != nullptr) {
-    self->a_nullable_bool = static_cast<gboolean*>(malloc(sizeof(gboolean)));
-    *self->a_nullable_bool = *a_nullable_bool;
+    self->a_nullable_bool = *a_nullable_bool;
+    self->has_a_nullable_bool = TRUE;
   } else {
-    self->a_nullable_bool = nullptr;
+    self->has_a_nullable_bool = FALSE;
   }
   if (a_nullable_int != nullptr) {
-    self->a_nullable_int = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int = *a_nullable_int;
+    self->a_nullable_int = *a_nullable_int;
+    self->has_a_nullable_int = TRUE;
   } else {
-    self->a_nullable_int = nullptr;
+    self->has_a_nullable_int = FALSE;
   }
   if (a_nullable_int64 != nullptr) {
-    self->a_nullable_int64 = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int64 = *a_nullable_int64;
+    self->a_nullable_int64 = *a_nullable_int64;
+    self->has_a_nullable_int64 = TRUE;
   } else {
-    self->a_nullable_int64 = nullptr;
+    self->has_a_nullable_int64 = FALSE;
   }
   if (a_nullable_double != nullptr) {
-    self->a_nullable_double = static_cast<double*>(malloc(sizeof(double)));
-    *self->a_nullable_double = *a_nullable_double;
+    self->a_nullable_double = *a_nullable_double;
+    self->has_a_nullable_double = TRUE;
   } else {
-    self->a_nullable_double = nullptr;
+    self->has_a_nullable_double = FALSE;
   }
   if (a_nullable_byte_array != nullptr) {
     self->a_nullable_byte_array = static_cast<uint8_t*>(
@@ -668,18 +840,16 @@ core_tests_pigeon_test_all_nullable_types_new(
     self->a_nullable_float_array_length = 0;
   }
   if (a_nullable_enum != nullptr) {
-    self->a_nullable_enum = static_cast<CoreTestsPigeonTestAnEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnEnum)));
-    *self->a_nullable_enum = *a_nullable_enum;
+    self->a_nullable_enum = *a_nullable_enum;
+    self->has_a_nullable_enum = TRUE;
   } else {
-    self->a_nullable_enum = nullptr;
+    self->has_a_nullable_enum = FALSE;
   }
   if (another_nullable_enum != nullptr) {
-    self->another_nullable_enum = static_cast<CoreTestsPigeonTestAnotherEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnotherEnum)));
-    *self->another_nullable_enum = *another_nullable_enum;
+    self->another_nullable_enum = *another_nullable_enum;
+    self->has_another_nullable_enum = TRUE;
   } else {
-    self->another_nullable_enum = nullptr;
+    self->has_another_nullable_enum = FALSE;
   }
   if (a_nullable_string != nullptr) {
     self->a_nullable_string = g_strdup(a_nullable_string);
@@ -794,28 +964,28 @@ gboolean* core_tests_pigeon_test_all_nullable_types_get_a_nullable_bool(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_bool;
+  return self->has_a_nullable_bool ? &self->a_nullable_bool : nullptr;
 }
 
 int64_t* core_tests_pigeon_test_all_nullable_types_get_a_nullable_int(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_int;
+  return self->has_a_nullable_int ? &self->a_nullable_int : nullptr;
 }
 
 int64_t* core_tests_pigeon_test_all_nullable_types_get_a_nullable_int64(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_int64;
+  return self->has_a_nullable_int64 ? &self->a_nullable_int64 : nullptr;
 }
 
 double* core_tests_pigeon_test_all_nullable_types_get_a_nullable_double(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_double;
+  return self->has_a_nullable_double ? &self->a_nullable_double : nullptr;
 }
 
 const uint8_t*
@@ -859,7 +1029,7 @@ core_tests_pigeon_test_all_nullable_types_get_a_nullable_enum(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_enum;
+  return self->has_a_nullable_enum ? &self->a_nullable_enum : nullptr;
 }
 
 CoreTestsPigeonTestAnotherEnum*
@@ -867,7 +1037,8 @@ core_tests_pigeon_test_all_nullable_types_get_another_nullable_enum(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->another_nullable_enum;
+  return self->has_another_nullable_enum ? &self->another_nullable_enum
+                                         : nullptr;
 }
 
 const gchar* core_tests_pigeon_test_all_nullable_types_get_a_nullable_string(
@@ -1018,22 +1189,93 @@ FlValue* core_tests_pigeon_test_all_nullable_types_get_recursive_class_map(
   return self->recursive_class_map;
 }
 
+gboolean core_tests_pigeon_test_all_nullable_types_lookup_string_map(
+    CoreTestsPigeonTestAllNullableTypes* self,
+    const gchar* key,
+    const gchar** value) {
+  g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
+                       FALSE);
+  if (self->string_map == nullptr) {
+    return FALSE;
+  }
+
+  size_t length = fl_value_get_length(self->string_map);
+  // Entries can be added to the map after the index is built, so it is
+  // rebuilt when the length of the map changes.
+  if (self->string_map_index == nullptr ||
+      self->string_map_index_length != length) {
+    g_clear_pointer(&self->string_map_index, g_hash_table_unref);
+    self->string_map_index =
+        g_hash_table_new_full(g_str_hash, g_str_equal, g_free, nullptr);
+    self->string_map_index_length = length;
+    for (size_t i = 0; i < length; i++) {
+      FlValue* map_key = fl_value_get_map_key(self->string_map, i);
+      // The first entry for a key is used, as fl_value_lookup_string() does.
+      if (fl_value_get_type(map_key) == FL_VALUE_TYPE_STRING &&
+          !g_hash_table_contains(self->string_map_index,
+                                 fl_value_get_string(map_key))) {
+        g_hash_table_insert(self->string_map_index,
+                            g_strdup(fl_value_get_string(map_key)),
+                            GSIZE_TO_POINTER(i + 1));
+      }
+    }
+  }
+
+  // The index holds positions plus one, so zero means not present. The
+  // value is read from the map as it can be replaced after the index is
+  // built.
+  size_t position =
+      GPOINTER_TO_SIZE(g_hash_table_lookup(self->string_map_index, key));
+  if (position == 0) {
+    return FALSE;
+  }
+  FlValue* map_value = fl_value_get_map_value(self->string_map, position - 1);
+  if (fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {
+    return FALSE;
+  }
+  if (value != nullptr) {
+    *value = fl_value_get_string(map_value);
+  }
+  return TRUE;
+}
+
+void core_tests_pigeon_test_all_nullable_types_foreach_string_map(
+    CoreTestsPigeonTestAllNullableTypes* self,
+    CoreTestsPigeonTestAllNullableTypesStringMapFunc func,
+    gpointer user_data) {
+  g_return_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self));
+  if (self->string_map == nullptr) {
+    return;
+  }
+
+  size_t length = fl_value_get_length(self->string_map);
+  for (size_t i = 0; i < length; i++) {
+    FlValue* map_key = fl_value_get_map_key(self->string_map, i);
+    FlValue* map_value = fl_value_get_map_value(self->string_map, i);
+    if (fl_value_get_type(map_key) != FL_VALUE_TYPE_STRING ||
+        fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {
+      continue;
+    }
+    func(fl_value_get_string(map_key), fl_value_get_string(map_value),
+         user_data);
+  }
+}
+
 static FlValue* core_tests_pigeon_test_all_nullable_types_to_list(
     CoreTestsPigeonTestAllNullableTypes* self) {
   FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, self->a_nullable_bool != nullptr
-                                   ? fl_value_new_bool(*self->a_nullable_bool)
+  fl_value_append_take(values, self->has_a_nullable_bool
+                                   ? fl_value_new_bool(self->a_nullable_bool)
                                    : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int)
+  fl_value_append_take(values, self->has_a_nullable_int
+                                   ? fl_value_new_int(self->a_nullable_int)
                                    : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int64 != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int64)
+  fl_value_append_take(values, self->has_a_nullable_int64
+                                   ? fl_value_new_int(self->a_nullable_int64)
+                                   : fl_value_new_null());
+  fl_value_append_take(values, self->has_a_nullable_double
+                                   ? fl_value_new_float(self->a_nullable_double)
                                    : fl_value_new_null());
-  fl_value_append_take(values,
-                       self->a_nullable_double != nullptr
-                           ? fl_value_new_float(*self->a_nullable_double)
-                           : fl_value_new_null());
   fl_value_append_take(
       values, self->a_nullable_byte_array != nullptr
                   ? fl_value_new_uint8_list(self->a_nullable_byte_array,
@@ -1056,17 +1298,16 @@ static FlValue* core_tests_pigeon_test_all_nullable_types_to_list(
                   : fl_value_new_null());
   fl_value_append_take(
       values,
-      self->a_nullable_enum != nullptr
+      self->has_a_nullable_enum
           ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(*self->a_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(self->a_nullable_enum), nullptr)
           : fl_value_new_null());
   fl_value_append_take(
       values,
-      self->another_nullable_enum != nullptr
+      self->has_another_nullable_enum
           ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*self->another_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(self->another_nullable_enum),
+                                nullptr)
           : fl_value_new_null());
   fl_value_append_take(values,
                        self->a_nullable_string != nullptr
@@ -1199,8 +1440,7 @@ core_tests_pigeon_test_all_nullable_types_new_from_list(FlValue* values) {
   CoreTestsPigeonTestAnEnum a_nullable_enum_value;
   if (fl_value_get_type(value8) != FL_VALUE_TYPE_NULL) {
     a_nullable_enum_value = static_cast<CoreTestsPigeonTestAnEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value8)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value8)));
     a_nullable_enum = &a_nullable_enum_value;
   }
   FlValue* value9 = fl_value_get_list_value(values, 9);
@@ -1208,8 +1448,7 @@ core_tests_pigeon_test_all_nullable_types_new_from_list(FlValue* values) {
   CoreTestsPigeonTestAnotherEnum another_nullable_enum_value;
   if (fl_value_get_type(value9) != FL_VALUE_TYPE_NULL) {
     another_nullable_enum_value = static_cast<CoreTestsPigeonTestAnotherEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value9)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value9)));
     another_nullable_enum = &another_nullable_enum_value;
   }
   FlValue* value10 = fl_value_get_list_value(values, 10);
@@ -1334,10 +1573,10 @@ core_tests_pigeon_test_all_nullable_types_new_from_list(FlValue* values) {
 struct _CoreTestsPigeonTestAllNullableTypesWithoutRecursion {
   GObject parent_instance;
 
-  gboolean* a_nullable_bool;
-  int64_t* a_nullable_int;
-  int64_t* a_nullable_int64;
-  double* a_nullable_double;
+  gboolean a_nullable_bool;
+  int64_t a_nullable_int;
+  int64_t a_nullable_int64;
+  double a_nullable_double;
   uint8_t* a_nullable_byte_array;
   size_t a_nullable_byte_array_length;
   int32_t* a_nullable4_byte_array;
@@ -1346,8 +1585,8 @@ struct _CoreTestsPigeonTestAllNullableTypesWithoutRecursion {
   size_t a_nullable8_byte_array_length;
   double* a_nullable_float_array;
   size_t a_nullable_float_array_length;
-  CoreTestsPigeonTestAnEnum* a_nullable_enum;
-  CoreTestsPigeonTestAnotherEnum* another_nullable_enum;
+  CoreTestsPigeonTestAnEnum a_nullable_enum;
+  CoreTestsPigeonTestAnotherEnum another_nullable_enum;
   gchar* a_nullable_string;
   FlValue* a_nullable_object;
   FlValue* list;
@@ -1366,6 +1605,14 @@ struct _CoreTestsPigeonTestAllNullableTypesWithoutRecursion {
   FlValue* object_map;
   FlValue* list_map;
   FlValue* map_map;
+  GHashTable* string_map_index;
+  size_t string_map_index_length;
+  guint has_a_nullable_bool : 1;
+  guint has_a_nullable_int : 1;
+  guint has_a_nullable_int64 : 1;
+  guint has_a_nullable_double : 1;
+  guint has_a_nullable_enum : 1;
+  guint has_another_nullable_enum : 1;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestAllNullableTypesWithoutRecursion,
@@ -1376,12 +1623,6 @@ static void core_tests_pigeon_test_all_nullable_types_without_recursion_dispose(
     GObject* object) {
   CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self =
       CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(object);
-  g_clear_pointer(&self->a_nullable_bool, g_free);
-  g_clear_pointer(&self->a_nullable_int, g_free);
-  g_clear_pointer(&self->a_nullable_int64, g_free);
-  g_clear_pointer(&self->a_nullable_double, g_free);
-  g_clear_pointer(&self->a_nullable_enum, g_free);
-  g_clear_pointer(&self->another_nullable_enum, g_free);
   g_clear_pointer(&self->a_nullable_string, g_free);
   g_clear_pointer(&self->a_nullable_object, fl_value_unref);
   g_clear_pointer(&self->list, fl_value_unref);
@@ -1400,6 +1641,7 @@ static void core_tests_pigeon_test_all_nullable_types_without_recursion_dispose(
   g_clear_pointer(&self->object_map, fl_value_unref);
   g_clear_pointer(&self->list_map, fl_value_unref);
   g_clear_pointer(&self->map_map, fl_value_unref);
+  g_clear_pointer(&self->string_map_index, g_hash_table_unref);
   G_OBJECT_CLASS(
       core_tests_pigeon_test_all_nullable_types_without_recursion_parent_class)
       ->dispose(object);
@@ -1436,28 +1678,28 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new(
           core_tests_pigeon_test_all_nullable_types_without_recursion_get_type(),
           nullptr));
   if (a_nullable_bool != nullptr) {
-    self->a_nullable_bool = static_cast<gboolean*>(malloc(sizeof(gboolean)));
-    *self->a_nullable_bool = *a_nullable_bool;
+    self->a_nullable_bool = *a_nullable_bool;
+    self->has_a_nullable_bool = TRUE;
   } else {
-    self->a_nullable_bool = nullptr;
+    self->has_a_nullable_bool = FALSE;
   }
   if (a_nullable_int != nullptr) {
-    self->a_nullable_int = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int = *a_nullable_int;
+    self->a_nullable_int = *a_nullable_int;
+    self->has_a_nullable_int = TRUE;
   } else {
-    self->a_nullable_int = nullptr;
+    self->has_a_nullable_int = FALSE;
   }
   if (a_nullable_int64 != nullptr) {
-    self->a_nullable_int64 = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int64 = *a_nullable_int64;
+    self->a_nullable_int64 = *a_nullable_int64;
+    self->has_a_nullable_int64 = TRUE;
   } else {
-    self->a_nullable_int64 = nullptr;
+    self->has_a_nullable_int64 = FALSE;
   }
   if (a_nullable_double != nullptr) {
-    self->a_nullable_double = static_cast<double*>(malloc(sizeof(double)));
-    *self->a_nullable_double = *a_nullable_double;
+    self->a_nullable_double = *a_nullable_double;
+    self->has_a_nullable_double = TRUE;
   } else {
-    self->a_nullable_double = nullptr;
+    self->has_a_nullable_double = FALSE;
   }
   if (a_nullable_byte_array != nullptr) {
     self->a_nullable_byte_array = static_cast<uint8_t*>(
@@ -1499,18 +1741,16 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new(
     self->a_nullable_float_array_length = 0;
   }
   if (a_nullable_enum != nullptr) {
-    self->a_nullable_enum = static_cast<CoreTestsPigeonTestAnEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnEnum)));
-    *self->a_nullable_enum = *a_nullable_enum;
+    self->a_nullable_enum = *a_nullable_enum;
+    self->has_a_nullable_enum = TRUE;
   } else {
-    self->a_nullable_enum = nullptr;
+    self->has_a_nullable_enum = FALSE;
   }
   if (another_nullable_enum != nullptr) {
-    self->another_nullable_enum = static_cast<CoreTestsPigeonTestAnotherEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnotherEnum)));
-    *self->another_nullable_enum = *another_nullable_enum;
+    self->another_nullable_enum = *another_nullable_enum;
+    self->has_another_nullable_enum = TRUE;
   } else {
-    self->another_nullable_enum = nullptr;
+    self->has_another_nullable_enum = FALSE;
   }
   if (a_nullable_string != nullptr) {
     self->a_nullable_string = g_strdup(a_nullable_string);
@@ -1611,7 +1851,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_bool(
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_bool;
+  return self->has_a_nullable_bool ? &self->a_nullable_bool : nullptr;
 }
 
 int64_t*
@@ -1620,7 +1860,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_int(
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_int;
+  return self->has_a_nullable_int ? &self->a_nullable_int : nullptr;
 }
 
 int64_t*
@@ -1629,7 +1869,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_int64
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_int64;
+  return self->has_a_nullable_int64 ? &self->a_nullable_int64 : nullptr;
 }
 
 double*
@@ -1638,7 +1878,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_doubl
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_double;
+  return self->has_a_nullable_double ? &self->a_nullable_double : nullptr;
 }
 
 const uint8_t*
@@ -1687,7 +1927,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_enum(
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_enum;
+  return self->has_a_nullable_enum ? &self->a_nullable_enum : nullptr;
 }
 
 CoreTestsPigeonTestAnotherEnum*
@@ -1696,7 +1936,8 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_another_nullable
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->another_nullable_enum;
+  return self->has_another_nullable_enum ? &self->another_nullable_enum
+                                         : nullptr;
 }
 
 const gchar*
@@ -1859,23 +2100,98 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_map_map(
   return self->map_map;
 }
 
+gboolean
+core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self,
+    const gchar* key,
+    const gchar** value) {
+  g_return_val_if_fail(
+      CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
+      FALSE);
+  if (self->string_map == nullptr) {
+    return FALSE;
+  }
+
+  size_t length = fl_value_get_length(self->string_map);
+  // Entries can be added to the map after the index is built, so it is
+  // rebuilt when the length of the map changes.
+  if (self->string_map_index == nullptr ||
+      self->string_map_index_length != length) {
+    g_clear_pointer(&self->string_map_index, g_hash_table_unref);
+    self->string_map_index =
+        g_hash_table_new_full(g_str_hash, g_str_equal, g_free, nullptr);
+    self->string_map_index_length = length;
+    for (size_t i = 0; i < length; i++) {
+      FlValue* map_key = fl_value_get_map_key(self->string_map, i);
+      // The first entry for a key is used, as fl_value_lookup_string() does.
+      if (fl_value_get_type(map_key) == FL_VALUE_TYPE_STRING &&
+          !g_hash_table_contains(self->string_map_index,
+                                 fl_value_get_string(map_key))) {
+        g_hash_table_insert(self->string_map_index,
+                            g_strdup(fl_value_get_string(map_key)),
+                            GSIZE_TO_POINTER(i + 1));
+      }
+    }
+  }
+
+  // The index holds positions plus one, so zero means not present. The
+  // value is read from the map as it can be replaced after the index is
+  // built.
+  size_t position =
+      GPOINTER_TO_SIZE(g_hash_table_lookup(self->string_map_index, key));
+  if (position == 0) {
+    return FALSE;
+  }
+  FlValue* map_value = fl_value_get_map_value(self->string_map, position - 1);
+  if (fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {
+    return FALSE;
+  }
+  if (value != nullptr) {
+    *value = fl_value_get_string(map_value);
+  }
+  return TRUE;
+}
+
+void
+core_tests_pigeon_test_all_nullable_types_without_recursion_foreach_string_map(
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self,
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursionStringMapFunc func,
+    gpointer user_data) {
+  g_return_if_fail(
+      CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self));
+  if (self->string_map == nullptr) {
+    return;
+  }
+
+  size_t length = fl_value_get_length(self->string_map);
+  for (size_t i = 0; i < length; i++) {
+    FlValue* map_key = fl_value_get_map_key(self->string_map, i);
+    FlValue* map_value = fl_value_get_map_value(self->string_map, i);
+    if (fl_value_get_type(map_key) != FL_VALUE_TYPE_STRING ||
+        fl_value_get_type(map_value) == FL_VALUE_TYPE_NULL) {
+      continue;
+    }
+    func(fl_value_get_string(map_key), fl_value_get_string(map_value),
+         user_data);
+  }
+}
+
 static FlValue*
 core_tests_pigeon_test_all_nullable_types_without_recursion_to_list(
     CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self) {
   FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, self->a_nullable_bool != nullptr
-                                   ? fl_value_new_bool(*self->a_nullable_bool)
+  fl_value_append_take(values, self->has_a_nullable_bool
+                                   ? fl_value_new_bool(self->a_nullable_bool)
                                    : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int)
+  fl_value_append_take(values, self->has_a_nullable_int
+                                   ? fl_value_new_int(self->a_nullable_int)
                                    : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int64 != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int64)
+  fl_value_append_take(values, self->has_a_nullable_int64
+                                   ? fl_value_new_int(self->a_nullable_int64)
+                                   : fl_value_new_null());
+  fl_value_append_take(values, self->has_a_nullable_double
+                                   ? fl_value_new_float(self->a_nullable_double)
                                    : fl_value_new_null());
-  fl_value_append_take(values,
-                       self->a_nullable_double != nullptr
-                           ? fl_value_new_float(*self->a_nullable_double)
-                           : fl_value_new_null());
   fl_value_append_take(
       values, self->a_nullable_byte_array != nullptr
                   ? fl_value_new_uint8_list(self->a_nullable_byte_array,
@@ -1898,17 +2214,16 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_to_list(
                   : fl_value_new_null());
   fl_value_append_take(
       values,
-      self->a_nullable_enum != nullptr
+      self->has_a_nullable_enum
           ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(*self->a_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(self->a_nullable_enum), nullptr)
           : fl_value_new_null());
   fl_value_append_take(
       values,
-      self->another_nullable_enum != nullptr
+      self->has_another_nullable_enum
           ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*self->another_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(self->another_nullable_enum),
+                                nullptr)
           : fl_value_new_null());
   fl_value_append_take(values,
                        self->a_nullable_string != nullptr
@@ -2030,8 +2345,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_list(
   CoreTestsPigeonTestAnEnum a_nullable_enum_value;
   if (fl_value_get_type(value8) != FL_VALUE_TYPE_NULL) {
     a_nullable_enum_value = static_cast<CoreTestsPigeonTestAnEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value8)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value8)));
     a_nullable_enum = &a_nullable_enum_value;
   }
   FlValue* value9 = fl_value_get_list_value(values, 9);
@@ -2039,8 +2353,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_list(
   CoreTestsPigeonTestAnotherEnum another_nullable_enum_value;
   if (fl_value_get_type(value9) != FL_VALUE_TYPE_NULL) {
     another_nullable_enum_value = static_cast<CoreTestsPigeonTestAnotherEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value9)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value9)));
     another_nullable_enum = &another_nullable_enum_value;
   }
   FlValue* value10 = fl_value_get_list_value(values, 10);
@@ -2427,22 +2740,64 @@ const int core_tests_pigeon_test_all_nullable_types_without_recursion_type_id =
 const int core_tests_pigeon_test_all_classes_wrapper_type_id = 135;
 const int core_tests_pigeon_test_test_message_type_id = 136;
 
+// The standard codec type tag for a 32-bit integer, used to encode enum values.
+static const uint8_t core_tests_pigeon_test_message_codec_int32_type = 3;
+
+static gboolean core_tests_pigeon_test_message_codec_write_enum_index(
+    GByteArray* buffer, int index) {
+  uint8_t type = core_tests_pigeon_test_message_codec_int32_type;
+  g_byte_array_append(buffer, &type, sizeof(uint8_t));
+  int32_t value = index;
+  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
+                      sizeof(int32_t));
+  return TRUE;
+}
+
+static gboolean core_tests_pigeon_test_message_codec_read_enum_index(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, int* index,
+    GError** error) {
+  size_t data_length;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(buffer, &data_length));
+  if (*offset + sizeof(uint8_t) + sizeof(int32_t) <= data_length &&
+      data[*offset] == core_tests_pigeon_test_message_codec_int32_type) {
+    int32_t value;
+    memcpy(&value, data + *offset + sizeof(uint8_t), sizeof(int32_t));
+    *offset += sizeof(uint8_t) + sizeof(int32_t);
+    *index = value;
+    return TRUE;
+  }
+
+  g_autoptr(FlValue) value =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value == nullptr) {
+    return FALSE;
+  }
+  if (fl_value_get_type(value) != FL_VALUE_TYPE_INT) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
+                "Invalid data received for enum");
+    return FALSE;
+  }
+  *index = fl_value_get_int(value);
+  return TRUE;
+}
+
 static gboolean
 core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_an_enum(
-    FlStandardMessageCodec* codec, GByteArray* buffer, FlValue* value,
+    FlStandardMessageCodec* codec, GByteArray* buffer, int value,
     GError** error) {
   uint8_t type = core_tests_pigeon_test_an_enum_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  return fl_standard_message_codec_write_value(codec, buffer, value, error);
+  return core_tests_pigeon_test_message_codec_write_enum_index(buffer, value);
 }
 
 static gboolean
 core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_another_enum(
-    FlStandardMessageCodec* codec, GByteArray* buffer, FlValue* value,
+    FlStandardMessageCodec* codec, GByteArray* buffer, int value,
     GError** error) {
   uint8_t type = core_tests_pigeon_test_another_enum_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  return fl_standard_message_codec_write_value(codec, buffer, value, error);
+  return core_tests_pigeon_test_message_codec_write_enum_index(buffer, value);
 }
 
 static gboolean
@@ -2520,15 +2875,11 @@ static gboolean core_tests_pigeon_test_message_codec_write_value(
     switch (fl_value_get_custom_type(value)) {
       case core_tests_pigeon_test_an_enum_type_id:
         return core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_an_enum(
-            codec, buffer,
-            reinterpret_cast<FlValue*>(
-                const_cast<gpointer>(fl_value_get_custom_value(value))),
+            codec, buffer, GPOINTER_TO_INT(fl_value_get_custom_value(value)),
             error);
       case core_tests_pigeon_test_another_enum_type_id:
         return core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_another_enum(
-            codec, buffer,
-            reinterpret_cast<FlValue*>(
-                const_cast<gpointer>(fl_value_get_custom_value(value))),
+            codec, buffer, GPOINTER_TO_INT(fl_value_get_custom_value(value)),
             error);
       case core_tests_pigeon_test_unused_class_type_id:
         return core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_unused_class(
@@ -2578,20 +2929,28 @@ static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_an_enum(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  return fl_value_new_custom(
-      core_tests_pigeon_test_an_enum_type_id,
-      fl_standard_message_codec_read_value(codec, buffer, offset, error),
-      (GDestroyNotify)fl_value_unref);
+  int index;
+  if (!core_tests_pigeon_test_message_codec_read_enum_index(
+          codec, buffer, offset, &index, error)) {
+    return nullptr;
+  }
+
+  return fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
+                             GINT_TO_POINTER(index), nullptr);
 }
 
 static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_another_enum(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  return fl_value_new_custom(
-      core_tests_pigeon_test_another_enum_type_id,
-      fl_standard_message_codec_read_value(codec, buffer, offset, error),
-      (GDestroyNotify)fl_value_unref);
+  int index;
+  if (!core_tests_pigeon_test_message_codec_read_enum_index(
+          codec, buffer, offset, &index, error)) {
+    return nullptr;
+  }
+
+  return fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
+                             GINT_TO_POINTER(index), nullptr);
 }
 
 static FlValue*
@@ -4551,8 +4910,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_enum_response_new(
   self->value = fl_value_new_list();
   fl_value_append_take(
       self->value, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                       fl_value_new_int(return_value),
-                                       (GDestroyNotify)fl_value_unref));
+                                       GINT_TO_POINTER(return_value), nullptr));
   return self;
 }
 
@@ -4619,8 +4977,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_enum_response_new(
   fl_value_append_take(
       self->value,
       fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                          fl_value_new_int(return_value),
-                          (GDestroyNotify)fl_value_unref));
+                          GINT_TO_POINTER(return_value), nullptr));
   return self;
 }
 
@@ -6682,8 +7039,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_nullable_enum_response_new
       self->value,
       return_value != nullptr
           ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(*return_value),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(*return_value), nullptr)
           : fl_value_new_null());
   return self;
 }
@@ -6755,8 +7111,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_nullable_enum_resp
       self->value,
       return_value != nullptr
           ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*return_value),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(*return_value), nullptr)
           : fl_value_new_null());
   return self;
 }
@@ -8031,8 +8386,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_async_enum_response_new(
   self->value = fl_value_new_list();
   fl_value_append_take(
       self->value, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                       fl_value_new_int(return_value),
-                                       (GDestroyNotify)fl_value_unref));
+                                       GINT_TO_POINTER(return_value), nullptr));
   return self;
 }
 
@@ -8107,8 +8461,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_async_enum_respons
   fl_value_append_take(
       self->value,
       fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                          fl_value_new_int(return_value),
-                          (GDestroyNotify)fl_value_unref));
+                          GINT_TO_POINTER(return_value), nullptr));
   return self;
 }
 
@@ -9686,8 +10039,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_async_nullable_enum_respon
       self->value,
       return_value != nullptr
           ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(*return_value),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(*return_value), nullptr)
           : fl_value_new_null());
   return self;
 }
@@ -9767,8 +10119,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_async_nullable_enu
       self->value,
       return_value != nullptr
           ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*return_value),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(*return_value), nullptr)
           : fl_value_new_null());
   return self;
 }
@@ -11982,8 +12333,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_enum_response
   self->value = fl_value_new_list();
   fl_value_append_take(
       self->value, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                       fl_value_new_int(return_value),
-                                       (GDestroyNotify)fl_value_unref));
+                                       GINT_TO_POINTER(return_value), nullptr));
   return self;
 }
 
@@ -12059,8 +12409,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_another_enum_
   fl_value_append_take(
       self->value,
       fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                          fl_value_new_int(return_value),
-                          (GDestroyNotify)fl_value_unref));
+                          GINT_TO_POINTER(return_value), nullptr));
   return self;
 }
 
@@ -13596,8 +13945,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_nullable_enum
       self->value,
       return_value != nullptr
           ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(*return_value),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(*return_value), nullptr)
           : fl_value_new_null());
   return self;
 }
@@ -13677,8 +14025,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_another_nulla
       self->value,
       return_value != nullptr
           ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*return_value),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(*return_value), nullptr)
           : fl_value_new_null());
   return self;
 }
@@ -14583,8 +14930,7 @@ static void core_tests_pigeon_test_host_integration_core_api_echo_enum_cb(
 
   FlValue* value0 = fl_value_get_list_value(message_, 0);
   CoreTestsPigeonTestAnEnum an_enum = static_cast<CoreTestsPigeonTestAnEnum>(
-      fl_value_get_int(reinterpret_cast<FlValue*>(
-          const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+      GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiEchoEnumResponse)
       response = self->vtable->echo_enum(an_enum, self->user_data);
   if (response == nullptr) {
@@ -14615,8 +14961,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_enum_cb(
   FlValue* value0 = fl_value_get_list_value(message_, 0);
   CoreTestsPigeonTestAnotherEnum another_enum =
       static_cast<CoreTestsPigeonTestAnotherEnum>(
-          fl_value_get_int(reinterpret_cast<FlValue*>(
-              const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+          GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiEchoAnotherEnumResponse)
       response = self->vtable->echo_another_enum(another_enum, self->user_data);
   if (response == nullptr) {
@@ -15610,8 +15955,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_nullable_enum_cb(
   CoreTestsPigeonTestAnEnum an_enum_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     an_enum_value = static_cast<CoreTestsPigeonTestAnEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
     an_enum = &an_enum_value;
   }
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiEchoNullableEnumResponse)
@@ -15647,8 +15991,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_nullable_enum_cb(
   CoreTestsPigeonTestAnotherEnum another_enum_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     another_enum_value = static_cast<CoreTestsPigeonTestAnotherEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
     another_enum = &another_enum_value;
   }
   g_autoptr(
@@ -16035,8 +16378,7 @@ static void core_tests_pigeon_test_host_integration_core_api_echo_async_enum_cb(
 
   FlValue* value0 = fl_value_get_list_value(message_, 0);
   CoreTestsPigeonTestAnEnum an_enum = static_cast<CoreTestsPigeonTestAnEnum>(
-      fl_value_get_int(reinterpret_cast<FlValue*>(
-          const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+      GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
       core_tests_pigeon_test_host_integration_core_api_response_handle_new(
           channel, response_handle);
@@ -16058,8 +16400,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_async_enum_cb(
   FlValue* value0 = fl_value_get_list_value(message_, 0);
   CoreTestsPigeonTestAnotherEnum another_enum =
       static_cast<CoreTestsPigeonTestAnotherEnum>(
-          fl_value_get_int(reinterpret_cast<FlValue*>(
-              const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+          GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
       core_tests_pigeon_test_host_integration_core_api_response_handle_new(
           channel, response_handle);
@@ -16505,8 +16846,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_async_nullable_enum_cb(
   CoreTestsPigeonTestAnEnum an_enum_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     an_enum_value = static_cast<CoreTestsPigeonTestAnEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
     an_enum = &an_enum_value;
   }
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
@@ -16532,8 +16872,7 @@ core_tests_pigeon_test_host_integration_core_api_echo_another_async_nullable_enu
   CoreTestsPigeonTestAnotherEnum another_enum_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     another_enum_value = static_cast<CoreTestsPigeonTestAnotherEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
     another_enum = &another_enum_value;
   }
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
@@ -17201,8 +17540,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_enum_cb(
 
   FlValue* value0 = fl_value_get_list_value(message_, 0);
   CoreTestsPigeonTestAnEnum an_enum = static_cast<CoreTestsPigeonTestAnEnum>(
-      fl_value_get_int(reinterpret_cast<FlValue*>(
-          const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+      GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
       core_tests_pigeon_test_host_integration_core_api_response_handle_new(
           channel, response_handle);
@@ -17224,8 +17562,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_another_enum_
   FlValue* value0 = fl_value_get_list_value(message_, 0);
   CoreTestsPigeonTestAnotherEnum another_enum =
       static_cast<CoreTestsPigeonTestAnotherEnum>(
-          fl_value_get_int(reinterpret_cast<FlValue*>(
-              const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+          GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
       core_tests_pigeon_test_host_integration_core_api_response_handle_new(
           channel, response_handle);
@@ -17662,8 +17999,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_nullable_enum
   CoreTestsPigeonTestAnEnum an_enum_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     an_enum_value = static_cast<CoreTestsPigeonTestAnEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
     an_enum = &an_enum_value;
   }
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
@@ -17690,8 +18026,7 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_another_nulla
   CoreTestsPigeonTestAnotherEnum another_enum_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     another_enum_value = static_cast<CoreTestsPigeonTestAnotherEnum>(
-        fl_value_get_int(reinterpret_cast<FlValue*>(
-            const_cast<gpointer>(fl_value_get_custom_value(value0)))));
+        GPOINTER_TO_INT(fl_value_get_custom_value(value0)));
     another_enum = &another_enum_value;
   }
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
@@ -24259,6 +24594,15 @@ static void core_tests_pigeon_test_flutter_integration_core_api_dispose(
     GObject* object) {
   CoreTestsPigeonTestFlutterIntegrationCoreApi* self =
       CORE_TESTS_PIGEON_TEST_FLUTTER_INTEGRATION_CORE_API(object);
+  // Forget the @Synced values sent by this instance, since a later messenger
+  // may be allocated at the same address.
+  if (self->messenger != nullptr) {
+    g_autofree gchar* echo_all_types_channel_key = g_strdup_printf(
+        "%p:dev.flutter.pigeon.pigeon_integration_tests."
+        "FlutterIntegrationCoreApi.echoAllTypes%s",
+        self->messenger, self->suffix);
+    core_tests_pigeon_test_clear_synced_snapshots(echo_all_types_channel_key);
+  }
   g_clear_object(&self->messenger);
   g_clear_pointer(&self->suffix, g_free);
   G_OBJECT_CLASS(
@@ -24852,35 +25196,45 @@ core_tests_pigeon_test_flutter_integration_core_api_echo_all_types_response_get_
       fl_value_get_custom_value_object(self->return_value));
 }
 
-static void
-core_tests_pigeon_test_flutter_integration_core_api_echo_all_types_cb(
-    GObject* object, GAsyncResult* result, gpointer user_data) {
-  GTask* task = G_TASK(user_data);
-  g_task_return_pointer(task, result, g_object_unref);
-}
-
 void core_tests_pigeon_test_flutter_integration_core_api_echo_all_types(
     CoreTestsPigeonTestFlutterIntegrationCoreApi* self,
     CoreTestsPigeonTestAllTypes* everything, GCancellable* cancellable,
     GAsyncReadyCallback callback, gpointer user_data) {
-  g_autoptr(FlValue) args = fl_value_new_list();
-  fl_value_append_take(
-      args, fl_value_new_custom_object(core_tests_pigeon_test_all_types_type_id,
-                                       G_OBJECT(everything)));
   g_autofree gchar* channel_name = g_strdup_printf(
       "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
       "echoAllTypes%s",
       self->suffix);
+  g_autofree gchar* channel_key =
+      g_strdup_printf("%p:%s", self->messenger, channel_name);
+  g_autoptr(FlValue) full_args = fl_value_new_list();
+  g_autoptr(FlValue) args = fl_value_new_list();
+  FlValue* everything_patch = core_tests_pigeon_test_make_synced_patch(
+      channel_key, 0, core_tests_pigeon_test_all_types_to_list(everything));
+  fl_value_append_take(
+      full_args,
+      fl_value_new_custom_object(core_tests_pigeon_test_all_types_type_id,
+                                 G_OBJECT(everything)));
+  fl_value_append_take(
+      args, everything_patch != nullptr
+                ? everything_patch
+                : fl_value_ref(fl_value_get_list_value(full_args, 0)));
   g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
       core_tests_pigeon_test_message_codec_new();
   FlBasicMessageChannel* channel = fl_basic_message_channel_new(
       self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
-  fl_basic_message_channel_send(
-      channel, args, cancellable,
-      core_tests_pigeon_test_flutter_integration_core_api_echo_all_types_cb,
-      task);
+  CoreTestsPigeonTestSyncedCall* call =
+      g_new0(CoreTestsPigeonTestSyncedCall, 1);
+  call->channel = channel;
+  call->channel_key = g_steal_pointer(&channel_key);
+  if (everything_patch != nullptr) {
+    call->full_message = fl_value_ref(full_args);
+  }
+  g_task_set_task_data(
+      task, call,
+      reinterpret_cast<GDestroyNotify>(core_tests_pigeon_test_synced_call_free));
+  fl_basic_message_channel_send(channel, args, cancellable,
+                                core_tests_pigeon_test_synced_call_cb, task);
 }
 
 CoreTestsPigeonTestFlutterIntegrationCoreApiEchoAllTypesResponse*
@@ -24888,11 +25242,8 @@ core_tests_pigeon_test_flutter_integration_core_api_echo_all_types_finish(
     CoreTestsPigeonTestFlutterIntegrationCoreApi* self, GAsyncResult* result,
     GError** error) {
   g_autoptr(GTask) task = G_TASK(result);
-  GAsyncResult* r = G_ASYNC_RESULT(g_task_propagate_pointer(task, nullptr));
-  FlBasicMessageChannel* channel =
-      FL_BASIC_MESSAGE_CHANNEL(g_task_get_task_data(task));
   g_autoptr(FlValue) response =
-      fl_basic_message_channel_send_finish(channel, r, error);
+      static_cast<FlValue*>(g_task_propagate_pointer(task, error));
   if (response == nullptr) {
     return nullptr;
   }
@@ -28854,8 +29205,7 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_enum(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(an_enum),
-                                (GDestroyNotify)fl_value_unref));
+                                GINT_TO_POINTER(an_enum), nullptr));
   g_autofree gchar* channel_name = g_strdup_printf(
       "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
       "echoEnum%s",
@@ -29021,8 +29371,7 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_another_enum(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(another_enum),
-                                (GDestroyNotify)fl_value_unref));
+                                GINT_TO_POINTER(another_enum), nullptr));
   g_autofree gchar* channel_name = g_strdup_printf(
       "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
       "echoAnotherEnum%s",
@@ -32487,8 +32836,7 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_enum(
   fl_value_append_take(
       args, an_enum != nullptr
                 ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                      fl_value_new_int(*an_enum),
-                                      (GDestroyNotify)fl_value_unref)
+                                      GINT_TO_POINTER(*an_enum), nullptr)
                 : fl_value_new_null());
   g_autofree gchar* channel_name = g_strdup_printf(
       "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
@@ -32669,8 +33017,7 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_another_nullable_e
       args,
       another_enum != nullptr
           ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*another_enum),
-                                (GDestroyNotify)fl_value_unref)
+                                GINT_TO_POINTER(*another_enum), nullptr)
           : fl_value_new_null());
   g_autofree gchar* channel_name = g_strdup_printf(
       "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
@@ -445,6 +445,50 @@ FlValue* core_tests_pigeon_test_all_types_get_list_map(
 FlValue* core_tests_pigeon_test_all_types_get_map_map(
     CoreTestsPigeonTestAllTypes* object);
 
+/**
+ * CoreTestsPigeonTestAllTypesStringMapFunc:
+ * @key: the key of the entry.
+ * @value: the value of the entry.
+ * @user_data: user data passed to
+ * core_tests_pigeon_test_all_types_foreach_string_map().
+ *
+ * The function called for each entry in the stringMap field of a
+ * #CoreTestsPigeonTestAllTypes.
+ */
+typedef void (*CoreTestsPigeonTestAllTypesStringMapFunc)(
+    const gchar* key, const gchar* value, gpointer user_data);
+
+/**
+ * core_tests_pigeon_test_all_types_lookup_string_map
+ * @object: a #CoreTestsPigeonTestAllTypes.
+ * @key: the key to look up.
+ * @value: (out) (optional): location to write the value for @key.
+ *
+ * Looks up the value for @key in the stringMap field of @object. If
+ * the map has more than one entry for @key the first is used, as
+ * fl_value_lookup_string() does. An index of the map is built on the
+ * first call, and rebuilt if entries are added to the map, so later
+ * lookups do not need to scan the map.
+ *
+ * Returns: %TRUE if @key is present with a non-null value.
+ */
+gboolean core_tests_pigeon_test_all_types_lookup_string_map(
+    CoreTestsPigeonTestAllTypes* object, const gchar* key, const gchar** value);
+
+/**
+ * core_tests_pigeon_test_all_types_foreach_string_map
+ * @object: a #CoreTestsPigeonTestAllTypes.
+ * @func: (scope call): the function to call for each entry.
+ * @user_data: (closure): user data to pass to @func.
+ *
+ * Calls @func for each entry in the stringMap field of @object, in
+ * map order. Entries with a null value are skipped.
+ */
+void core_tests_pigeon_test_all_types_foreach_string_map(
+    CoreTestsPigeonTestAllTypes* object,
+    CoreTestsPigeonTestAllTypesStringMapFunc func,
+    gpointer user_data);
+
 /**
  * CoreTestsPigeonTestAllNullableTypes:
  *
@@ -868,6 +912,52 @@ FlValue* core_tests_pigeon_test_all_nullable_types_get_map_map(
 FlValue* core_tests_pigeon_test_all_nullable_types_get_recursive_class_map(
     CoreTestsPigeonTestAllNullableTypes* object);
 
+/**
+ * CoreTestsPigeonTestAllNullableTypesStringMapFunc:
+ * @key: the key of the entry.
+ * @value: the value of the entry.
+ * @user_data: user data passed to
+ * core_tests_pigeon_test_all_nullable_types_foreach_string_map().
+ *
+ * The function called for each entry in the stringMap field of a
+ * #CoreTestsPigeonTestAllNullableTypes.
+ */
+typedef void (*CoreTestsPigeonTestAllNullableTypesStringMapFunc)(
+    const gchar* key, const gchar* value, gpointer user_data);
+
+/**
+ * core_tests_pigeon_test_all_nullable_types_lookup_string_map
+ * @object: a #CoreTestsPigeonTestAllNullableTypes.
+ * @key: the key to look up.
+ * @value: (out) (optional): location to write the value for @key.
+ *
+ * Looks up the value for @key in the stringMap field of @object. If
+ * the map has more than one entry for @key the first is used, as
+ * fl_value_lookup_string() does. An index of the map is built on the
+ * first call, and rebuilt if entries are added to the map, so later
+ * lookups do not need to scan the map.
+ *
+ * Returns: %TRUE if @key is present with a non-null value.
+ */
+gboolean core_tests_pigeon_test_all_nullable_types_lookup_string_map(
+    CoreTestsPigeonTestAllNullableTypes* object,
+    const gchar* key,
+    const gchar** value);
+
+/**
+ * core_tests_pigeon_test_all_nullable_types_foreach_string_map
+ * @object: a #CoreTestsPigeonTestAllNullableTypes.
+ * @func: (scope call): the function to call for each entry.
+ * @user_data: (closure): user data to pass to @func.
+ *
+ * Calls @func for each entry in the stringMap field of @object, in
+ * map order. Entries with a null value are skipped.
+ */
+void core_tests_pigeon_test_all_nullable_types_foreach_string_map(
+    CoreTestsPigeonTestAllNullableTypes* object,
+    CoreTestsPigeonTestAllNullableTypesStringMapFunc func,
+    gpointer user_data);
+
 /**
  * CoreTestsPigeonTestAllNullableTypesWithoutRecursion:
  *
@@ -1279,6 +1369,54 @@ FlValue*
 core_tests_pigeon_test_all_nullable_types_without_recursion_get_map_map(
     CoreTestsPigeonTestAllNullableTypesWithoutRecursion* object);
 
+/**
+ * CoreTestsPigeonTestAllNullableTypesWithoutRecursionStringMapFunc:
+ * @key: the key of the entry.
+ * @value: the value of the entry.
+ * @user_data: user data passed to
+ * core_tests_pigeon_test_all_nullable_types_without_recursion_foreach_string_map().
+ *
+ * The function called for each entry in the stringMap field of a
+ * #CoreTestsPigeonTestAllNullableTypesWithoutRecursion.
+ */
+typedef void (*CoreTestsPigeonTestAllNullableTypesWithoutRecursionStringMapFunc)(
+    const gchar* key, const gchar* value, gpointer user_data);
+
+/**
+ * core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map
+ * @object: a #CoreTestsPigeonTestAllNullableTypesWithoutRecursion.
+ * @key: the key to look up.
+ * @value: (out) (optional): location to write the value for @key.
+ *
+ * Looks up the value for @key in the stringMap field of @object. If
+ * the map has more than one entry for @key the first is used, as
+ * fl_value_lookup_string() does. An index of the map is built on the
+ * first call, and rebuilt if entries are added to the map, so later
+ * lookups do not need to scan the map.
+ *
+ * Returns: %TRUE if @key is present with a non-null value.
+ */
+gboolean
+core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursion* object,
+    const gchar* key,
+    const gchar** value);
+
+/**
+ * core_tests_pigeon_test_all_nullable_types_without_recursion_foreach_string_map
+ * @object: a #CoreTestsPigeonTestAllNullableTypesWithoutRecursion.
+ * @func: (scope call): the function to call for each entry.
+ * @user_data: (closure): user data to pass to @func.
+ *
+ * Calls @func for each entry in the stringMap field of @object, in
+ * map order. Entries with a null value are skipped.
+ */
+void
+core_tests_pigeon_test_all_nullable_types_without_recursion_foreach_string_map(
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursion* object,
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursionStringMapFunc func,
+    gpointer user_data);
+
 /**
  * CoreTestsPigeonTestAllClassesWrapper:
  *
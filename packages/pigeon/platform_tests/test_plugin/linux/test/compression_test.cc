@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "pigeon/compression_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+// The codec type tag of a compressed message.
+static const uint8_t kCompressedMessageType = 128;
+
+static const gchar* kEchoStringChannel =
+    "dev.flutter.pigeon.pigeon_integration_tests.CompressedHostApi.echoString";
+
+static CompressionTestsPigeonTestCompressedHostApiEchoStringResponse*
+echo_string(const gchar* value, gpointer user_data) {
+  return compression_tests_pigeon_test_compressed_host_api_echo_string_response_new(
+      value);
+}
+
+static CompressionTestsPigeonTestCompressedHostApiVTable vtable = {
+    .echo_string = echo_string};
+
+static void reply_cb(GBytes* reply, gpointer user_data) {
+  std::vector<uint8_t>* result = static_cast<std::vector<uint8_t>*>(user_data);
+  size_t length;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(reply, &length));
+  result->assign(data, data + length);
+}
+
+// Returns the encoded message Dart sends to echo |value|, which is also the
+// uncompressed encoding of the reply.
+static std::vector<uint8_t> encode_echo(FlMessageCodec* codec,
+                                        const gchar* value) {
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_string(value));
+  g_autoptr(GBytes) encoded =
+      fl_message_codec_encode_message(codec, message, nullptr);
+  size_t length;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(encoded, &length));
+  return std::vector<uint8_t>(data, data + length);
+}
+
+// Returns the reply of the host API to |message|.
+static std::vector<uint8_t> send_echo(FakeHostMessenger* messenger,
+                                      const std::vector<uint8_t>& message) {
+  g_autoptr(GBytes) bytes = g_bytes_new(message.data(), message.size());
+  std::vector<uint8_t> result;
+  fake_host_messenger_send_host_binary_message(messenger, kEchoStringChannel,
+                                               bytes, reply_cb, &result);
+  return result;
+}
+
+// Reads a size written by the standard codec at |*position|.
+static size_t read_size(const std::vector<uint8_t>& data, size_t* position) {
+  uint8_t byte = data[(*position)++];
+  if (byte < 254) {
+    return byte;
+  }
+  if (byte == 254) {
+    uint16_t value;
+    memcpy(&value, &data[*position], sizeof(value));
+    *position += sizeof(value);
+    return value;
+  }
+  uint32_t value;
+  memcpy(&value, &data[*position], sizeof(value));
+  *position += sizeof(value);
+  return value;
+}
+
+// Reads an LZ4 length extension at |*position|, adding it to |value|.
+static size_t read_lz4_length(const uint8_t* input, size_t* position,
+                              size_t value) {
+  uint8_t byte;
+  do {
+    byte = input[(*position)++];
+    value += byte;
+  } while (byte == 255);
+  return value;
+}
+
+// Decompresses |length| bytes of |input| from the LZ4 block format.
+static std::vector<uint8_t> decompress_lz4(const uint8_t* input,
+                                           size_t length) {
+  std::vector<uint8_t> output;
+  size_t position = 0;
+  while (position < length) {
+    uint8_t token = input[position++];
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      literal_length = read_lz4_length(input, &position, literal_length);
+    }
+    output.insert(output.end(), input + position,
+                  input + position + literal_length);
+    position += literal_length;
+    if (position >= length) {
+      break;
+    }
+    size_t offset = input[position] | (input[position + 1] << 8);
+    position += 2;
+    size_t match_length = (token & 0x0f) + 4;
+    if (match_length == 19) {
+      match_length = read_lz4_length(input, &position, match_length);
+    }
+    for (size_t i = 0; i < match_length; i++) {
+      output.push_back(output[output.size() - offset]);
+    }
+  }
+  return output;
+}
+
+TEST(Compression, SmallReplyIsNotCompressed) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  compression_tests_pigeon_test_compressed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, nullptr, nullptr);
+
+  std::vector<uint8_t> message = encode_echo(FL_MESSAGE_CODEC(codec), "hello");
+  EXPECT_EQ(send_echo(messenger, message), message);
+}
+
+TEST(Compression, LargeReplyIsCompressed) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  compression_tests_pigeon_test_compressed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, nullptr, nullptr);
+
+  std::string value(1000, 'a');
+  std::vector<uint8_t> message =
+      encode_echo(FL_MESSAGE_CODEC(codec), value.c_str());
+  std::vector<uint8_t> reply = send_echo(messenger, message);
+
+  ASSERT_FALSE(reply.empty());
+  EXPECT_EQ(reply[0], kCompressedMessageType);
+  size_t position = 1;
+  EXPECT_EQ(read_size(reply, &position), message.size());
+  size_t compressed_size = read_size(reply, &position);
+  ASSERT_EQ(position + compressed_size, reply.size());
+  EXPECT_LT(reply.size(), message.size());
+  EXPECT_EQ(decompress_lz4(&reply[position], compressed_size), message);
+}
+
+TEST(Compression, IncompressibleReplyIsNotCompressed) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  compression_tests_pigeon_test_compressed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, nullptr, nullptr);
+
+  // Longer than the threshold, but without any repeated sequences.
+  std::string value;
+  for (char c = '!'; c <= '~'; c++) {
+    value.push_back(c);
+  }
+  std::vector<uint8_t> message =
+      encode_echo(FL_MESSAGE_CODEC(codec), value.c_str());
+  EXPECT_EQ(send_echo(messenger, message), message);
+}
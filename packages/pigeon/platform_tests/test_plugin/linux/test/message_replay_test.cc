@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <glib/gstdio.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "pigeon/primitive.gen.h"
+#include "test/utils/fake_host_messenger.h"
+#include "test/utils/message_replayer.h"
+#include "test/utils/recording_messenger.h"
+
+static const gchar* kAnIntChannel =
+    "dev.flutter.pigeon.pigeon_integration_tests.PrimitiveHostApi.anInt";
+static const gchar* kAStringChannel =
+    "dev.flutter.pigeon.pigeon_integration_tests.PrimitiveHostApi.aString";
+
+static int an_int_calls = 0;
+
+static PrimitivePigeonTestPrimitiveHostApiAnIntResponse* an_int(
+    int64_t value, gpointer user_data) {
+  an_int_calls++;
+  return primitive_pigeon_test_primitive_host_api_an_int_response_new(value);
+}
+
+static PrimitivePigeonTestPrimitiveHostApiAStringResponse* a_string(
+    const gchar* value, gpointer user_data) {
+  return primitive_pigeon_test_primitive_host_api_a_string_response_new(value);
+}
+
+static PrimitivePigeonTestPrimitiveHostApiVTable vtable = {
+    .an_int = an_int, .a_string = a_string};
+
+static void ignore_reply_cb(FlValue* reply, gpointer user_data) {}
+
+// Records calls to a host API, then returns the path to the recording.
+static gchar* record_messages(const gchar* dir) {
+  g_autofree gchar* path = g_build_filename(dir, "messages.bin", nullptr);
+
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(RecordingMessenger) recorder =
+      recording_messenger_new(FL_BINARY_MESSENGER(messenger), path, &error);
+  EXPECT_NE(recorder, nullptr);
+  primitive_pigeon_test_primitive_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(recorder), nullptr, &vtable, nullptr, nullptr);
+
+  for (int i = 0; i < 3; i++) {
+    g_autoptr(FlValue) message = fl_value_new_list();
+    fl_value_append_take(message, fl_value_new_int(i));
+    fake_host_messenger_send_host_message(messenger, kAnIntChannel, message,
+                                          ignore_reply_cb, nullptr);
+  }
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_string("hello"));
+  fake_host_messenger_send_host_message(messenger, kAStringChannel, message,
+                                        ignore_reply_cb, nullptr);
+
+  // Remove the handlers so the recording is complete once the recorder is
+  // released.
+  primitive_pigeon_test_primitive_host_api_clear_method_handlers(
+      FL_BINARY_MESSENGER(recorder), nullptr);
+
+  return static_cast<gchar*>(g_steal_pointer(&path));
+}
+
+TEST(MessageReplay, ReplaysRecordedMessages) {
+  g_autoptr(GError) error = nullptr;
+  g_autofree gchar* dir = g_dir_make_tmp("pigeon_replay_XXXXXX", &error);
+  ASSERT_NE(dir, nullptr);
+  g_autofree gchar* path = record_messages(dir);
+
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  primitive_pigeon_test_primitive_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, nullptr, nullptr);
+  g_autoptr(MessageReplayer) replayer =
+      message_replayer_new(messenger, path, &error);
+  ASSERT_NE(replayer, nullptr);
+
+  an_int_calls = 0;
+  EXPECT_TRUE(message_replayer_run(replayer, MESSAGE_REPLAYER_SPEED_MAXIMUM,
+                                   1000, &error));
+  EXPECT_EQ(an_int_calls, 3);
+
+  MessageReplayerLatency latency;
+  ASSERT_TRUE(message_replayer_get_latency(replayer, kAnIntChannel, &latency));
+  EXPECT_EQ(latency.count, 3u);
+  EXPECT_LE(latency.min, latency.median);
+  EXPECT_LE(latency.median, latency.max);
+  ASSERT_TRUE(
+      message_replayer_get_latency(replayer, kAStringChannel, &latency));
+  EXPECT_EQ(latency.count, 1u);
+
+  g_autofree gchar* report = message_replayer_get_report(replayer);
+  EXPECT_NE(strstr(report, kAnIntChannel), nullptr);
+
+  g_remove(path);
+  g_rmdir(dir);
+}
+
+TEST(MessageReplay, FailsWithoutHandler) {
+  g_autoptr(GError) error = nullptr;
+  g_autofree gchar* dir = g_dir_make_tmp("pigeon_replay_XXXXXX", &error);
+  ASSERT_NE(dir, nullptr);
+  g_autofree gchar* path = record_messages(dir);
+
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  g_autoptr(MessageReplayer) replayer =
+      message_replayer_new(messenger, path, &error);
+  ASSERT_NE(replayer, nullptr);
+
+  EXPECT_FALSE(message_replayer_run(replayer, MESSAGE_REPLAYER_SPEED_MAXIMUM,
+                                    1000, &error));
+  EXPECT_TRUE(g_error_matches(error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND));
+
+  g_remove(path);
+  g_rmdir(dir);
+}
@@ -61,3 +61,27 @@ TEST(NullFields, BuildReplyWithNulls) {
   EXPECT_EQ(null_fields_pigeon_test_null_fields_search_reply_get_type_(reply),
             nullptr);
 }
+
+TEST(NullFields, NullablePrimitiveStoredInline) {
+  NullFieldsPigeonTestNullFieldsSearchReplyType type =
+      PIGEON_INTEGRATION_TESTS_NULL_FIELDS_SEARCH_REPLY_TYPE_FAILURE;
+  g_autoptr(NullFieldsPigeonTestNullFieldsSearchReply) reply =
+      null_fields_pigeon_test_null_fields_search_reply_new(
+          nullptr, nullptr, nullptr, nullptr, &type);
+
+  // The value must be copied into the object itself rather than into a
+  // separate heap allocation, so the returned pointer lies within the
+  // instance.
+  NullFieldsPigeonTestNullFieldsSearchReplyType* value =
+      null_fields_pigeon_test_null_fields_search_reply_get_type_(reply);
+  GTypeQuery query;
+  g_type_query(G_OBJECT_TYPE(reply), &query);
+  const guint8* start = reinterpret_cast<const guint8*>(reply);
+  const guint8* value_start = reinterpret_cast<const guint8*>(value);
+  ASSERT_NE(value, nullptr);
+  EXPECT_NE(value, &type);
+  EXPECT_GE(value_start, start);
+  EXPECT_LE(value_start + sizeof(*value), start + query.instance_size);
+  EXPECT_EQ(*value,
+            PIGEON_INTEGRATION_TESTS_NULL_FIELDS_SEARCH_REPLY_TYPE_FAILURE);
+}
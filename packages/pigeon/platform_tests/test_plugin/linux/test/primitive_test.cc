@@ -213,4 +213,67 @@ TEST(Primitive, HostMap) {
                "bar");
 }
 
+static void an_int_with_result(
+    int64_t value, PrimitivePigeonTestPrimitiveHostApiAnIntResult* result,
+    gpointer user_data) {
+  if (value < 0) {
+    result->error_code = "negative";
+    result->error_message = "Value must not be negative";
+    result->error_details = fl_value_new_int(value);
+    return;
+  }
+  result->return_value = value;
+}
+
+static PrimitivePigeonTestPrimitiveHostApiVTable result_vtable = {
+    .an_int_with_result = an_int_with_result};
+
+TEST(Primitive, HostIntWithResult) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  primitive_pigeon_test_primitive_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &result_vtable, nullptr,
+      nullptr);
+
+  int64_t result = 0;
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(7));
+  fake_host_messenger_send_host_message(
+      messenger,
+      "dev.flutter.pigeon.pigeon_integration_tests.PrimitiveHostApi.anInt",
+      message, an_int_reply_cb, &result);
+
+  EXPECT_EQ(result, 7);
+}
+
+static void error_reply_cb(FlValue* reply, gpointer user_data) {
+  FlValue** result = reinterpret_cast<FlValue**>(user_data);
+  *result = fl_value_ref(reply);
+}
+
+TEST(Primitive, HostIntWithResultError) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  primitive_pigeon_test_primitive_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &result_vtable, nullptr,
+      nullptr);
+
+  g_autoptr(FlValue) result = nullptr;
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(-1));
+  fake_host_messenger_send_host_message(
+      messenger,
+      "dev.flutter.pigeon.pigeon_integration_tests.PrimitiveHostApi.anInt",
+      message, error_reply_cb, &result);
+
+  ASSERT_EQ(fl_value_get_length(result), 3);
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_list_value(result, 0)),
+               "negative");
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_list_value(result, 1)),
+               "Value must not be negative");
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(result, 2)), -1);
+}
+
 // TODO(stuartmorgan): Add FlutterApi versions of the tests.
@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+
+// Returns an object with |string_map| as its stringMap field.
+static CoreTestsPigeonTestAllNullableTypesWithoutRecursion* new_with_string_map(
+    FlValue* string_map) {
+  return core_tests_pigeon_test_all_nullable_types_without_recursion_new(
+      nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, 0, nullptr, 0,
+      nullptr, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, string_map,
+      nullptr, nullptr, nullptr, nullptr, nullptr);
+}
+
+static void collect_entry(const gchar* key, const gchar* value,
+                          gpointer user_data) {
+  std::vector<std::pair<std::string, std::string>>* entries =
+      static_cast<std::vector<std::pair<std::string, std::string>>*>(
+          user_data);
+  entries->push_back(std::make_pair(key, value));
+}
+
+TEST(StringMapLookup, LookupValue) {
+  g_autoptr(FlValue) map = fl_value_new_map();
+  fl_value_set_string_take(map, "a", fl_value_new_string("1"));
+  fl_value_set_string_take(map, "b", fl_value_new_string("2"));
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) object =
+      new_with_string_map(map);
+
+  const gchar* value = nullptr;
+  EXPECT_TRUE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "b", &value));
+  EXPECT_STREQ(value, "2");
+  EXPECT_TRUE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "a", nullptr));
+  EXPECT_FALSE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "c", &value));
+}
+
+TEST(StringMapLookup, NullValueIsNotPresent) {
+  g_autoptr(FlValue) map = fl_value_new_map();
+  fl_value_set_string_take(map, "a", fl_value_new_null());
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) object =
+      new_with_string_map(map);
+
+  EXPECT_FALSE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "a", nullptr));
+}
+
+TEST(StringMapLookup, NullMap) {
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) object =
+      new_with_string_map(nullptr);
+
+  EXPECT_FALSE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "a", nullptr));
+  std::vector<std::pair<std::string, std::string>> entries;
+  core_tests_pigeon_test_all_nullable_types_without_recursion_foreach_string_map(
+      object, collect_entry, &entries);
+  EXPECT_TRUE(entries.empty());
+}
+
+TEST(StringMapLookup, LookupAddedEntry) {
+  g_autoptr(FlValue) map = fl_value_new_map();
+  fl_value_set_string_take(map, "a", fl_value_new_string("1"));
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) object =
+      new_with_string_map(map);
+
+  // Builds the index.
+  EXPECT_FALSE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "b", nullptr));
+
+  fl_value_set_string_take(map, "b", fl_value_new_string("2"));
+  const gchar* value = nullptr;
+  EXPECT_TRUE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "b", &value));
+  EXPECT_STREQ(value, "2");
+}
+
+TEST(StringMapLookup, LookupReplacedEntry) {
+  g_autoptr(FlValue) map = fl_value_new_map();
+  fl_value_set_string_take(map, "a", fl_value_new_string("1"));
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) object =
+      new_with_string_map(map);
+
+  const gchar* value = nullptr;
+  EXPECT_TRUE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "a", &value));
+  EXPECT_STREQ(value, "1");
+
+  // Replacing an entry frees its key and value, which the lookup must not
+  // still be holding on to.
+  fl_value_set_take(map, fl_value_new_string("a"), fl_value_new_string("3"));
+  EXPECT_TRUE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_lookup_string_map(
+          object, "a", &value));
+  EXPECT_STREQ(value, "3");
+}
+
+TEST(StringMapLookup, Foreach) {
+  g_autoptr(FlValue) map = fl_value_new_map();
+  fl_value_set_string_take(map, "b", fl_value_new_string("2"));
+  fl_value_set_take(map, fl_value_new_int(1), fl_value_new_string("int key"));
+  fl_value_set_string_take(map, "c", fl_value_new_null());
+  fl_value_set_string_take(map, "a", fl_value_new_string("1"));
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) object =
+      new_with_string_map(map);
+
+  std::vector<std::pair<std::string, std::string>> entries;
+  core_tests_pigeon_test_all_nullable_types_without_recursion_foreach_string_map(
+      object, collect_entry, &entries);
+  std::vector<std::pair<std::string, std::string>> expected = {{"b", "2"},
+                                                               {"a", "1"}};
+  EXPECT_EQ(entries, expected);
+}
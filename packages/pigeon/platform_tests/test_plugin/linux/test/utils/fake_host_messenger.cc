@@ -20,6 +20,7 @@ struct _FakeHostMessengerResponseHandle {
   FlBinaryMessengerResponseHandle parent_instance;
 
   FakeHostMessengerReplyHandler reply_callback;
+  FakeHostMessengerBinaryReplyHandler binary_reply_callback;
   gpointer user_data;
 };
 
@@ -34,11 +35,14 @@ G_DEFINE_TYPE(FakeHostMessengerResponseHandle,
               fl_binary_messenger_response_handle_get_type())
 
 FakeHostMessengerResponseHandle* fake_host_messenger_response_handle_new(
-    FakeHostMessengerReplyHandler reply_callback, gpointer user_data) {
+    FakeHostMessengerReplyHandler reply_callback,
+    FakeHostMessengerBinaryReplyHandler binary_reply_callback,
+    gpointer user_data) {
   FakeHostMessengerResponseHandle* self = FAKE_HOST_MESSENGER_RESPONSE_HANDLE(
       g_object_new(fake_host_messenger_response_handle_get_type(), nullptr));
 
   self->reply_callback = reply_callback;
+  self->binary_reply_callback = binary_reply_callback;
   self->user_data = user_data;
 
   return self;
@@ -93,6 +97,11 @@ static gboolean send_response(FlBinaryMessenger* messenger,
   FakeHostMessenger* self = FAKE_HOST_MESSENGER(messenger);
   g_autoptr(FakeHostMessengerResponseHandle) r =
       FAKE_HOST_MESSENGER_RESPONSE_HANDLE(response_handle);
+  if (r->binary_reply_callback != nullptr) {
+    r->binary_reply_callback(response, r->user_data);
+    return TRUE;
+  }
+
   g_autoptr(FlValue) reply =
       fl_message_codec_decode_message(self->codec, response, error);
   if (reply == nullptr) {
@@ -176,8 +185,27 @@ void fake_host_messenger_send_host_message(
   }
 
   FakeHostMessengerResponseHandle* response_handle =
-      fake_host_messenger_response_handle_new(reply_callback, user_data);
+      fake_host_messenger_response_handle_new(reply_callback, nullptr,
+                                              user_data);
   handler->message_handler(FL_BINARY_MESSENGER(self), channel, encoded_message,
                            FL_BINARY_MESSENGER_RESPONSE_HANDLE(response_handle),
                            handler->message_handler_data);
 }
+
+gboolean fake_host_messenger_send_host_binary_message(
+    FakeHostMessenger* self, const gchar* channel, GBytes* message,
+    FakeHostMessengerBinaryReplyHandler reply_callback, gpointer user_data) {
+  MessageHandler* handler = static_cast<MessageHandler*>(
+      g_hash_table_lookup(self->message_handlers, channel));
+  if (handler == nullptr) {
+    return FALSE;
+  }
+
+  FakeHostMessengerResponseHandle* response_handle =
+      fake_host_messenger_response_handle_new(nullptr, reply_callback,
+                                              user_data);
+  handler->message_handler(FL_BINARY_MESSENGER(self), channel, message,
+                           FL_BINARY_MESSENGER_RESPONSE_HANDLE(response_handle),
+                           handler->message_handler_data);
+  return TRUE;
+}
@@ -9,6 +9,8 @@
 
 typedef void (*FakeHostMessengerReplyHandler)(FlValue* reply,
                                               gpointer user_data);
+typedef void (*FakeHostMessengerBinaryReplyHandler)(GBytes* reply,
+                                                    gpointer user_data);
 
 // A BinaryMessenger that allows tests to act as the engine to call host APIs.
 G_DECLARE_FINAL_TYPE(FakeHostMessenger, fake_host_messenger, FAKE,
@@ -25,4 +27,13 @@ void fake_host_messenger_send_host_message(
     FakeHostMessenger* messenger, const gchar* channel, FlValue* message,
     FakeHostMessengerReplyHandler reply_callback, gpointer user_data);
 
+// Calls the registered handler for the given channel with an already encoded
+// message, and calls reply_handler with the encoded response.
+//
+// This allows a test to send messages captured from a running app. Returns
+// FALSE if no handler is registered for the channel.
+gboolean fake_host_messenger_send_host_binary_message(
+    FakeHostMessenger* messenger, const gchar* channel, GBytes* message,
+    FakeHostMessengerBinaryReplyHandler reply_callback, gpointer user_data);
+
 #endif  // PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_FAKE_HOST_MESSENGER_H_
@@ -0,0 +1,288 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "message_replayer.h"
+
+#include <cstring>
+
+#include "recording_messenger.h"
+
+// A message read from a recording.
+typedef struct {
+  gint64 timestamp;
+  gchar* channel;
+  GBytes* message;
+} Record;
+
+static void record_free(gpointer data) {
+  Record* self = static_cast<Record*>(data);
+  g_free(self->channel);
+  g_bytes_unref(self->message);
+  g_free(self);
+}
+
+struct _MessageReplayer {
+  GObject parent_instance;
+
+  FakeHostMessenger* messenger;
+
+  // The recorded messages sent to the host, in the order they were sent.
+  GPtrArray* records;
+
+  // Measured latencies in microseconds, as GArrays of gint64 keyed by channel.
+  GHashTable* latencies;
+
+  // The number of sent messages that haven't been replied to.
+  guint pending_replies;
+};
+
+G_DEFINE_TYPE(MessageReplayer, message_replayer, G_TYPE_OBJECT)
+
+static gboolean read_varint(const guint8* data, gsize length, gsize* offset,
+                            guint64* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*offset >= length) {
+      return FALSE;
+    }
+    guint8 byte = data[(*offset)++];
+    *value |= static_cast<guint64>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static gboolean read_records(const guint8* data, gsize length,
+                             GPtrArray* records, GError** error) {
+  const gsize header_length = sizeof(kRecordingMessengerMagic) + 1;
+  if (length < header_length ||
+      memcmp(data, kRecordingMessengerMagic,
+             sizeof(kRecordingMessengerMagic)) != 0 ||
+      data[sizeof(kRecordingMessengerMagic)] != kRecordingMessengerVersion) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                "Not a version %d message recording",
+                kRecordingMessengerVersion);
+    return FALSE;
+  }
+
+  gsize offset = header_length;
+  while (offset < length) {
+    guint8 direction = data[offset++];
+    guint64 timestamp, channel_length, message_length;
+    if (!read_varint(data, length, &offset, &timestamp) ||
+        !read_varint(data, length, &offset, &channel_length) ||
+        channel_length > length - offset) {
+      g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                  "Truncated record at offset %" G_GSIZE_FORMAT, offset);
+      return FALSE;
+    }
+    const gchar* channel = reinterpret_cast<const gchar*>(data + offset);
+    offset += channel_length;
+    if (!read_varint(data, length, &offset, &message_length) ||
+        message_length > length - offset) {
+      g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                  "Truncated record at offset %" G_GSIZE_FORMAT, offset);
+      return FALSE;
+    }
+
+    if (direction == RECORDING_MESSENGER_DIRECTION_TO_HOST) {
+      Record* record = static_cast<Record*>(g_malloc0(sizeof(Record)));
+      record->timestamp = timestamp;
+      record->channel = g_strndup(channel, channel_length);
+      record->message = g_bytes_new(data + offset, message_length);
+      g_ptr_array_add(records, record);
+    }
+    offset += message_length;
+  }
+
+  return TRUE;
+}
+
+// A message that has been sent and is waiting for a reply.
+typedef struct {
+  MessageReplayer* replayer;
+  gchar* channel;
+  gint64 send_time;
+} PendingReply;
+
+static void reply_cb(GBytes* reply, gpointer user_data) {
+  PendingReply* pending = static_cast<PendingReply*>(user_data);
+  MessageReplayer* self = pending->replayer;
+
+  gint64 latency = g_get_monotonic_time() - pending->send_time;
+  GArray* latencies = static_cast<GArray*>(
+      g_hash_table_lookup(self->latencies, pending->channel));
+  if (latencies == nullptr) {
+    latencies = g_array_new(FALSE, FALSE, sizeof(gint64));
+    g_hash_table_insert(self->latencies, g_strdup(pending->channel), latencies);
+  }
+  g_array_append_val(latencies, latency);
+  self->pending_replies--;
+
+  g_object_unref(pending->replayer);
+  g_free(pending->channel);
+  g_free(pending);
+}
+
+static gboolean timeout_cb(gpointer user_data) {
+  gboolean* timed_out = static_cast<gboolean*>(user_data);
+  *timed_out = TRUE;
+  return G_SOURCE_REMOVE;
+}
+
+static gint compare_latencies(gconstpointer a, gconstpointer b) {
+  gint64 latency_a = *static_cast<const gint64*>(a);
+  gint64 latency_b = *static_cast<const gint64*>(b);
+  return latency_a < latency_b ? -1 : latency_a > latency_b ? 1 : 0;
+}
+
+static void message_replayer_dispose(GObject* object) {
+  MessageReplayer* self = MESSAGE_REPLAYER(object);
+
+  g_clear_object(&self->messenger);
+  g_clear_pointer(&self->records, g_ptr_array_unref);
+  g_clear_pointer(&self->latencies, g_hash_table_unref);
+
+  G_OBJECT_CLASS(message_replayer_parent_class)->dispose(object);
+}
+
+static void message_replayer_class_init(MessageReplayerClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = message_replayer_dispose;
+}
+
+static void message_replayer_init(MessageReplayer* self) {
+  self->records = g_ptr_array_new_with_free_func(record_free);
+  self->latencies = g_hash_table_new_full(
+      g_str_hash, g_str_equal, g_free,
+      reinterpret_cast<GDestroyNotify>(g_array_unref));
+}
+
+MessageReplayer* message_replayer_new(FakeHostMessenger* messenger,
+                                      const gchar* path, GError** error) {
+  g_autofree gchar* contents = nullptr;
+  gsize length;
+  if (!g_file_get_contents(path, &contents, &length, error)) {
+    return nullptr;
+  }
+
+  g_autoptr(MessageReplayer) self = MESSAGE_REPLAYER(
+      g_object_new(message_replayer_get_type(), nullptr));
+  if (!read_records(reinterpret_cast<const guint8*>(contents), length,
+                    self->records, error)) {
+    return nullptr;
+  }
+  self->messenger = FAKE_HOST_MESSENGER(g_object_ref(messenger));
+
+  return MESSAGE_REPLAYER(g_steal_pointer(&self));
+}
+
+gboolean message_replayer_run(MessageReplayer* self,
+                              MessageReplayerSpeed speed, guint timeout_ms,
+                              GError** error) {
+  gint64 start_time = g_get_monotonic_time();
+  gint64 first_timestamp = 0;
+  if (self->records->len > 0) {
+    Record* first = static_cast<Record*>(g_ptr_array_index(self->records, 0));
+    first_timestamp = first->timestamp;
+  }
+  for (guint i = 0; i < self->records->len; i++) {
+    Record* record = static_cast<Record*>(g_ptr_array_index(self->records, i));
+
+    if (speed == MESSAGE_REPLAYER_SPEED_ORIGINAL) {
+      // Keep processing asynchronous replies while waiting for the next
+      // message to be due.
+      gint64 due_time = start_time + record->timestamp - first_timestamp;
+      for (gint64 now = g_get_monotonic_time(); now < due_time;
+           now = g_get_monotonic_time()) {
+        g_main_context_iteration(nullptr, FALSE);
+        g_usleep(MIN(due_time - now, 1000));
+      }
+    }
+
+    PendingReply* pending =
+        static_cast<PendingReply*>(g_malloc0(sizeof(PendingReply)));
+    pending->replayer = MESSAGE_REPLAYER(g_object_ref(self));
+    pending->channel = g_strdup(record->channel);
+    pending->send_time = g_get_monotonic_time();
+    self->pending_replies++;
+    if (!fake_host_messenger_send_host_binary_message(
+            self->messenger, record->channel, record->message, reply_cb,
+            pending)) {
+      self->pending_replies--;
+      g_object_unref(pending->replayer);
+      g_free(pending->channel);
+      g_free(pending);
+      g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                  "No handler registered for %s", record->channel);
+      return FALSE;
+    }
+  }
+
+  gboolean timed_out = FALSE;
+  guint timeout_id = g_timeout_add(timeout_ms, timeout_cb, &timed_out);
+  while (self->pending_replies > 0 && !timed_out) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+  if (!timed_out) {
+    g_source_remove(timeout_id);
+  }
+
+  if (self->pending_replies > 0) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT,
+                "%u messages were not replied to", self->pending_replies);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+gboolean message_replayer_get_latency(MessageReplayer* self,
+                                      const gchar* channel,
+                                      MessageReplayerLatency* latency) {
+  GArray* latencies =
+      static_cast<GArray*>(g_hash_table_lookup(self->latencies, channel));
+  if (latencies == nullptr || latencies->len == 0) {
+    return FALSE;
+  }
+
+  g_autoptr(GArray) sorted = g_array_copy(latencies);
+  g_array_sort(sorted, compare_latencies);
+  guint last = sorted->len - 1;
+  latency->count = sorted->len;
+  latency->min = g_array_index(sorted, gint64, 0);
+  latency->median = g_array_index(sorted, gint64, last / 2);
+  latency->p90 = g_array_index(sorted, gint64, last * 90 / 100);
+  latency->p99 = g_array_index(sorted, gint64, last * 99 / 100);
+  latency->max = g_array_index(sorted, gint64, last);
+
+  return TRUE;
+}
+
+gchar* message_replayer_get_report(MessageReplayer* self) {
+  GString* report = g_string_new(nullptr);
+  g_string_append_printf(report, "%-80s %8s %8s %8s %8s %8s %8s\n",
+                         "channel (latency in us)", "count", "min", "median",
+                         "p90", "p99", "max");
+
+  g_autoptr(GList) channels = g_list_sort(
+      g_hash_table_get_keys(self->latencies),
+      reinterpret_cast<GCompareFunc>(g_strcmp0));
+  for (GList* link = channels; link != nullptr; link = link->next) {
+    const gchar* channel = static_cast<const gchar*>(link->data);
+    MessageReplayerLatency latency;
+    if (!message_replayer_get_latency(self, channel, &latency)) {
+      continue;
+    }
+    g_string_append_printf(report,
+                           "%-80s %8u %8" G_GINT64_FORMAT " %8" G_GINT64_FORMAT
+                           " %8" G_GINT64_FORMAT " %8" G_GINT64_FORMAT
+                           " %8" G_GINT64_FORMAT "\n",
+                           channel, latency.count, latency.min, latency.median,
+                           latency.p90, latency.p99, latency.max);
+  }
+
+  return g_string_free(report, FALSE);
+}
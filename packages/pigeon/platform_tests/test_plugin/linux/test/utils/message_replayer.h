@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_MESSAGE_REPLAYER_H_
+#define PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_MESSAGE_REPLAYER_H_
+
+#include <flutter_linux/flutter_linux.h>
+
+#include "fake_host_messenger.h"
+
+// How quickly recorded messages are replayed.
+typedef enum {
+  // Messages are sent with the same spacing as when they were recorded.
+  MESSAGE_REPLAYER_SPEED_ORIGINAL,
+  // Each message is sent as soon as the previous one has been sent.
+  MESSAGE_REPLAYER_SPEED_MAXIMUM,
+} MessageReplayerSpeed;
+
+// The distribution of the time taken for host handlers to reply on a channel,
+// in microseconds.
+typedef struct {
+  guint count;
+  gint64 min;
+  gint64 median;
+  gint64 p90;
+  gint64 p99;
+  gint64 max;
+} MessageReplayerLatency;
+
+// Replays messages written by a RecordingMessenger to the host handlers
+// registered on a FakeHostMessenger, and measures how long each handler takes
+// to reply.
+//
+// Only messages sent to the host are replayed; messages the host sent to
+// Flutter are skipped.
+//
+// Like RecordingMessenger, this is a test utility of the platform tests.
+G_DECLARE_FINAL_TYPE(MessageReplayer, message_replayer, MESSAGE, REPLAYER,
+                     GObject)
+
+// Creates a replayer for the recording at [path] that sends messages to the
+// handlers registered on [messenger].
+//
+// Returns nullptr and sets [error] if the recording can't be read.
+MessageReplayer* message_replayer_new(FakeHostMessenger* messenger,
+                                      const gchar* path, GError** error);
+
+// Sends every recorded message, then waits up to [timeout_ms] milliseconds
+// for asynchronous handlers to reply.
+//
+// Returns FALSE and sets [error] if a message is recorded on a channel with no
+// handler or a handler does not reply in time. Latencies measured before the
+// failure are kept.
+gboolean message_replayer_run(MessageReplayer* replayer,
+                              MessageReplayerSpeed speed, guint timeout_ms,
+                              GError** error);
+
+// Gets the latencies measured on [channel] by previous runs.
+//
+// Returns FALSE if no replies were received on [channel].
+gboolean message_replayer_get_latency(MessageReplayer* replayer,
+                                      const gchar* channel,
+                                      MessageReplayerLatency* latency);
+
+// Returns a table of the latencies measured on each channel, for printing.
+gchar* message_replayer_get_report(MessageReplayer* replayer);
+
+#endif  // PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_MESSAGE_REPLAYER_H_
@@ -0,0 +1,222 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "recording_messenger.h"
+
+#include <gio/gio.h>
+
+#include <cstring>
+
+struct _RecordingMessenger {
+  GObject parent_instance;
+
+  FlBinaryMessenger* messenger;
+  GOutputStream* stream;
+  gint64 start_time;
+};
+
+static void recording_messenger_binary_messenger_iface_init(
+    FlBinaryMessengerInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(
+    RecordingMessenger, recording_messenger, G_TYPE_OBJECT,
+    G_IMPLEMENT_INTERFACE(fl_binary_messenger_get_type(),
+                          recording_messenger_binary_messenger_iface_init))
+
+static void write_varint(GByteArray* buffer, guint64 value) {
+  while (value >= 0x80) {
+    guint8 byte = (value & 0x7f) | 0x80;
+    g_byte_array_append(buffer, &byte, 1);
+    value >>= 7;
+  }
+  guint8 byte = value;
+  g_byte_array_append(buffer, &byte, 1);
+}
+
+// Writes a single record to [stream]. Records are written with a single call
+// so a record is never split by a write from another message.
+static void write_record(GOutputStream* stream, gint64 start_time,
+                         RecordingMessengerDirection direction,
+                         const gchar* channel, GBytes* message) {
+  gsize message_length = 0;
+  const guint8* message_data =
+      message != nullptr ? static_cast<const guint8*>(
+                               g_bytes_get_data(message, &message_length))
+                         : nullptr;
+  size_t channel_length = strlen(channel);
+
+  g_autoptr(GByteArray) buffer =
+      g_byte_array_sized_new(channel_length + message_length + 16);
+  guint8 direction_byte = direction;
+  g_byte_array_append(buffer, &direction_byte, 1);
+  write_varint(buffer, g_get_monotonic_time() - start_time);
+  write_varint(buffer, channel_length);
+  g_byte_array_append(buffer, reinterpret_cast<const guint8*>(channel),
+                      channel_length);
+  write_varint(buffer, message_length);
+  g_byte_array_append(buffer, message_data, message_length);
+
+  g_autoptr(GError) error = nullptr;
+  if (!g_output_stream_write_all(stream, buffer->data, buffer->len, nullptr,
+                                 nullptr, &error)) {
+    g_warning("Failed to record message on %s: %s", channel, error->message);
+  }
+}
+
+// The handler registered on the wrapped messenger, which records each message
+// before passing it to the handler registered on the recording messenger.
+typedef struct {
+  GOutputStream* stream;
+  gint64 start_time;
+  FlBinaryMessengerMessageHandler message_handler;
+  gpointer message_handler_data;
+  GDestroyNotify message_handler_destroy_notify;
+} RecordedHandler;
+
+static RecordedHandler* recorded_handler_new(
+    RecordingMessenger* self, FlBinaryMessengerMessageHandler handler,
+    gpointer user_data, GDestroyNotify destroy_notify) {
+  RecordedHandler* recorded_handler =
+      static_cast<RecordedHandler*>(g_malloc0(sizeof(RecordedHandler)));
+  recorded_handler->stream = G_OUTPUT_STREAM(g_object_ref(self->stream));
+  recorded_handler->start_time = self->start_time;
+  recorded_handler->message_handler = handler;
+  recorded_handler->message_handler_data = user_data;
+  recorded_handler->message_handler_destroy_notify = destroy_notify;
+  return recorded_handler;
+}
+
+static void recorded_handler_free(gpointer data) {
+  RecordedHandler* self = static_cast<RecordedHandler*>(data);
+  if (self->message_handler_destroy_notify) {
+    self->message_handler_destroy_notify(self->message_handler_data);
+  }
+  g_object_unref(self->stream);
+
+  g_free(self);
+}
+
+static void recorded_handler_cb(
+    FlBinaryMessenger* messenger, const gchar* channel, GBytes* message,
+    FlBinaryMessengerResponseHandle* response_handle, gpointer user_data) {
+  RecordedHandler* self = static_cast<RecordedHandler*>(user_data);
+  write_record(self->stream, self->start_time,
+               RECORDING_MESSENGER_DIRECTION_TO_HOST, channel, message);
+  self->message_handler(messenger, channel, message, response_handle,
+                        self->message_handler_data);
+}
+
+static void set_message_handler_on_channel(
+    FlBinaryMessenger* messenger, const gchar* channel,
+    FlBinaryMessengerMessageHandler handler, gpointer user_data,
+    GDestroyNotify destroy_notify) {
+  RecordingMessenger* self = RECORDING_MESSENGER(messenger);
+  if (handler == nullptr) {
+    fl_binary_messenger_set_message_handler_on_channel(
+        self->messenger, channel, nullptr, user_data, destroy_notify);
+    return;
+  }
+
+  fl_binary_messenger_set_message_handler_on_channel(
+      self->messenger, channel, recorded_handler_cb,
+      recorded_handler_new(self, handler, user_data, destroy_notify),
+      recorded_handler_free);
+}
+
+static gboolean send_response(FlBinaryMessenger* messenger,
+                              FlBinaryMessengerResponseHandle* response_handle,
+                              GBytes* response, GError** error) {
+  RecordingMessenger* self = RECORDING_MESSENGER(messenger);
+  return fl_binary_messenger_send_response(self->messenger, response_handle,
+                                           response, error);
+}
+
+static void send_on_channel(FlBinaryMessenger* messenger, const gchar* channel,
+                            GBytes* message, GCancellable* cancellable,
+                            GAsyncReadyCallback callback, gpointer user_data) {
+  RecordingMessenger* self = RECORDING_MESSENGER(messenger);
+  write_record(self->stream, self->start_time,
+               RECORDING_MESSENGER_DIRECTION_TO_FLUTTER, channel, message);
+  fl_binary_messenger_send_on_channel(self->messenger, channel, message,
+                                      cancellable, callback, user_data);
+}
+
+static GBytes* send_on_channel_finish(FlBinaryMessenger* messenger,
+                                      GAsyncResult* result, GError** error) {
+  RecordingMessenger* self = RECORDING_MESSENGER(messenger);
+  return fl_binary_messenger_send_on_channel_finish(self->messenger, result,
+                                                    error);
+}
+
+static void resize_channel(FlBinaryMessenger* messenger, const gchar* channel,
+                           int64_t new_size) {
+  RecordingMessenger* self = RECORDING_MESSENGER(messenger);
+  fl_binary_messenger_resize_channel(self->messenger, channel, new_size);
+}
+
+static void set_warns_on_channel_overflow(FlBinaryMessenger* messenger,
+                                          const gchar* channel, bool warns) {
+  RecordingMessenger* self = RECORDING_MESSENGER(messenger);
+  fl_binary_messenger_set_warns_on_channel_overflow(self->messenger, channel,
+                                                    warns);
+}
+
+static void recording_messenger_dispose(GObject* object) {
+  RecordingMessenger* self = RECORDING_MESSENGER(object);
+
+  if (self->stream != nullptr) {
+    g_output_stream_flush(self->stream, nullptr, nullptr);
+  }
+  g_clear_object(&self->stream);
+  g_clear_object(&self->messenger);
+
+  G_OBJECT_CLASS(recording_messenger_parent_class)->dispose(object);
+}
+
+static void recording_messenger_class_init(RecordingMessengerClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = recording_messenger_dispose;
+}
+
+static void recording_messenger_binary_messenger_iface_init(
+    FlBinaryMessengerInterface* iface) {
+  iface->set_message_handler_on_channel = set_message_handler_on_channel;
+  iface->send_response = send_response;
+  iface->send_on_channel = send_on_channel;
+  iface->send_on_channel_finish = send_on_channel_finish;
+  iface->resize_channel = resize_channel;
+  iface->set_warns_on_channel_overflow = set_warns_on_channel_overflow;
+}
+
+static void recording_messenger_init(RecordingMessenger* self) {}
+
+RecordingMessenger* recording_messenger_new(FlBinaryMessenger* messenger,
+                                            const gchar* path,
+                                            GError** error) {
+  g_autoptr(GFile) file = g_file_new_for_path(path);
+  g_autoptr(GFileOutputStream) file_stream = g_file_replace(
+      file, nullptr, FALSE, G_FILE_CREATE_NONE, nullptr, error);
+  if (file_stream == nullptr) {
+    return nullptr;
+  }
+  // Messages are small and frequent, so buffer writes to the file.
+  g_autoptr(GOutputStream) stream =
+      g_buffered_output_stream_new(G_OUTPUT_STREAM(file_stream));
+  if (!g_output_stream_write_all(stream, kRecordingMessengerMagic,
+                                 sizeof(kRecordingMessengerMagic), nullptr,
+                                 nullptr, error) ||
+      !g_output_stream_write_all(stream, &kRecordingMessengerVersion,
+                                 sizeof(kRecordingMessengerVersion), nullptr,
+                                 nullptr, error)) {
+    return nullptr;
+  }
+
+  RecordingMessenger* self = RECORDING_MESSENGER(
+      g_object_new(recording_messenger_get_type(), nullptr));
+
+  self->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));
+  self->stream = G_OUTPUT_STREAM(g_steal_pointer(&stream));
+  self->start_time = g_get_monotonic_time();
+
+  return self;
+}
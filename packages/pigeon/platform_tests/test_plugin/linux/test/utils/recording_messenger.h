@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_RECORDING_MESSENGER_H_
+#define PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_RECORDING_MESSENGER_H_
+
+#include <flutter_linux/flutter_linux.h>
+
+// The bytes a recording starts with, followed by the format version.
+static const guint8 kRecordingMessengerMagic[] = {'P', 'G', 'N', 'R'};
+static const guint8 kRecordingMessengerVersion = 1;
+
+// The direction of a recorded message.
+typedef enum {
+  // A message sent from Dart to a host handler.
+  RECORDING_MESSENGER_DIRECTION_TO_HOST = 0,
+  // A message sent from the host to Dart.
+  RECORDING_MESSENGER_DIRECTION_TO_FLUTTER = 1,
+} RecordingMessengerDirection;
+
+// A BinaryMessenger that forwards all calls to another messenger, and writes
+// each message sent through it to a file so it can be replayed later.
+//
+// The file starts with kRecordingMessengerMagic and a version byte of
+// kRecordingMessengerVersion, followed by one record per message:
+//   - the direction, as a single byte.
+//   - the time since the messenger was created in microseconds, as a varint.
+//   - the channel name length as a varint, followed by the UTF-8 name.
+//   - the payload length as a varint, followed by the encoded payload.
+//
+// Varints are unsigned LEB128, seven bits per byte with the high bit set on
+// all but the last byte.
+//
+// This is a test utility of the platform tests, and is not part of the code
+// Pigeon generates; plugins can't use it to record their own traffic.
+G_DECLARE_FINAL_TYPE(RecordingMessenger, recording_messenger, RECORDING,
+                     MESSENGER, GObject)
+
+// Creates a messenger that forwards to [messenger] and records to the file at
+// [path], replacing any existing file.
+//
+// Returns nullptr and sets [error] if the file can't be created.
+RecordingMessenger* recording_messenger_new(FlBinaryMessenger* messenger,
+                                            const gchar* path,
+                                            GError** error);
+
+#endif  // PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_RECORDING_MESSENGER_H_
@@ -15,8 +15,10 @@
 #include <flutter/standard_message_codec.h>
 
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 
 namespace core_tests_pigeontest {
 using flutter::BasicMessageChannel;
@@ -32,6 +34,93 @@ FlutterError CreateConnectionError(const std::string channel_name) {
       EncodableValue(""));
 }
 
+// Returns the last value sent for each @Synced argument, keyed by the
+// messenger, channel and argument index it was sent with.
+std::map<std::tuple<flutter::BinaryMessenger*, std::string, size_t>,
+         std::shared_ptr<std::shared_ptr<const EncodableList>>>&
+GetSyncedSnapshots() {
+  static auto* snapshots =
+      new std::map<std::tuple<flutter::BinaryMessenger*, std::string, size_t>,
+                   std::shared_ptr<std::shared_ptr<const EncodableList>>>();
+  return *snapshots;
+}
+
+// Returns where the last value sent for the @Synced argument at `index` of
+// the method on `channel_name` is stored. Flutter keeps one value per
+// channel, so it is shared by every API instance that sends on the channel.
+// Calls in flight hold on to the returned storage, so it stays valid after
+// ClearSyncedSnapshots removes it.
+std::shared_ptr<std::shared_ptr<const EncodableList>> GetSyncedSnapshot(
+    flutter::BinaryMessenger* binary_messenger,
+    const std::string& channel_name, size_t index) {
+  std::shared_ptr<std::shared_ptr<const EncodableList>>& snapshot =
+      GetSyncedSnapshots()[std::make_tuple(binary_messenger, channel_name,
+                                           index)];
+  if (!snapshot) {
+    snapshot = std::make_shared<std::shared_ptr<const EncodableList>>();
+  }
+  return snapshot;
+}
+
+// Forgets the values sent on `channel_name` with `binary_messenger`, so the
+// next call sends them in full.
+void ClearSyncedSnapshots(flutter::BinaryMessenger* binary_messenger,
+                          const std::string& channel_name) {
+  auto& snapshots = GetSyncedSnapshots();
+  auto it = snapshots.lower_bound(
+      std::make_tuple(binary_messenger, channel_name, size_t{0}));
+  while (it != snapshots.end() &&
+         std::get<0>(it->first) == binary_messenger &&
+         std::get<1>(it->first) == channel_name) {
+    it = snapshots.erase(it);
+  }
+}
+
+// Returns the fields of `values` that differ from `snapshot` as a flat list
+// of alternating field indices and values, or std::nullopt if the full
+// value has to be sent. Stores `values` as the new snapshot.
+std::optional<EncodableList> CreateSyncedPatch(
+    std::shared_ptr<const EncodableList>* snapshot, EncodableList values) {
+  std::optional<EncodableList> patch;
+  if (*snapshot && (*snapshot)->size() == values.size()) {
+    patch = EncodableList();
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (!(values[i] == (**snapshot)[i])) {
+        patch->push_back(EncodableValue(static_cast<int32_t>(i)));
+        patch->push_back(values[i]);
+      }
+    }
+  }
+  *snapshot = std::make_shared<const EncodableList>(std::move(values));
+  return patch;
+}
+
+// Returns the reply handler of a Flutter API call with @Synced arguments,
+// which passes the decoded reply to `on_reply`. `resend_in_full` is set
+// if the call sent patches. If Flutter replies that it no longer has the
+// values they were made against, e.g. after a hot restart, it is called to
+// send the full values instead, and its reply is handled in the same way.
+flutter::BinaryReply CreateSyncedReplyHandler(
+    const flutter::MessageCodec<EncodableValue>* codec,
+    std::function<void(flutter::BinaryReply)> resend_in_full,
+    std::function<void(std::unique_ptr<EncodableValue>)> on_reply) {
+  return [codec, resend_in_full = std::move(resend_in_full),
+          on_reply = std::move(on_reply)](const uint8_t* reply,
+                                          size_t reply_size) {
+    std::unique_ptr<EncodableValue> response =
+        codec->DecodeMessage(reply, reply_size);
+    const auto* list = std::get_if<EncodableList>(response.get());
+    const auto* code = list && list->size() > 1
+                           ? std::get_if<std::string>(&list->at(0))
+                           : nullptr;
+    if (resend_in_full && code && *code == "synced-state-missing") {
+      resend_in_full(CreateSyncedReplyHandler(codec, nullptr, on_reply));
+      return;
+    }
+    on_reply(std::move(response));
+  };
+}
+
 // UnusedClass
 
 UnusedClass::UnusedClass() {}
@@ -2116,13 +2205,21 @@ TestMessage TestMessage::FromEncodableList(const EncodableList& list) {
   return decoded;
 }
 
+// The standard codec type tag for a 32-bit integer, used to encode enum
+// values.
+constexpr uint8_t kEncodedInt32Type = 3;
+
 PigeonInternalCodecSerializer::PigeonInternalCodecSerializer() {}
 
 EncodableValue PigeonInternalCodecSerializer::ReadValueOfType(
     uint8_t type, flutter::ByteStreamReader* stream) const {
   switch (type) {
     case 129: {
-      const auto& encodable_enum_arg = ReadValue(stream);
+      const uint8_t enum_arg_type = stream->ReadByte();
+      if (enum_arg_type == kEncodedInt32Type) {
+        return CustomEncodableValue(static_cast<AnEnum>(stream->ReadInt32()));
+      }
+      const auto& encodable_enum_arg = ReadValueOfType(enum_arg_type, stream);
       const int64_t enum_arg_value =
           encodable_enum_arg.IsNull() ? 0 : encodable_enum_arg.LongValue();
       return encodable_enum_arg.IsNull()
@@ -2130,7 +2227,12 @@ EncodableValue PigeonInternalCodecSerializer::ReadValueOfType(
                  : CustomEncodableValue(static_cast<AnEnum>(enum_arg_value));
     }
     case 130: {
-      const auto& encodable_enum_arg = ReadValue(stream);
+      const uint8_t enum_arg_type = stream->ReadByte();
+      if (enum_arg_type == kEncodedInt32Type) {
+        return CustomEncodableValue(
+            static_cast<AnotherEnum>(stream->ReadInt32()));
+      }
+      const auto& encodable_enum_arg = ReadValueOfType(enum_arg_type, stream);
       const int64_t enum_arg_value =
           encodable_enum_arg.IsNull() ? 0 : encodable_enum_arg.LongValue();
       return encodable_enum_arg.IsNull()
@@ -2174,16 +2276,16 @@ void PigeonInternalCodecSerializer::WriteValue(
           std::get_if<CustomEncodableValue>(&value)) {
     if (custom_value->type() == typeid(AnEnum)) {
       stream->WriteByte(129);
-      WriteValue(EncodableValue(
-                     static_cast<int>(std::any_cast<AnEnum>(*custom_value))),
-                 stream);
+      stream->WriteByte(kEncodedInt32Type);
+      stream->WriteInt32(
+          static_cast<int32_t>(std::any_cast<AnEnum>(*custom_value)));
       return;
     }
     if (custom_value->type() == typeid(AnotherEnum)) {
       stream->WriteByte(130);
-      WriteValue(EncodableValue(static_cast<int>(
-                     std::any_cast<AnotherEnum>(*custom_value))),
-                 stream);
+      stream->WriteByte(kEncodedInt32Type);
+      stream->WriteInt32(
+          static_cast<int32_t>(std::any_cast<AnotherEnum>(*custom_value)));
       return;
     }
     if (custom_value->type() == typeid(UnusedClass)) {
@@ -8165,6 +8267,16 @@ FlutterIntegrationCoreApi::FlutterIntegrationCoreApi(
                                   ? std::string(".") + message_channel_suffix
                                   : "") {}
 
+FlutterIntegrationCoreApi::~FlutterIntegrationCoreApi() {
+  // Forget the @Synced values sent by this instance, since a later messenger
+  // may be allocated at the same address.
+  ClearSyncedSnapshots(
+      binary_messenger_,
+      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+      "echoAllTypes" +
+          message_channel_suffix_);
+}
+
 const flutter::StandardMessageCodec& FlutterIntegrationCoreApi::GetCodec() {
   return flutter::StandardMessageCodec::GetInstance(
       &PigeonInternalCodecSerializer::GetInstance());
@@ -8279,33 +8391,61 @@ void FlutterIntegrationCoreApi::EchoAllTypes(
       "echoAllTypes" +
       message_channel_suffix_;
   BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
-  EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
-      CustomEncodableValue(everything_arg),
-  });
+  std::shared_ptr<std::shared_ptr<const EncodableList>>
+      everything_arg_snapshot =
+          GetSyncedSnapshot(binary_messenger_, channel_name, 0);
+  std::optional<EncodableList> everything_arg_patch = CreateSyncedPatch(
+      everything_arg_snapshot.get(), everything_arg.ToEncodableList());
+  auto encoded_api_arguments =
+      std::make_shared<EncodableValue>(EncodableValue(EncodableList{
+          everything_arg_patch
+              ? EncodableValue(std::move(*everything_arg_patch))
+              : EncodableValue(CustomEncodableValue(everything_arg)),
+      }));
+  // Sends the arguments again with the @Synced arguments in full, if Flutter no
+  // longer has the values the patches were made against.
+  std::function<void(flutter::BinaryReply)> resend_in_full;
+  if (everything_arg_patch) {
+    resend_in_full = [binary_messenger = binary_messenger_, channel_name,
+                      encoded_api_arguments, everything_arg_snapshot,
+                      everything_arg_full = *everything_arg_snapshot](
+                         flutter::BinaryReply reply) {
+      auto& arguments = std::get<EncodableList>(*encoded_api_arguments);
+      *everything_arg_snapshot = nullptr;
+      arguments[0] = CustomEncodableValue(
+          AllTypes::FromEncodableList(*everything_arg_full));
+      BasicMessageChannel<> channel(binary_messenger, channel_name,
+                                    &GetCodec());
+      channel.Send(*encoded_api_arguments, std::move(reply));
+    };
+  }
   channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
-        std::unique_ptr<EncodableValue> response =
-            GetCodec().DecodeMessage(reply, reply_size);
-        const auto& encodable_return_value = *response;
-        const auto* list_return_value =
-            std::get_if<EncodableList>(&encodable_return_value);
-        if (list_return_value) {
-          if (list_return_value->size() > 1) {
-            on_error(
-                FlutterError(std::get<std::string>(list_return_value->at(0)),
-                             std::get<std::string>(list_return_value->at(1)),
-                             list_return_value->at(2)));
-          } else {
-            const auto& return_value = std::any_cast<const AllTypes&>(
-                std::get<CustomEncodableValue>(list_return_value->at(0)));
-            on_success(return_value);
-          }
-        } else {
-          on_error(CreateConnectionError(channel_name));
-        }
-      });
+      *encoded_api_arguments,
+      CreateSyncedReplyHandler(
+          &GetCodec(), std::move(resend_in_full),
+          [channel_name, on_success = std::move(on_success),
+           on_error = std::move(on_error),
+           everything_arg_snapshot](std::unique_ptr<EncodableValue> response) {
+            const auto& encodable_return_value = *response;
+            const auto* list_return_value =
+                std::get_if<EncodableList>(&encodable_return_value);
+            if (list_return_value) {
+              if (list_return_value->size() > 1) {
+                *everything_arg_snapshot = nullptr;
+                on_error(FlutterError(
+                    std::get<std::string>(list_return_value->at(0)),
+                    std::get<std::string>(list_return_value->at(1)),
+                    list_return_value->at(2)));
+              } else {
+                const auto& return_value = std::any_cast<const AllTypes&>(
+                    std::get<CustomEncodableValue>(list_return_value->at(0)));
+                on_success(return_value);
+              }
+            } else {
+              *everything_arg_snapshot = nullptr;
+              on_error(CreateConnectionError(channel_name));
+            }
+          }));
 }
 
 void FlutterIntegrationCoreApi::EchoAllNullableTypes(
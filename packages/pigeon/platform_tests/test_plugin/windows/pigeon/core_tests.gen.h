@@ -1359,6 +1359,7 @@ class FlutterIntegrationCoreApi {
   FlutterIntegrationCoreApi(flutter::BinaryMessenger* binary_messenger);
   FlutterIntegrationCoreApi(flutter::BinaryMessenger* binary_messenger,
                             const std::string& message_channel_suffix);
+  ~FlutterIntegrationCoreApi();
   static const flutter::StandardMessageCodec& GetCodec();
   // A no-op function taking no arguments and returning no value, to sanity
   // test basic calling.
@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "pigeon/compression_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace compression_tests_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+
+// The codec type tag of a compressed message.
+constexpr uint8_t kCompressedMessageType = 128;
+
+constexpr char kEchoStringChannel[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.CompressedHostApi.echoString";
+
+class TestHostApi : public CompressedHostApi {
+ public:
+  TestHostApi() {}
+  virtual ~TestHostApi() {}
+
+ protected:
+  ErrorOr<std::string> EchoString(const std::string& value) override {
+    return std::string(value);
+  }
+};
+
+// Returns the encoded message Dart sends to echo |value|, which is also the
+// uncompressed encoding of the reply.
+std::vector<uint8_t> EncodeEcho(const std::string& value) {
+  return *CompressedHostApi::GetCodec().EncodeMessage(
+      EncodableValue(EncodableList({EncodableValue(value)})));
+}
+
+// Returns the reply of the host API to |message|.
+std::vector<uint8_t> SendEcho(FakeHostMessenger* messenger,
+                              const std::vector<uint8_t>& message) {
+  std::vector<uint8_t> result;
+  messenger->SendHostBinaryMessage(
+      kEchoStringChannel, message,
+      [&result](const uint8_t* reply, size_t reply_size) {
+        result.assign(reply, reply + reply_size);
+      });
+  return result;
+}
+
+// Reads a size written by the standard codec at |*position|.
+size_t ReadSize(const std::vector<uint8_t>& data, size_t* position) {
+  const uint8_t byte = data[(*position)++];
+  if (byte < 254) {
+    return byte;
+  }
+  if (byte == 254) {
+    uint16_t value;
+    memcpy(&value, &data[*position], sizeof(value));
+    *position += sizeof(value);
+    return value;
+  }
+  uint32_t value;
+  memcpy(&value, &data[*position], sizeof(value));
+  *position += sizeof(value);
+  return value;
+}
+
+// Decompresses |length| bytes of |input| from the LZ4 block format.
+std::vector<uint8_t> DecompressLz4(const uint8_t* input, size_t length) {
+  std::vector<uint8_t> output;
+  size_t position = 0;
+  auto read_length = [&](size_t value) {
+    uint8_t byte;
+    do {
+      byte = input[position++];
+      value += byte;
+    } while (byte == 255);
+    return value;
+  };
+  while (position < length) {
+    const uint8_t token = input[position++];
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      literal_length = read_length(literal_length);
+    }
+    output.insert(output.end(), input + position,
+                  input + position + literal_length);
+    position += literal_length;
+    if (position >= length) {
+      break;
+    }
+    const size_t offset = input[position] | (input[position + 1] << 8);
+    position += 2;
+    size_t match_length = (token & 0x0f) + 4;
+    if (match_length == 19) {
+      match_length = read_length(match_length);
+    }
+    for (size_t i = 0; i < match_length; i++) {
+      output.push_back(output[output.size() - offset]);
+    }
+  }
+  return output;
+}
+}  // namespace
+
+TEST(Compression, SmallReplyIsNotCompressed) {
+  FakeHostMessenger messenger(&CompressedHostApi::GetCodec());
+  TestHostApi api;
+  CompressedHostApi::SetUp(&messenger, &api);
+
+  const std::vector<uint8_t> message = EncodeEcho("hello");
+  EXPECT_EQ(SendEcho(&messenger, message), message);
+}
+
+TEST(Compression, LargeReplyIsCompressed) {
+  FakeHostMessenger messenger(&CompressedHostApi::GetCodec());
+  TestHostApi api;
+  CompressedHostApi::SetUp(&messenger, &api);
+
+  const std::vector<uint8_t> message = EncodeEcho(std::string(1000, 'a'));
+  const std::vector<uint8_t> reply = SendEcho(&messenger, message);
+
+  ASSERT_FALSE(reply.empty());
+  EXPECT_EQ(reply[0], kCompressedMessageType);
+  size_t position = 1;
+  EXPECT_EQ(ReadSize(reply, &position), message.size());
+  const size_t compressed_size = ReadSize(reply, &position);
+  ASSERT_EQ(position + compressed_size, reply.size());
+  EXPECT_LT(reply.size(), message.size());
+  EXPECT_EQ(DecompressLz4(&reply[position], compressed_size), message);
+}
+
+TEST(Compression, IncompressibleReplyIsNotCompressed) {
+  FakeHostMessenger messenger(&CompressedHostApi::GetCodec());
+  TestHostApi api;
+  CompressedHostApi::SetUp(&messenger, &api);
+
+  // Longer than the threshold, but without any repeated sequences.
+  std::string value;
+  for (char c = '!'; c <= '~'; c++) {
+    value.push_back(c);
+  }
+  const std::vector<uint8_t> message = EncodeEcho(value);
+  EXPECT_EQ(SendEcho(&messenger, message), message);
+}
+
+}  // namespace compression_tests_pigeontest
@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "pigeon/primitive.gen.h"
+#include "test/utils/silent_messenger.h"
+
+namespace primitive_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::SilentMessenger;
+
+// A stand-in for a buffer captured by a call's callbacks.
+struct CapturedBuffer {};
+
+FlutterApiCallOptions ExpiredDeadline() {
+  FlutterApiCallOptions options;
+  options.deadline =
+      std::chrono::steady_clock::now() - std::chrono::milliseconds(1);
+  return options;
+}
+}  // namespace
+
+TEST(FlutterApiCancellation, ReapsExpiredCalls) {
+  SilentMessenger messenger;
+  PrimitiveFlutterApi api(&messenger);
+
+  std::optional<std::string> error_code;
+  auto buffer = std::make_shared<CapturedBuffer>();
+  std::weak_ptr<CapturedBuffer> weak_buffer = buffer;
+  // Use a deadline in the future, so the calls aren't failed by the calls made
+  // after them.
+  FlutterApiCallOptions options;
+  options.deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+  for (int i = 0; i < 3; i++) {
+    api.AnInt(
+        i, [buffer](int64_t value) { FAIL() << "Unexpected reply"; },
+        [&error_code](const FlutterError& error) { error_code = error.code(); },
+        options);
+  }
+  buffer.reset();
+  ASSERT_EQ(messenger.replies().size(), 3u);
+  EXPECT_FALSE(weak_buffer.expired());
+
+  std::this_thread::sleep_until(*options.deadline +
+                                std::chrono::milliseconds(1));
+
+  EXPECT_EQ(api.ReapExpiredCalls(), 3u);
+  EXPECT_EQ(error_code, "timeout");
+  // The messenger still holds the reply handlers, but the callbacks they
+  // captured have been released.
+  EXPECT_TRUE(weak_buffer.expired());
+  EXPECT_EQ(api.ReapExpiredCalls(), 0u);
+}
+
+TEST(FlutterApiCancellation, IgnoresRepliesAfterTimeout) {
+  SilentMessenger messenger;
+  PrimitiveFlutterApi api(&messenger);
+
+  int error_count = 0;
+  api.AnInt(
+      7, [](int64_t value) { FAIL() << "Unexpected reply"; },
+      [&error_count](const FlutterError& error) { error_count++; },
+      ExpiredDeadline());
+  EXPECT_EQ(api.ReapExpiredCalls(), 1u);
+
+  std::unique_ptr<std::vector<uint8_t>> reply =
+      PrimitiveFlutterApi::GetCodec().EncodeMessage(
+          EncodableValue(EncodableList{EncodableValue(int64_t{7})}));
+  messenger.replies()[0](reply->data(), reply->size());
+  EXPECT_EQ(error_count, 1);
+}
+
+TEST(FlutterApiCancellation, KeepsCallsBeforeDeadline) {
+  SilentMessenger messenger;
+  PrimitiveFlutterApi api(&messenger);
+
+  std::optional<int64_t> result;
+  FlutterApiCallOptions options;
+  options.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+  api.AnInt(
+      7, [&result](int64_t value) { result = value; },
+      [](const FlutterError& error) { FAIL() << "Unexpected error"; },
+      options);
+  EXPECT_EQ(api.ReapExpiredCalls(), 0u);
+
+  std::unique_ptr<std::vector<uint8_t>> reply =
+      PrimitiveFlutterApi::GetCodec().EncodeMessage(
+          EncodableValue(EncodableList{EncodableValue(int64_t{7})}));
+  messenger.replies()[0](reply->data(), reply->size());
+  EXPECT_EQ(result, 7);
+}
+
+TEST(FlutterApiCancellation, CancelsCalls) {
+  SilentMessenger messenger;
+  PrimitiveFlutterApi api(&messenger);
+
+  std::optional<std::string> error_code;
+  auto buffer = std::make_shared<CapturedBuffer>();
+  std::weak_ptr<CapturedBuffer> weak_buffer = buffer;
+  CancellationToken token;
+  FlutterApiCallOptions options;
+  options.cancellation_token = token;
+  api.AnInt(
+      7, [buffer](int64_t value) { FAIL() << "Unexpected reply"; },
+      [&error_code](const FlutterError& error) { error_code = error.code(); },
+      options);
+  buffer.reset();
+  EXPECT_FALSE(weak_buffer.expired());
+
+  token.Cancel();
+  EXPECT_TRUE(token.is_cancelled());
+  EXPECT_EQ(error_code, "cancelled");
+  EXPECT_TRUE(weak_buffer.expired());
+}
+
+TEST(FlutterApiCancellation, FailsCallsWithCancelledToken) {
+  SilentMessenger messenger;
+  PrimitiveFlutterApi api(&messenger);
+
+  std::optional<std::string> error_code;
+  CancellationToken token;
+  token.Cancel();
+  FlutterApiCallOptions options;
+  options.cancellation_token = token;
+  api.AnInt(
+      7, [](int64_t value) { FAIL() << "Unexpected reply"; },
+      [&error_code](const FlutterError& error) { error_code = error.code(); },
+      options);
+
+  EXPECT_EQ(error_code, "cancelled");
+  EXPECT_TRUE(messenger.replies().empty());
+}
+
+}  // namespace primitive_pigeontest
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "test/utils/recording_messenger.h"
+
+#include <flutter/encodable_value.h>
+#include <flutter/standard_message_codec.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "test/utils/fake_host_messenger.h"
+
+namespace testing {
+
+namespace {
+using flutter::EncodableValue;
+
+const char kChannel[] = "dev.flutter.pigeon.test.echo";
+
+std::vector<uint8_t> ReadFile(const std::filesystem::path& path) {
+  std::ifstream stream(path, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream),
+                              std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+TEST(RecordingMessenger, RecordsHostMessages) {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "pigeon_recording_test.bin";
+  const flutter::StandardMessageCodec& codec =
+      flutter::StandardMessageCodec::GetInstance();
+  FakeHostMessenger messenger(&codec);
+  {
+    RecordingMessenger recorder(&messenger, path.string());
+    ASSERT_TRUE(recorder.is_open());
+    recorder.SetMessageHandler(
+        kChannel, [](const uint8_t* message, size_t message_size,
+                     flutter::BinaryReply reply) {
+          reply(message, message_size);
+        });
+
+    bool replied = false;
+    messenger.SendHostMessage(kChannel, EncodableValue(42),
+                              [&replied](const EncodableValue& reply) {
+                                EXPECT_EQ(std::get<int32_t>(reply), 42);
+                                replied = true;
+                              });
+    EXPECT_TRUE(replied);
+  }
+
+  const std::vector<uint8_t> recording = ReadFile(path);
+  const std::vector<uint8_t> payload =
+      *codec.EncodeMessage(EncodableValue(42));
+  // Header, direction, timestamp, channel and payload.
+  ASSERT_GE(recording.size(),
+            5 + 1 + 1 + 1 + sizeof(kChannel) - 1 + 1 + payload.size());
+  EXPECT_EQ(std::vector<uint8_t>(recording.begin(), recording.begin() + 5),
+            std::vector<uint8_t>({'P', 'G', 'N', 'R', 1}));
+  EXPECT_EQ(recording[5],
+            static_cast<uint8_t>(RecordingMessenger::Direction::kToHost));
+  EXPECT_EQ(std::vector<uint8_t>(recording.end() - payload.size(),
+                                 recording.end()),
+            payload);
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace testing
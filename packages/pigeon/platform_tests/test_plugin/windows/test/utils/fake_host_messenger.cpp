@@ -34,6 +34,12 @@ void FakeHostMessenger::SendHostMessage(const std::string& channel,
   handlers_[channel](data->data(), data->size(), std::move(binary_handler));
 }
 
+void FakeHostMessenger::SendHostBinaryMessage(
+    const std::string& channel, const std::vector<uint8_t>& message,
+    flutter::BinaryReply reply_handler) {
+  handlers_[channel](message.data(), message.size(), std::move(reply_handler));
+}
+
 void FakeHostMessenger::Send(const std::string& channel, const uint8_t* message,
                              size_t message_size,
                              flutter::BinaryReply reply) const {}
@@ -10,6 +10,7 @@
 #include <flutter/message_codec.h>
 
 #include <map>
+#include <vector>
 
 namespace testing {
 
@@ -34,6 +35,14 @@ class FakeHostMessenger : public flutter::BinaryMessenger {
                        const flutter::EncodableValue& message,
                        HostMessageReply reply_handler);
 
+  // Calls the registered handler for the given channel with an already encoded
+  // message, and calls reply_handler with the encoded response.
+  //
+  // This allows a test to check the exact bytes a host API replies with.
+  void SendHostBinaryMessage(const std::string& channel,
+                             const std::vector<uint8_t>& message,
+                             flutter::BinaryReply reply_handler);
+
   // flutter::BinaryMessenger:
   void Send(const std::string& channel, const uint8_t* message,
             size_t message_size,
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "recording_messenger.h"
+
+#include <vector>
+
+namespace testing {
+
+namespace {
+
+const uint8_t kRecordingMagic[] = {'P', 'G', 'N', 'R'};
+const uint8_t kRecordingVersion = 1;
+
+void WriteVarint(std::vector<uint8_t>* buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer->push_back(static_cast<uint8_t>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer->push_back(static_cast<uint8_t>(value));
+}
+
+// Writes a single record to |stream|. Records are written with a single call
+// so a record is never split by a write from another message.
+void WriteRecord(std::ofstream& stream,
+                 std::chrono::steady_clock::time_point start_time,
+                 RecordingMessenger::Direction direction,
+                 const std::string& channel, const uint8_t* message,
+                 size_t message_size) {
+  const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  std::vector<uint8_t> buffer;
+  buffer.reserve(channel.size() + message_size + 16);
+  buffer.push_back(static_cast<uint8_t>(direction));
+  WriteVarint(&buffer, timestamp.count());
+  WriteVarint(&buffer, channel.size());
+  buffer.insert(buffer.end(), channel.begin(), channel.end());
+  WriteVarint(&buffer, message_size);
+  if (message_size > 0) {
+    buffer.insert(buffer.end(), message, message + message_size);
+  }
+  stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+}  // namespace
+
+RecordingMessenger::RecordingMessenger(flutter::BinaryMessenger* messenger,
+                                       const std::string& path)
+    : messenger_(messenger),
+      stream_(std::make_shared<std::ofstream>(
+          path, std::ios::binary | std::ios::trunc)),
+      start_time_(std::chrono::steady_clock::now()) {
+  stream_->write(reinterpret_cast<const char*>(kRecordingMagic),
+                 sizeof(kRecordingMagic));
+  stream_->write(reinterpret_cast<const char*>(&kRecordingVersion),
+                 sizeof(kRecordingVersion));
+}
+
+RecordingMessenger::~RecordingMessenger() { stream_->flush(); }
+
+void RecordingMessenger::Send(const std::string& channel,
+                              const uint8_t* message, size_t message_size,
+                              flutter::BinaryReply reply) const {
+  WriteRecord(*stream_, start_time_, Direction::kToFlutter, channel, message,
+              message_size);
+  messenger_->Send(channel, message, message_size, std::move(reply));
+}
+
+void RecordingMessenger::SetMessageHandler(
+    const std::string& channel, flutter::BinaryMessageHandler handler) {
+  if (!handler) {
+    messenger_->SetMessageHandler(channel, nullptr);
+    return;
+  }
+
+  messenger_->SetMessageHandler(
+      channel, [stream = stream_, start_time = start_time_, channel,
+                handler = std::move(handler)](const uint8_t* message,
+                                              size_t message_size,
+                                              flutter::BinaryReply reply) {
+        WriteRecord(*stream, start_time, Direction::kToHost, channel, message,
+                    message_size);
+        handler(message, message_size, std::move(reply));
+      });
+}
+
+}  // namespace testing
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_RECORDING_MESSENGER_H_
+#define PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_RECORDING_MESSENGER_H_
+
+#include <flutter/binary_messenger.h>
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace testing {
+
+// A BinaryMessenger that forwards all calls to another messenger, and writes
+// each message sent through it to a file so it can be replayed later.
+//
+// The file format is the same as the Linux RecordingMessenger, so recordings
+// can be replayed with the Linux MessageReplayer. The file starts with the
+// bytes "PGNR" and a version byte of 1, followed by one record per message:
+//   - the direction, as a single byte.
+//   - the time since the messenger was created in microseconds, as a varint.
+//   - the channel name length as a varint, followed by the UTF-8 name.
+//   - the payload length as a varint, followed by the encoded payload.
+//
+// This is a test utility of the platform tests, and is not part of the code
+// Pigeon generates; plugins can't use it to record their own traffic.
+class RecordingMessenger : public flutter::BinaryMessenger {
+ public:
+  // The direction of a recorded message.
+  enum class Direction : uint8_t {
+    // A message sent from Dart to a host handler.
+    kToHost = 0,
+    // A message sent from the host to Dart.
+    kToFlutter = 1,
+  };
+
+  // Creates a messenger that forwards to |messenger| and records to the file
+  // at |path|, replacing any existing file.
+  RecordingMessenger(flutter::BinaryMessenger* messenger,
+                     const std::string& path);
+  virtual ~RecordingMessenger();
+
+  // Returns false if the recording file could not be created.
+  bool is_open() const { return stream_->is_open(); }
+
+  // flutter::BinaryMessenger:
+  void Send(const std::string& channel, const uint8_t* message,
+            size_t message_size,
+            flutter::BinaryReply reply = nullptr) const override;
+  void SetMessageHandler(const std::string& channel,
+                         flutter::BinaryMessageHandler handler) override;
+
+ private:
+  flutter::BinaryMessenger* messenger_;
+  // Shared with the handlers registered on |messenger_|, which can outlive
+  // this messenger.
+  std::shared_ptr<std::ofstream> stream_;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+}  // namespace testing
+
+#endif  // PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_RECORDING_MESSENGER_H_
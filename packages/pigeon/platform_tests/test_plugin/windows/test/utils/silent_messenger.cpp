@@ -0,0 +1,23 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "silent_messenger.h"
+
+namespace testing {
+
+SilentMessenger::SilentMessenger() {}
+SilentMessenger::~SilentMessenger() {}
+
+// flutter::BinaryMessenger:
+void SilentMessenger::Send(const std::string& channel, const uint8_t* message,
+                           size_t message_size,
+                           flutter::BinaryReply reply) const {
+  replies_.push_back(std::move(reply));
+}
+
+void SilentMessenger::SetMessageHandler(const std::string& channel,
+                                        flutter::BinaryMessageHandler handler) {
+}
+
+}  // namespace testing
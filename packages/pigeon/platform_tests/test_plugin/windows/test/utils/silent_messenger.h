@@ -0,0 +1,39 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_SILENT_MESSENGER_H_
+#define PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_SILENT_MESSENGER_H_
+
+#include <flutter/binary_messenger.h>
+
+#include <vector>
+
+namespace testing {
+
+// A BinaryMessenger that never replies to the messages sent to it.
+//
+// The reply handlers are kept, as an engine waiting for Dart would, so tests
+// can check what they hold and reply late.
+class SilentMessenger : public flutter::BinaryMessenger {
+ public:
+  SilentMessenger();
+  virtual ~SilentMessenger();
+
+  // flutter::BinaryMessenger:
+  void Send(const std::string& channel, const uint8_t* message,
+            size_t message_size,
+            flutter::BinaryReply reply = nullptr) const override;
+  void SetMessageHandler(const std::string& channel,
+                         flutter::BinaryMessageHandler handler) override;
+
+  // The reply handlers of all messages sent, in the order they were sent.
+  const std::vector<flutter::BinaryReply>& replies() const { return replies_; }
+
+ private:
+  mutable std::vector<flutter::BinaryReply> replies_;
+};
+
+}  // namespace testing
+
+#endif  // PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_SILENT_MESSENGER_H_
@@ -132,6 +132,64 @@ void main() {
     }
   });
 
+  test('enums are encoded without an intermediate value', () {
+    final anEnum = Enum(
+      name: 'AnEnum',
+      members: <EnumMember>[EnumMember(name: 'one'), EnumMember(name: 'two')],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[
+        Class(
+          name: 'Output',
+          fields: <NamedType>[
+            NamedType(
+              type: TypeDeclaration(
+                baseName: anEnum.name,
+                isNullable: false,
+                associatedEnum: anEnum,
+              ),
+              name: 'code',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[anEnum],
+    );
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalCppOptions(
+        cppHeaderOut: '',
+        cppSourceOut: '',
+        headerIncludePath: '',
+      ),
+    );
+    generator.generate(
+      generatorOptions,
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(code, contains('constexpr uint8_t kEncodedInt32Type = 3;'));
+    expect(code, contains('if (enum_arg_type == kEncodedInt32Type) {'));
+    expect(
+      code,
+      contains(
+        'return CustomEncodableValue(static_cast<AnEnum>(stream->ReadInt32()));',
+      ),
+    );
+    expect(code, contains('stream->WriteByte(kEncodedInt32Type);'));
+    expect(
+      code,
+      contains(
+        'stream->WriteInt32(static_cast<int32_t>(std::any_cast<AnEnum>(*custom_value)));',
+      ),
+    );
+  });
+
   test('naming follows style', () {
     final anEnum = Enum(
       name: 'AnEnum',
@@ -2614,4 +2672,495 @@ void main() {
     );
     expect(code, contains('channel.Send'));
   });
+
+  test('synced arguments are sent as patches', () {
+    final syncedClass = Class(
+      name: 'State',
+      isSynced: true,
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'int', isNullable: false),
+          name: 'count',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'updateState',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'state',
+                  type: TypeDeclaration(
+                    baseName: 'State',
+                    isNullable: false,
+                    associatedClass: syncedClass,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[syncedClass],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(
+        generatorOptions,
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      // Snapshots are kept per channel, not per API instance.
+      expect(code, isNot(contains('snapshot')));
+      expect(code, contains('~Api();'));
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(
+        generatorOptions,
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      expect(code, contains('std::optional<EncodableList> CreateSyncedPatch('));
+      expect(
+        code,
+        contains(
+          'std::shared_ptr<std::shared_ptr<const EncodableList>> state_arg_snapshot = GetSyncedSnapshot(binary_messenger_, channel_name, 0);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'std::optional<EncodableList> state_arg_patch = CreateSyncedPatch(state_arg_snapshot.get(), state_arg.ToEncodableList());',
+        ),
+      );
+      expect(code, contains('*state_arg_snapshot = nullptr;'));
+      // Flutter asking for the full value resends it instead of failing.
+      expect(code, contains('if (state_arg_patch) {'));
+      expect(
+        code,
+        contains(
+          'arguments[0] = CustomEncodableValue(State::FromEncodableList(*state_arg_full));',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'CreateSyncedReplyHandler(&GetCodec(), std::move(resend_in_full), ',
+        ),
+      );
+      expect(code, contains('"synced-state-missing"'));
+      // Destroying the API forgets what it sent, since the messenger's
+      // address may be reused.
+      expect(code, contains('Api::~Api() {'));
+      expect(
+        code,
+        contains(
+          'ClearSyncedSnapshots(binary_messenger_, "dev.flutter.pigeon.test_package.Api.updateState" + message_channel_suffix_);',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+          cancellableFlutterApis: true,
+        ),
+      );
+      generator.generate(
+        generatorOptions,
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      // The full resend keeps the deadline and cancellation of the call.
+      expect(code, contains('pending_calls = pending_calls_, call_options'));
+      expect(
+        code,
+        contains(
+          'channel.Send(*encoded_api_arguments, pending_calls->Track(channel_name, std::move(reply), call_options));',
+        ),
+      );
+    }
+  });
+
+  test('compressed apis compress large messages', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'HostApi',
+          compressionThreshold: 1024,
+          methods: <Method>[
+            Method(
+              name: 'getValue',
+              location: ApiLocation.host,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration(
+                baseName: 'String',
+                isNullable: false,
+              ),
+            ),
+          ],
+        ),
+        AstFlutterApi(
+          name: 'FlutterApi',
+          compressionThreshold: 1024,
+          methods: <Method>[
+            Method(
+              name: 'setValue',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'value',
+                  type: const TypeDeclaration(
+                    baseName: 'String',
+                    isNullable: false,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalCppOptions(
+        cppHeaderOut: '',
+        cppSourceOut: '',
+        headerIncludePath: '',
+      ),
+    );
+    generator.generate(
+      generatorOptions,
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(code, contains('struct PigeonInternalCompressibleMessage {'));
+    expect(
+      code,
+      contains(
+        'EncodableValue PigeonInternalCompressMessage(EncodableValue value, size_t threshold) {',
+      ),
+    );
+    // Messages are only encoded once, by the codec that sends them.
+    expect(code, isNot(contains('.EncodeMessage(')));
+    expect(code, contains('WriteValue(message.value, &writer);'));
+    expect(
+      code,
+      contains(
+        'PigeonInternalCompressMessage(EncodableValue(std::move(wrapped)), 1024)',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'encoded_api_arguments = PigeonInternalCompressMessage(std::move(encoded_api_arguments), 1024);',
+      ),
+    );
+  });
+
+  test('cancellable flutter apis', () {
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'FlutterApi',
+          methods: <Method>[
+            Method(
+              name: 'getValue',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration(
+                baseName: 'int',
+                isNullable: false,
+              ),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    const generator = CppGenerator();
+    const languageOptions = InternalCppOptions(
+      cppHeaderOut: '',
+      cppSourceOut: '',
+      headerIncludePath: '',
+      cancellableFlutterApis: true,
+    );
+    {
+      final sink = StringBuffer();
+      generator.generate(
+        OutputFileOptions<InternalCppOptions>(
+          fileType: FileType.header,
+          languageOptions: languageOptions,
+        ),
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      expect(code, contains('class CancellationToken {'));
+      expect(code, contains('struct FlutterApiCallOptions {'));
+      expect(
+        code,
+        contains('const FlutterApiCallOptions& call_options = {});'),
+      );
+      expect(code, contains('size_t ReapExpiredCalls();'));
+      expect(
+        code,
+        contains(
+          'std::shared_ptr<PigeonInternalPendingCalls> pending_calls_;',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      generator.generate(
+        OutputFileOptions<InternalCppOptions>(
+          fileType: FileType.source,
+          languageOptions: languageOptions,
+        ),
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      expect(code, contains('class PigeonInternalPendingCalls {'));
+      expect(
+        code,
+        contains(
+          'pending_calls_(std::make_shared<PigeonInternalPendingCalls>())',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'if (call_options.cancellation_token && call_options.cancellation_token->is_cancelled()) {',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'channel.Send(encoded_api_arguments, pending_calls_->Track(channel_name, [',
+        ),
+      );
+      expect(code, contains('}, call_options));'));
+      expect(code, contains('return pending_calls_->ReapExpired();'));
+    }
+  });
+
+  test('flutter apis are not cancellable by default', () {
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'FlutterApi',
+          methods: <Method>[
+            Method(
+              name: 'getValue',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    generator.generate(
+      OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      ),
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(code, isNot(contains('CancellationToken')));
+    expect(code, isNot(contains('ReapExpiredCalls')));
+  });
+
+  test('channel name tables', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'HostApi',
+          methods: <Method>[
+            Method(
+              name: 'add',
+              location: ApiLocation.host,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'a',
+                  type: const TypeDeclaration(
+                    baseName: 'int',
+                    isNullable: false,
+                  ),
+                ),
+                Parameter(
+                  name: 'b',
+                  type: const TypeDeclaration(
+                    baseName: 'int',
+                    isNullable: true,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration(
+                baseName: 'int',
+                isNullable: false,
+              ),
+            ),
+          ],
+        ),
+        AstFlutterApi(
+          name: 'FlutterApi',
+          methods: <Method>[
+            Method(
+              name: 'noop',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+            Method(
+              name: 'getValue',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration(
+                baseName: 'String',
+                isNullable: true,
+              ),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    const generator = CppGenerator();
+    const languageOptions = InternalCppOptions(
+      cppHeaderOut: '',
+      cppSourceOut: '',
+      headerIncludePath: '',
+      channelNameTables: true,
+    );
+    {
+      final sink = StringBuffer();
+      generator.generate(
+        OutputFileOptions<InternalCppOptions>(
+          fileType: FileType.header,
+          languageOptions: languageOptions,
+        ),
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'std::shared_ptr<const std::vector<std::string>> channel_names_;',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      generator.generate(
+        OutputFileOptions<InternalCppOptions>(
+          fileType: FileType.source,
+          languageOptions: languageOptions,
+        ),
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      expect(
+        code,
+        contains('constexpr PigeonInternalMethodInfo kHostApiMethods[] = {'),
+      );
+      expect(
+        code,
+        contains(
+          '{"dev.flutter.pigeon.$DEFAULT_PACKAGE_NAME.HostApi.add", 2, "int add(int a, int? b)"},',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'BasicMessageChannel<> channel(binary_messenger, std::string(kHostApiMethods[0].channel_name) + prepended_suffix, &GetCodec());',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          '{"dev.flutter.pigeon.$DEFAULT_PACKAGE_NAME.FlutterApi.getValue", 0, "String? getValue()"},',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'channel_names_(PigeonInternalCreateChannelNames(kFlutterApiMethods, message_channel_suffix_))',
+        ),
+      );
+      expect(
+        code,
+        contains('const std::string& channel_name = (*channel_names_)[1];'),
+      );
+      expect(
+        code,
+        contains('on_error(CreateConnectionError((*channel_names)[1]));'),
+      );
+      expect(code, isNot(contains('+ message_channel_suffix_;')));
+    }
+  });
 }
@@ -2085,4 +2085,114 @@ name: foobar
     expect(code, contains('buffer.putUint8(4);'));
     expect(code, contains('buffer.putInt64(value);'));
   });
+
+  test('synced arguments accept patches', () {
+    final syncedClass = Class(
+      name: 'State',
+      isSynced: true,
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'int', isNullable: false),
+          name: 'count',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'updateState',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'state',
+                  type: TypeDeclaration(
+                    baseName: 'State',
+                    isNullable: false,
+                    associatedClass: syncedClass,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[syncedClass],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = DartGenerator();
+    generator.generate(
+      const InternalDartOptions(),
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(code, contains('List<Object?> _applySyncedPatch('));
+    expect(code, contains('State? pigeonVar_synced_arg_state;'));
+    expect(code, contains('if (pigeonVar_message_arg_state is List<Object?>)'));
+    expect(code, contains("code: 'synced-state-missing'"));
+  });
+
+  test('compressed apis decompress messages', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'HostApi',
+          compressionThreshold: 1024,
+          methods: <Method>[
+            Method(
+              name: 'getValue',
+              location: ApiLocation.host,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration(
+                baseName: 'String',
+                isNullable: false,
+              ),
+            ),
+          ],
+        ),
+        AstFlutterApi(
+          name: 'FlutterApi',
+          compressionThreshold: 1024,
+          methods: <Method>[
+            Method(
+              name: 'setValue',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'value',
+                  type: const TypeDeclaration(
+                    baseName: 'String',
+                    isNullable: false,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = DartGenerator();
+    generator.generate(
+      const InternalDartOptions(),
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(
+      code,
+      contains('Uint8List _decompressLz4(Uint8List input, int length) {'),
+    );
+    expect(code, contains('case 128: '));
+  });
 }
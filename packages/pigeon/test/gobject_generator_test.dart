@@ -539,6 +539,172 @@ void main() {
     }
   });
 
+  test('data classes store nullable primitives inline', () {
+    final anEnum = Enum(
+      name: 'AnEnum',
+      members: <EnumMember>[EnumMember(name: 'one'), EnumMember(name: 'two')],
+    );
+    final inputClass = Class(
+      name: 'Input',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'bool', isNullable: true),
+          name: 'nullableBool',
+        ),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'int', isNullable: true),
+          name: 'nullableInt',
+        ),
+        NamedType(
+          type: TypeDeclaration(
+            baseName: 'AnEnum',
+            isNullable: true,
+            associatedEnum: anEnum,
+          ),
+          name: 'nullableEnum',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[inputClass],
+      enums: <Enum>[anEnum],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = GObjectGenerator();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(
+        generatorOptions,
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+
+      expect(
+        code,
+        contains(
+          'int64_t* test_package_input_get_nullable_int(TestPackageInput* object);',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      const generator = GObjectGenerator();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(
+        generatorOptions,
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+
+      expect(code, contains('gboolean nullable_bool;'));
+      expect(code, contains('int64_t nullable_int;'));
+      expect(code, contains('TestPackageAnEnum nullable_enum;'));
+      expect(code, contains('guint has_nullable_int : 1;'));
+      expect(code, isNot(contains('malloc(sizeof(int64_t))')));
+      expect(code, isNot(contains('g_clear_pointer(&self->nullable_int')));
+      expect(code, contains('self->nullable_int = *nullable_int;'));
+      expect(
+        code,
+        contains(
+          'return self->has_nullable_int ? &self->nullable_int : nullptr;',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'self->has_nullable_int ? fl_value_new_int(self->nullable_int) : fl_value_new_null()',
+        ),
+      );
+    }
+  });
+
+  test('enums are encoded without an intermediate value', () {
+    final anEnum = Enum(
+      name: 'AnEnum',
+      members: <EnumMember>[EnumMember(name: 'one'), EnumMember(name: 'two')],
+    );
+    final inputClass = Class(
+      name: 'Input',
+      fields: <NamedType>[
+        NamedType(
+          type: TypeDeclaration(
+            baseName: 'AnEnum',
+            isNullable: false,
+            associatedEnum: anEnum,
+          ),
+          name: 'anEnum',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[inputClass],
+      enums: <Enum>[anEnum],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(
+      generatorOptions,
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+
+    expect(
+      code,
+      contains(
+        'fl_value_new_custom(test_package_an_enum_type_id, GINT_TO_POINTER(self->an_enum), nullptr)',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'static_cast<TestPackageAnEnum>(GPOINTER_TO_INT(fl_value_get_custom_value(value0)))',
+      ),
+    );
+    expect(code, isNot(contains('fl_value_new_int(self->an_enum)')));
+    expect(
+      code,
+      contains(
+        'return test_package_message_codec_write_enum_index(buffer, value);',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'if (!test_package_message_codec_read_enum_index(codec, buffer, offset, &index, error)) {',
+      ),
+    );
+  });
+
   test('host non-nullable return types map correctly', () {
     final returnDataClass = Class(
       name: 'ReturnData',
@@ -1035,4 +1201,435 @@ void main() {
       expect(code, contains('const int test_package_object_type_id = 131;'));
     }
   });
+
+  test('string keyed map fields have indexed lookups', () {
+    final inputClass = Class(
+      name: 'Input',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(
+            baseName: 'Map',
+            isNullable: false,
+            typeArguments: <TypeDeclaration>[
+              TypeDeclaration(baseName: 'String', isNullable: false),
+              TypeDeclaration(baseName: 'int', isNullable: true),
+            ],
+          ),
+          name: 'values',
+        ),
+        NamedType(
+          type: const TypeDeclaration(
+            baseName: 'Map',
+            isNullable: false,
+            typeArguments: <TypeDeclaration>[
+              TypeDeclaration(baseName: 'int', isNullable: false),
+              TypeDeclaration(baseName: 'String', isNullable: true),
+            ],
+          ),
+          name: 'byId',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[inputClass],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = GObjectGenerator();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(
+        generatorOptions,
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+
+      expect(
+        code,
+        contains(
+          'typedef void (*TestPackageInputValuesFunc)(const gchar* key, int64_t value, gpointer user_data);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'gboolean test_package_input_lookup_values(TestPackageInput* object, const gchar* key, int64_t* value);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'void test_package_input_foreach_values(TestPackageInput* object, TestPackageInputValuesFunc func, gpointer user_data);',
+        ),
+      );
+      expect(code, isNot(contains('test_package_input_lookup_by_id')));
+    }
+    {
+      final sink = StringBuffer();
+      const generator = GObjectGenerator();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(
+        generatorOptions,
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+
+      expect(code, contains('GHashTable* values_index;'));
+      expect(code, contains('size_t values_index_length;'));
+      expect(code, isNot(contains('by_id_index')));
+      expect(
+        code,
+        contains(
+          'self->values_index = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, nullptr);',
+        ),
+      );
+      // The index is rebuilt when entries are added to the map.
+      expect(
+        code,
+        contains(
+          'if (self->values_index == nullptr || self->values_index_length != length) {',
+        ),
+      );
+      // The first entry for a key is kept.
+      expect(
+        code,
+        contains(
+          '!g_hash_table_contains(self->values_index, fl_value_get_string(map_key))',
+        ),
+      );
+      expect(code, contains('*value = fl_value_get_int(map_value);'));
+      expect(
+        code,
+        contains(
+          'func(fl_value_get_string(map_key), fl_value_get_int(map_value), user_data);',
+        ),
+      );
+      expect(
+        code,
+        contains('g_clear_pointer(&self->values_index, g_hash_table_unref);'),
+      );
+      expect(code, contains('g_hash_table_lookup(self->values_index, key)'));
+    }
+  });
+
+  test('synced arguments are sent as patches', () {
+    final syncedClass = Class(
+      name: 'State',
+      isSynced: true,
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'int', isNullable: false),
+          name: 'count',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'updateState',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'state',
+                  type: TypeDeclaration(
+                    baseName: 'State',
+                    isNullable: false,
+                    associatedClass: syncedClass,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[syncedClass],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(
+      generatorOptions,
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(
+      code,
+      contains(
+        'static FlValue* test_package_make_synced_patch(const gchar* channel_key, int index, FlValue* values) {',
+      ),
+    );
+    expect(code, isNot(contains('snapshot;')));
+    expect(
+      code,
+      contains(
+        'g_autofree gchar* channel_key = g_strdup_printf("%p:%s", self->messenger, channel_name);',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'FlValue* state_patch = test_package_make_synced_patch(channel_key, 0, test_package_state_to_list(state));',
+      ),
+    );
+    expect(code, contains('if (state_patch != nullptr) {'));
+    expect(code, contains('call->full_message = fl_value_ref(full_args);'));
+    expect(code, contains('"synced-state-missing"'));
+    expect(
+      code,
+      contains(
+        'fl_basic_message_channel_send(call->channel, message, g_task_get_cancellable(task), test_package_synced_call_cb, task);',
+      ),
+    );
+    expect(
+      code,
+      contains('test_package_clear_synced_snapshots(call->channel_key);'),
+    );
+    expect(
+      code,
+      contains(
+        'g_autofree gchar* update_state_channel_key = g_strdup_printf("%p:dev.flutter.pigeon.test_package.Api.updateState%s", self->messenger, self->suffix);',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'test_package_clear_synced_snapshots(update_state_channel_key);',
+      ),
+    );
+  });
+
+  test('compressed apis compress large messages', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'HostApi',
+          compressionThreshold: 1024,
+          methods: <Method>[
+            Method(
+              name: 'getValue',
+              location: ApiLocation.host,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration(
+                baseName: 'String',
+                isNullable: false,
+              ),
+            ),
+          ],
+        ),
+        AstFlutterApi(
+          name: 'FlutterApi',
+          compressionThreshold: 1024,
+          methods: <Method>[
+            Method(
+              name: 'setValue',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'value',
+                  type: const TypeDeclaration(
+                    baseName: 'String',
+                    isNullable: false,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(
+      generatorOptions,
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(
+      code,
+      contains(
+        'static const uint8_t test_package_message_codec_compressed_message_type = 128;',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'static FlValue* test_package_message_codec_compress_message(FlValue* value, size_t threshold) {',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'g_autoptr(FlValue) message = test_package_message_codec_compress_message(response->value, 1024);',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'g_autoptr(FlValue) message = test_package_message_codec_compress_message(args, 1024);',
+      ),
+    );
+    // Messages are only encoded once, by the codec that sends them.
+    expect(code, isNot(contains('fl_message_codec_encode_message')));
+    expect(
+      code,
+      contains(
+        'g_autoptr(GByteArray) compressed = test_package_message_codec_compress_lz4(buffer->data + start, length);',
+      ),
+    );
+  });
+
+  test('result structs', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'HostApi',
+          methods: <Method>[
+            Method(
+              name: 'add',
+              location: ApiLocation.host,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'a',
+                  type: const TypeDeclaration(
+                    baseName: 'int',
+                    isNullable: false,
+                  ),
+                ),
+                Parameter(
+                  name: 'b',
+                  type: const TypeDeclaration(
+                    baseName: 'int',
+                    isNullable: false,
+                  ),
+                ),
+              ],
+              returnType: const TypeDeclaration(
+                baseName: 'int',
+                isNullable: false,
+              ),
+            ),
+            Method(
+              name: 'getName',
+              location: ApiLocation.host,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration(
+                baseName: 'String',
+                isNullable: false,
+              ),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    const generator = GObjectGenerator();
+    const languageOptions = InternalGObjectOptions(
+      headerIncludePath: '',
+      gobjectHeaderOut: '',
+      gobjectSourceOut: '',
+      resultStructs: true,
+    );
+    {
+      final sink = StringBuffer();
+      generator.generate(
+        OutputFileOptions<InternalGObjectOptions>(
+          fileType: FileType.header,
+          languageOptions: languageOptions,
+        ),
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      expect(code, contains('} TestPackageHostApiAddResult;'));
+      expect(code, contains('  int64_t return_value;'));
+      expect(
+        code,
+        contains(
+          'void (*add_with_result)(int64_t a, int64_t b, TestPackageHostApiAddResult* result, gpointer user_data);',
+        ),
+      );
+      expect(code, isNot(contains('TestPackageHostApiGetNameResult')));
+    }
+    {
+      final sink = StringBuffer();
+      generator.generate(
+        OutputFileOptions<InternalGObjectOptions>(
+          fileType: FileType.source,
+          languageOptions: languageOptions,
+        ),
+        root,
+        sink,
+        dartPackageName: DEFAULT_PACKAGE_NAME,
+      );
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'if (self->vtable == nullptr || (self->vtable->add == nullptr && self->vtable->add_with_result == nullptr)) {',
+        ),
+      );
+      expect(code, contains('TestPackageHostApiAddResult result = {};'));
+      expect(
+        code,
+        contains(
+          'self->vtable->add_with_result(a, b, &result, self->user_data);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'fl_value_append_take(response, fl_value_new_int(result.return_value));',
+        ),
+      );
+      expect(code, isNot(contains('get_name_with_result')));
+    }
+  });
 }
@@ -176,6 +176,14 @@ void main() {
     expect(opts.basePath, equals('./foo/'));
   });
 
+  test('parse args - cache-dir', () {
+    final PigeonOptions opts = Pigeon.parseArgs(<String>[
+      '--cache-dir',
+      './cache/',
+    ]);
+    expect(opts.cacheDir, equals('./cache/'));
+  });
+
   test('simple parse api', () {
     const code = '''
 class Input1 {
@@ -1497,6 +1505,115 @@ abstract class Api {
     await completer.future;
   });
 
+  group('generation cache', () {
+    const source = '''
+class Value {
+  String? name;
+}
+
+@HostApi()
+abstract class Api {
+  Value echo(Value value);
+}
+''';
+
+    late Directory dir;
+    late File input;
+
+    setUp(() {
+      dir = Directory.systemTemp.createTempSync();
+      input = File('${dir.path}/input.dart')..writeAsStringSync(source);
+    });
+
+    tearDown(() {
+      dir.deleteSync(recursive: true);
+    });
+
+    PigeonOptions optionsFor(String outDir, {String? cacheDir}) {
+      return PigeonOptions(
+        input: input.path,
+        dartOut: '${dir.path}/$outDir/input.g.dart',
+        cppHeaderOut: '${dir.path}/$outDir/input.g.h',
+        cppSourceOut: '${dir.path}/$outDir/input.g.cpp',
+        gobjectHeaderOut: '${dir.path}/$outDir/input.g.gobject.h',
+        gobjectSourceOut: '${dir.path}/$outDir/input.g.gobject.cc',
+        dartPackageName: 'pigeon_test',
+        cacheDir: cacheDir,
+      );
+    }
+
+    Map<String, List<int>> readOutputs(String outDir) {
+      return <String, List<int>>{
+        for (final FileSystemEntity entity
+            in Directory('${dir.path}/$outDir').listSync())
+          entity.uri.pathSegments.last: (entity as File).readAsBytesSync(),
+      };
+    }
+
+    test('cached outputs match uncached outputs', () async {
+      final cacheDir = '${dir.path}/cache';
+      expect(await Pigeon.runWithOptions(optionsFor('uncached')), 0);
+      expect(
+        await Pigeon.runWithOptions(
+          optionsFor('cached', cacheDir: cacheDir),
+        ),
+        0,
+      );
+      expect(Directory(cacheDir).listSync().length, 1);
+
+      // Restoring from the cache rewrites missing outputs.
+      Directory('${dir.path}/cached').deleteSync(recursive: true);
+      expect(
+        await Pigeon.runWithOptions(
+          optionsFor('cached', cacheDir: cacheDir),
+        ),
+        0,
+      );
+
+      final Map<String, List<int>> uncached = readOutputs('uncached');
+      final Map<String, List<int>> cached = readOutputs('cached');
+      expect(cached.keys, unorderedEquals(uncached.keys));
+      for (final String name in uncached.keys) {
+        expect(cached[name], uncached[name], reason: name);
+      }
+    });
+
+    test('changed input is regenerated', () async {
+      final cacheDir = '${dir.path}/cache';
+      expect(
+        await Pigeon.runWithOptions(optionsFor('out', cacheDir: cacheDir)),
+        0,
+      );
+      input.writeAsStringSync(source.replaceAll('echo', 'reply'));
+      expect(
+        await Pigeon.runWithOptions(optionsFor('out', cacheDir: cacheDir)),
+        0,
+      );
+
+      final String dartOut = File(
+        '${dir.path}/out/input.g.dart',
+      ).readAsStringSync();
+      expect(dartOut, contains('reply'));
+      expect(dartOut, isNot(contains('echo')));
+    });
+
+    test('runs inputs in parallel', () async {
+      final second = File('${dir.path}/second.dart')
+        ..writeAsStringSync(source);
+      final int result = await Pigeon.runAllWithOptions(<PigeonOptions>[
+        optionsFor('first'),
+        PigeonOptions(
+          input: second.path,
+          dartOut: '${dir.path}/second/second.g.dart',
+          dartPackageName: 'pigeon_test',
+        ),
+      ]);
+      expect(result, 0);
+      expect(File('${dir.path}/first/input.g.dart').existsSync(), isTrue);
+      expect(File('${dir.path}/second/second.g.dart').existsSync(), isTrue);
+    });
+  });
+
   test('unsupported non-positional parameters on FlutterApi', () {
     const code = '''
 @FlutterApi()
@@ -1857,4 +1974,49 @@ abstract class events {
       );
     });
   });
+
+  test('parse synced class', () {
+    const code = '''
+@Synced()
+class State {
+  int? count;
+}
+
+@FlutterApi()
+abstract class Api {
+  void update(State state);
+}
+''';
+    final ParseResults results = parseSource(code);
+    expect(results.errors.length, equals(0));
+    expect(results.root.classes.length, equals(1));
+    expect(results.root.classes[0].isSynced, isTrue);
+  });
+
+  test('parse compression threshold', () {
+    const code = '''
+@HostApi(compressionThreshold: 1024)
+abstract class Api {
+  String getValue();
+}
+''';
+    final ParseResults results = parseSource(code);
+    expect(results.errors.length, equals(0));
+    expect(results.root.apis[0].compressionThreshold, equals(1024));
+  });
+
+  test('compression threshold must be positive', () {
+    const code = '''
+@FlutterApi(compressionThreshold: 0)
+abstract class Api {
+  void setValue(String value);
+}
+''';
+    final ParseResults results = parseSource(code);
+    expect(results.errors.length, equals(1));
+    expect(
+      results.errors[0].message,
+      contains('compressionThreshold must be positive'),
+    );
+  });
 }
@@ -80,6 +80,7 @@ Future<int> generateTestPigeons({
   // TODO(stuartmorgan): Make this dynamic rather than hard-coded. Or eliminate
   // it entirely; see https://github.com/flutter/flutter/issues/115169.
   const inputs = <String>{
+    'compression_tests',
     'core_tests',
     'enum',
     'event_channel_tests',
@@ -31,18 +31,35 @@ const List<int> dataBlobSignature = <int>[0xFE, 0x52, 0x57, 0x44];
 ///  * [dataBlobSignature], which is the signature for binary data blobs.
 const List<int> libraryBlobSignature = <int>[0xFE, 0x52, 0x46, 0x57];
 
+/// The first four bytes of a version 2 Remote Flutter Widgets binary data
+/// blob.
+///
+/// This signature is added by [encodeDataBlob] when it is asked for version 2
+/// of the format, and is accepted by [decodeDataBlob].
+const List<int> dataBlobSignatureV2 = <int>[0xFE, 0x52, 0x57, 0x32];
+
+/// The first four bytes of a version 2 Remote Flutter Widgets binary library
+/// blob.
+///
+/// This signature is added by [encodeLibraryBlob] when it is asked for
+/// version 2 of the format, and is accepted by [decodeLibraryBlob].
+const List<int> libraryBlobSignatureV2 = <int>[0xFE, 0x52, 0x46, 0x32];
+
 /// Encode data as a Remote Flutter Widgets binary data blob.
 ///
+/// The `version` selects the version of the format; see [decodeLibraryBlob]
+/// for a description of each. Version 2 is smaller, but can only be decoded by
+/// versions of this package that support it.
+///
 /// See also:
 ///
 ///  * [decodeDataBlob], which decodes this format.
 ///  * [encodeLibraryBlob], which uses a superset of this format to encode
 ///    Remote Flutter Widgets binary library blobs.
-Uint8List encodeDataBlob(Object value) {
-  final encoder = _BlobEncoder();
-  encoder.writeSignature(dataBlobSignature);
+Uint8List encodeDataBlob(Object value, { int version = 1 }) {
+  final encoder = _BlobEncoder(version);
   encoder.writeValue(value);
-  return encoder.bytes.toBytes();
+  return encoder.toBytes(version == 1 ? dataBlobSignature : dataBlobSignatureV2);
 }
 
 /// Decode a Remote Flutter Widgets binary data blob.
@@ -56,7 +73,8 @@ Uint8List encodeDataBlob(Object value) {
 /// description of the format.
 ///
 /// The first four bytes of the file (in hex) are FE 52 57 44; see
-/// [dataBlobSignature].
+/// [dataBlobSignature]. Blobs in version 2 of the format start with FE 52 57
+/// 32 instead; see [dataBlobSignatureV2].
 ///
 /// See also:
 ///
@@ -66,7 +84,7 @@ Uint8List encodeDataBlob(Object value) {
 ///  * [parseDataFile], which parses the text variant of this format.
 Object decodeDataBlob(Uint8List bytes) {
   final decoder = _BlobDecoder(bytes.buffer.asByteData(bytes.offsetInBytes, bytes.lengthInBytes));
-  decoder.expectSignature(dataBlobSignature);
+  decoder.expectSignature(dataBlobSignature, dataBlobSignatureV2);
   final Object result = decoder.readValue();
   if (!decoder.finished) {
     throw const FormatException('Unexpected trailing bytes after value.');
@@ -76,17 +94,20 @@ Object decodeDataBlob(Uint8List bytes) {
 
 /// Encode data as a Remote Flutter Widgets binary library blob.
 ///
+/// The `version` selects the version of the format; see [decodeLibraryBlob]
+/// for a description of each. Version 2 is smaller, but can only be decoded by
+/// versions of this package that support it.
+///
 /// See also:
 ///
 ///  * [decodeLibraryBlob], which decodes this format.
 ///  * [encodeDataBlob], which uses a subset of this format to decode
 ///    Remote Flutter Widgets binary data blobs.
 ///  * [parseLibraryFile], which parses the text variant of this format.
-Uint8List encodeLibraryBlob(RemoteWidgetLibrary value) {
-  final encoder = _BlobEncoder();
-  encoder.writeSignature(libraryBlobSignature);
+Uint8List encodeLibraryBlob(RemoteWidgetLibrary value, { int version = 1 }) {
+  final encoder = _BlobEncoder(version);
   encoder.writeLibrary(value);
-  return encoder.bytes.toBytes();
+  return encoder.toBytes(version == 1 ? libraryBlobSignature : libraryBlobSignatureV2);
 }
 
 /// Decode a Remote Flutter Widgets binary library blob.
@@ -257,6 +278,39 @@ Uint8List encodeLibraryBlob(RemoteWidgetLibrary value) {
 ///   ([SetStateHandler.stateReference]), followed by the tagged value to which
 ///   to set that state entry ([SetStateHandler.value]).
 ///
+/// ## Version 2
+///
+/// Version 2 of the format has the same structure, but encodes numbers and
+/// strings more compactly. Files in this version start with FE 52 46 32
+/// instead (see [libraryBlobSignatureV2]), and differ as follows:
+///
+/// * Lengths, counts, and [LoopReference.loop] indices are encoded as
+///   unsigned LEB128 variable-length integers ("varints"): seven bits per byte,
+///   least significant group first, with the high bit of each byte set on all
+///   but the last byte. For example, 5 is encoded as 05, and 300 as AC 02.
+///
+/// * Integer values (tag 0x02, including integer parts of references) are
+///   zigzag encoded (0, -1, 1, -2, ... become 0, 1, 2, 3, ...) and then
+///   encoded as varints. For example, -1 is encoded as 01 and 1 as 02.
+///
+/// * Each distinct string is stored once, in a string table that immediately
+///   follows the signature: a varint count of strings, followed by that many
+///   strings, each a varint length followed by that many UTF-8 encoded bytes.
+///   Everywhere else, a string is encoded as a varint index into that table.
+///
+///   For example, the data blob for the map `{ a: 'a' }` is encoded as
+///   follows:
+///
+///   ```none
+///   FE 52 57 32 01 01 61 07  01 00 04 00
+///   ```
+///
+/// * Doubles are unchanged.
+///
+/// The decoder accepts both versions, and decodes each entry of the string
+/// table at most once, sharing the resulting [String] between every place it
+/// is used.
+///
 /// ## Limitations
 ///
 /// JavaScript does not have a native integer type; all numbers are stored as
@@ -277,7 +331,7 @@ Uint8List encodeLibraryBlob(RemoteWidgetLibrary value) {
 ///  * [parseDataFile], which parses the text variant of this format.
 RemoteWidgetLibrary decodeLibraryBlob(Uint8List bytes) {
   final decoder = _BlobDecoder(bytes.buffer.asByteData(bytes.offsetInBytes, bytes.lengthInBytes));
-  decoder.expectSignature(libraryBlobSignature);
+  decoder.expectSignature(libraryBlobSignature, libraryBlobSignatureV2);
   final RemoteWidgetLibrary result = decoder.readLibrary();
   if (!decoder.finished) {
     throw const FormatException('Unexpected trailing bytes after constructors.');
@@ -328,6 +382,15 @@ class _BlobDecoder {
 
   int _cursor = 0;
 
+  // The version of the format, determined by [expectSignature].
+  int _version = 1;
+
+  // The string table of a version 2 blob. Strings are decoded the first time
+  // they are used.
+  List<int> _stringOffsets = const <int>[];
+  List<int> _stringLengths = const <int>[];
+  List<String?> _strings = const <String?>[];
+
   bool get finished => _cursor >= bytes.lengthInBytes;
 
   void _advance(String context, int length) {
@@ -356,6 +419,55 @@ class _BlobDecoder {
     return a + (b * 0x100000000); // dead code on VM target
   }
 
+  int _readVarint() {
+    final int start = _cursor;
+    var result = 0;
+    var multiplier = 1;
+    for (var shift = 0; shift < 64; shift += 7) {
+      final int byteOffset = _cursor;
+      _advance('varint', 1);
+      final int byte = bytes.getUint8(byteOffset);
+      if (shift == 63 && byte > 1) {
+        // The tenth byte can only hold the 64th bit.
+        throw FormatException('Could not read varint at offset $start: value does not fit in 64 bits.');
+      }
+      if (_has64Bits) {
+        result |= (byte & 0x7F) << shift;
+      } else {
+        // We use multiplication rather than bit shifts because << truncates to 32 bits when compiled to JS.
+        result += (byte & 0x7F) * multiplier; // dead code on VM target
+        multiplier *= 0x80; // dead code on VM target
+      }
+      if ((byte & 0x80) == 0) {
+        return result;
+      }
+    }
+    throw FormatException('Could not read varint at offset $start: too many bytes.');
+  }
+
+  // Reads a length, count, or loop index.
+  int _readLength() {
+    final int byteOffset = _cursor;
+    final int value = _version == 1 ? _readInt64() : _readVarint();
+    if (value < 0) {
+      // Lengths past 63 bits wrap around to negative values.
+      throw FormatException('Invalid length $value at offset $byteOffset while decoding blob.');
+    }
+    return value;
+  }
+
+  // Reads an integer value.
+  int _readInteger() {
+    if (_version == 1) {
+      return _readInt64();
+    }
+    final int value = _readVarint();
+    if (_has64Bits) {
+      return (value >>> 1) ^ -(value & 1);
+    }
+    return value.isEven ? value ~/ 2 : -(value + 1) ~/ 2; // dead code on VM target
+  }
+
   double _readBinary64() {
     final int byteOffset = _cursor;
     _advance('binary64', 8);
@@ -363,20 +475,47 @@ class _BlobDecoder {
   }
 
   String _readString() {
-    final int length = _readInt64();
+    if (_version == 1) {
+      final int length = _readLength();
+      final int byteOffset = _cursor;
+      _advance('string', length);
+      return _decodeString(byteOffset, length);
+    }
     final int byteOffset = _cursor;
-    _advance('string', length);
+    final int index = _readVarint();
+    if (index < 0 || index >= _strings.length) {
+      throw FormatException('Invalid string index $index at offset $byteOffset while decoding blob.');
+    }
+    return _strings[index] ??= _decodeString(_stringOffsets[index], _stringLengths[index]);
+  }
+
+  String _decodeString(int byteOffset, int length) {
     return utf8.decode(bytes.buffer.asUint8List(bytes.offsetInBytes + byteOffset, length));
   }
 
+  void _readStringTable() {
+    final int count = _readLength();
+    final offsets = <int>[];
+    final lengths = <int>[];
+    for (var index = 0; index < count; index += 1) {
+      final int length = _readLength();
+      offsets.add(_cursor);
+      lengths.add(length);
+      _advance('string', length);
+    }
+    _stringOffsets = offsets;
+    _stringLengths = lengths;
+    _strings = List<String?>.filled(count, null);
+  }
+
   List<Object> _readPartList() {
-    return List<Object>.generate(_readInt64(), (int index) {
+    return List<Object>.generate(_readLength(), (int index) {
       final int type = _readByte();
       switch (type) {
         case _msString:
           return _readString();
         case _msInt64:
-          return _readInt64();
+          return _readInteger();
         default:
           throw FormatException('Invalid reference type 0x${type.toRadixString(16).toUpperCase().padLeft(2, "0")} while decoding blob.');
       }
@@ -384,7 +523,7 @@ class _BlobDecoder {
   }
 
   Map<String, Object?>? _readMap(Object Function() readNode, { bool nullIfEmpty = false }) {
-    final int count = _readInt64();
+    final int count = _readLength();
     if (count == 0 && nullIfEmpty) {
       return null;
     }
@@ -409,7 +548,7 @@ class _BlobDecoder {
 
   Switch _readSwitch() {
     final Object value = _readArgument();
-    final int count = _readInt64();
+    final int count = _readLength();
     final cases = Map<Object?, Object>.fromEntries(
       Iterable<MapEntry<Object?, Object>>.generate(
         count,
@@ -429,13 +568,13 @@ class _BlobDecoder {
       case _msTrue:
         return true;
       case _msInt64:
-        return _readInt64();
+        return _readInteger();
       case _msBinary64:
         return _readBinary64();
       case _msString:
         return _readString();
       case _msList:
-        return DynamicList.generate(_readInt64(), (int index) => readNode());
+        return DynamicList.generate(_readLength(), (int index) => readNode());
       case _msMap:
         return _readMap(readNode)!;
       default: throw FormatException('Unrecognized data type 0x${type.toRadixString(16).toUpperCase().padLeft(2, "0")} while decoding blob.');
@@ -458,7 +597,7 @@ class _BlobDecoder {
       case _msDataReference:
         return DataReference(_readPartList());
       case _msLoopReference:
-        return LoopReference(_readInt64(), _readPartList());
+        return LoopReference(_readLength(), _readPartList());
       case _msStateReference:
         return StateReference(_readPartList());
       case _msEvent:
@@ -513,31 +652,43 @@ class _BlobDecoder {
   }
 
   List<WidgetDeclaration> _readDeclarationList() {
-    return List<WidgetDeclaration>.generate(_readInt64(), (int index) => _readDeclaration());
+    return List<WidgetDeclaration>.generate(_readLength(), (int index) => _readDeclaration());
   }
 
   Import _readImport() {
-    return Import(LibraryName(List<String>.generate(_readInt64(), (int index) => _readString())));
+    return Import(LibraryName(List<String>.generate(_readLength(), (int index) => _readString())));
   }
 
   List<Import> _readImportList() {
-    return List<Import>.generate(_readInt64(), (int index) => _readImport());
+    return List<Import>.generate(_readLength(), (int index) => _readImport());
   }
 
   RemoteWidgetLibrary readLibrary() {
     return RemoteWidgetLibrary(_readImportList(), _readDeclarationList());
   }
 
-  void expectSignature(List<int> signature) {
+  /// Reads the signature, which must be either `signature` (for version 1 of
+  /// the format) or `signatureV2` (for version 2).
+  void expectSignature(List<int> signature, List<int> signatureV2) {
     assert(signature.length == 4);
+    assert(signatureV2.length == 4);
     final bytes = <int>[];
     var match = true;
-    for (final byte in signature) {
+    var matchV2 = true;
+    for (var index = 0; index < signature.length; index += 1) {
       final int read = _readByte();
       bytes.add(read);
-      if (read != byte) {
+      if (read != signature[index]) {
         match = false;
       }
+      if (read != signatureV2[index]) {
+        matchV2 = false;
+      }
+    }
+    if (matchV2) {
+      _version = 2;
+      _readStringTable();
+      return;
     }
     if (!match) {
       throw FormatException(
@@ -555,9 +706,20 @@ class _BlobDecoder {
 ///
 /// Binary library blobs can be serialized using [writeLibrary].
 ///
-/// The output is in [bytes], and can be cleared manually to reuse the [_BlobEncoder].
+/// The output is returned by [toBytes], which also resets the [_BlobEncoder] so
+/// that it can be reused.
 class _BlobEncoder {
-  _BlobEncoder();
+  _BlobEncoder(this.version) {
+    if (version != 1 && version != 2) {
+      throw ArgumentError.value(version, 'version', 'Unsupported blob format version');
+    }
+  }
+
+  /// The version of the format to encode.
+  final int version;
+
+  // The index of each string in the string table of a version 2 blob.
+  final Map<String, int> _stringIndices = <String, int>{};
 
   static final Uint8List _scratchOut = Uint8List(8);
   static final ByteData _scratchIn = _scratchOut.buffer.asByteData(_scratchOut.offsetInBytes, _scratchOut.lengthInBytes);
@@ -581,14 +743,56 @@ class _BlobEncoder {
     bytes.add(_scratchOut);
   }
 
+  static void _writeVarint(BytesBuilder output, int value) {
+    if (_has64Bits) {
+      // Negative values are encoded as their unsigned 64 bit equivalent.
+      while ((value & ~0x7F) != 0) {
+        output.addByte((value & 0x7F) | 0x80);
+        value >>>= 7;
+      }
+    } else {
+      // We use division rather than bit shifts because >> truncates to 32 bits when compiled to JS.
+      assert(value >= 0); // dead code on VM target
+      while (value >= 0x80) { // dead code on VM target
+        output.addByte((value % 0x80) | 0x80); // dead code on VM target
+        value = value ~/ 0x80; // dead code on VM target
+      }
+    }
+    output.addByte(value);
+  }
+
+  // Writes a length, count, or loop index.
+  void _writeLength(int value) {
+    if (version == 1) {
+      _writeInt64(value);
+    } else {
+      _writeVarint(bytes, value);
+    }
+  }
+
+  // Writes an integer value.
+  void _writeInteger(int value) {
+    if (version == 1) {
+      _writeInt64(value);
+    } else if (_has64Bits) {
+      _writeVarint(bytes, (value << 1) ^ (value >> 63));
+    } else {
+      _writeVarint(bytes, value >= 0 ? value * 2 : -value * 2 - 1); // dead code on VM target
+    }
+  }
+
   void _writeString(String value) {
-    final Uint8List buffer = const Utf8Encoder().convert(value);
-    _writeInt64(buffer.length);
-    bytes.add(buffer);
+    if (version == 1) {
+      final Uint8List buffer = const Utf8Encoder().convert(value);
+      _writeLength(buffer.length);
+      bytes.add(buffer);
+    } else {
+      _writeVarint(bytes, _stringIndices.putIfAbsent(value, () => _stringIndices.length));
+    }
   }
 
   void _writeMap(DynamicMap value, void Function(Object? value) recurse) {
-    _writeInt64(value.length);
+    _writeLength(value.length);
     value.forEach((String key, Object? value) {
       _writeString(key);
       recurse(value);
@@ -598,7 +802,7 @@ class _BlobEncoder {
   void _writePart(Object? value) {
     if (value is int) {
       bytes.addByte(_msInt64);
-      _writeInt64(value);
+      _writeInteger(value);
     } else if (value is String) {
       bytes.addByte(_msString);
       _writeString(value);
@@ -618,7 +822,7 @@ class _BlobEncoder {
       bytes.add(_scratchOut);
     } else if (value is DynamicList) {
       bytes.addByte(_msList);
-      _writeInt64(value.length);
+      _writeLength(value.length);
       value.forEach(recurse);
     } else if (value is DynamicMap) {
       bytes.addByte(_msMap);
@@ -647,25 +851,25 @@ class _BlobEncoder {
       _writeArgument(value.widget);
     } else if (value is ArgsReference) {
       bytes.addByte(_msArgsReference);
-      _writeInt64(value.parts.length);
+      _writeLength(value.parts.length);
       value.parts.forEach(_writePart);
     } else if (value is DataReference) {
       bytes.addByte(_msDataReference);
-      _writeInt64(value.parts.length);
+      _writeLength(value.parts.length);
       value.parts.forEach(_writePart);
     } else if (value is WidgetBuilderArgReference) {
       bytes.addByte(_msWidgetBuilderArgReference);
       _writeString(value.argumentName);
-      _writeInt64(value.parts.length);
+      _writeLength(value.parts.length);
       value.parts.forEach(_writePart);
     } else if (value is LoopReference) {
       bytes.addByte(_msLoopReference);
-      _writeInt64(value.loop);
-      _writeInt64(value.parts.length);
+      _writeLength(value.loop);
+      _writeLength(value.parts.length);
       value.parts.forEach(_writePart);
     } else if (value is StateReference) {
       bytes.addByte(_msStateReference);
-      _writeInt64(value.parts.length);
+      _writeLength(value.parts.length);
       value.parts.forEach(_writePart);
     } else if (value is EventHandler) {
       bytes.addByte(_msEvent);
@@ -674,7 +878,7 @@ class _BlobEncoder {
     } else if (value is Switch) {
       bytes.addByte(_msSwitch);
       _writeArgument(value.input);
-      _writeInt64(value.outputs.length);
+      _writeLength(value.outputs.length);
       value.outputs.forEach((Object? key, Object value) {
         if (key == null) {
           bytes.addByte(_msDefault);
@@ -686,7 +890,7 @@ class _BlobEncoder {
     } else if (value is SetStateHandler) {
       bytes.addByte(_msSetState);
       final reference = value.stateReference as StateReference;
-      _writeInt64(reference.parts.length);
+      _writeLength(reference.parts.length);
       reference.parts.forEach(_writePart);
       _writeArgument(value.value);
     } else {
@@ -696,22 +900,22 @@ class _BlobEncoder {
   }
 
   void _writeDeclarationList(List<WidgetDeclaration> value) {
-    _writeInt64(value.length);
+    _writeLength(value.length);
     for (final declaration in value) {
       _writeString(declaration.name);
       if (declaration.initialState != null) {
         _writeMap(declaration.initialState!, _writeArgument);
       } else {
-        _writeInt64(0);
+        _writeLength(0);
       }
       _writeArgument(declaration.root);
     }
   }
 
   void _writeImportList(List<Import> value) {
-    _writeInt64(value.length);
+    _writeLength(value.length);
     for (final import in value) {
-      _writeInt64(import.name.parts.length);
+      _writeLength(import.name.parts.length);
       import.name.parts.forEach(_writeString);
     }
   }
@@ -721,8 +925,21 @@ class _BlobEncoder {
     _writeDeclarationList(library.widgets);
   }
 
-  void writeSignature(List<int> signature) {
+  /// Returns the encoded blob, starting with `signature`.
+  Uint8List toBytes(List<int> signature) {
     assert(signature.length == 4);
-    bytes.add(signature);
+    final output = BytesBuilder(copy: false);
+    output.add(signature);
+    if (version == 2) {
+      _writeVarint(output, _stringIndices.length);
+      for (final String value in _stringIndices.keys) {
+        final Uint8List buffer = const Utf8Encoder().convert(value);
+        _writeVarint(output, buffer.length);
+        output.add(buffer);
+      }
+    }
+    output.add(bytes.takeBytes());
+    _stringIndices.clear();
+    return output.takeBytes();
   }
 }
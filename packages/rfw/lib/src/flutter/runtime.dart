@@ -657,6 +657,136 @@ class _ResolvedDynamicList {
   final int? length; // might be null if result is not null
 }
 
+/// The positions of the entries of a list once its loops have been expanded.
+class _LoopExpansion {
+  _LoopExpansion(this.offsets, this.inputs, this.length);
+
+  /// The index in the expanded list of the first value produced by each entry
+  /// of the list, followed by [length].
+  ///
+  /// Null if the list has no loops.
+  final List<int>? offsets;
+
+  /// The list each loop in the list iterates over, or null for entries that
+  /// are not loops.
+  final List<DynamicList?>? inputs;
+
+  /// The length of the expanded list.
+  final int length;
+
+  /// The subscriptions used to compute the expansion.
+  List<_Subscription> dependencies = const <_Subscription>[];
+}
+
+/// A cache of [_LoopExpansion]s, keyed on the identity of the list.
+///
+/// Entries are only valid while the values the loops iterate over are
+/// unchanged, so the cache must be cleared whenever a subscription those
+/// values were obtained from is updated.
+class _LoopExpansionCache {
+  _LoopExpansionCache(this._dependencies);
+
+  // The list that subscriptions are recorded in while fetching a value, or
+  // null if the cache does not outlive a single fetch.
+  //
+  // Reusing an expansion skips the resolver calls that computed it, so the
+  // subscriptions they recorded are added again.
+  final List<_Subscription>? _dependencies;
+
+  // Expandos hold their keys weakly, so lists that are created while resolving
+  // values (e.g. when binding loop variables) do not accumulate here.
+  Expando<_LoopExpansion> _expansions = Expando<_LoopExpansion>();
+
+  _LoopExpansion expand(DynamicList list, _LoopExpansion Function() compute) {
+    final _LoopExpansion? cached = _expansions[list];
+    if (cached != null) {
+      _dependencies?.addAll(cached.dependencies);
+      return cached;
+    }
+    final int start = _dependencies?.length ?? 0;
+    final _LoopExpansion expansion = compute();
+    if (_dependencies != null) {
+      expansion.dependencies = _dependencies.sublist(start);
+    }
+    _expansions[list] = expansion;
+    return expansion;
+  }
+
+  void clear() {
+    _expansions = Expando<_LoopExpansion>();
+  }
+}
+
+/// A view of a [DynamicMap] in the output of a loop, in which references to
+/// the loop variable are bound to one value of the loop's input.
+///
+/// Values are bound when they are first read rather than when the loop is
+/// expanded, so each value of a loop shares the output template and only
+/// allocates the parts of it that are used.
+class _LoopBoundMap extends UnmodifiableMapBase<String, Object?> {
+  _LoopBoundMap(this._template, this._argument, this._depth);
+
+  final DynamicMap _template;
+  final Object _argument;
+  final int _depth;
+
+  Map<String, Object?>? _values;
+
+  @override
+  Object? operator [](Object? key) {
+    final Object? value = _template[key];
+    if (value == null) {
+      return null;
+    }
+    return (_values ??= <String, Object?>{}).putIfAbsent(
+      key! as String,
+      () => _CurriedWidget._bindLoopVariable(value, _argument, _depth),
+    );
+  }
+
+  @override
+  bool containsKey(Object? key) => _template.containsKey(key);
+
+  @override
+  Iterable<String> get keys => _template.keys;
+
+  @override
+  int get length => _template.length;
+}
+
+/// A view of a [DynamicList] in the output of a loop, in which references to
+/// the loop variable are bound to one value of the loop's input.
+///
+/// See [_LoopBoundMap].
+class _LoopBoundList extends ListBase<Object?> {
+  _LoopBoundList(this._template, this._argument, this._depth);
+
+  final DynamicList _template;
+  final Object _argument;
+  final int _depth;
+
+  List<Object?>? _values;
+
+  @override
+  Object? operator [](int index) {
+    final List<Object?> values = _values ??= List<Object?>.filled(_template.length, null);
+    return values[index] ??= _CurriedWidget._bindLoopVariable(_template[index]!, _argument, _depth);
+  }
+
+  @override
+  void operator []=(int index, Object? value) {
+    throw UnsupportedError('Cannot modify the output of a loop.');
+  }
+
+  @override
+  int get length => _template.length;
+
+  @override
+  set length(int newLength) {
+    throw UnsupportedError('Cannot modify the output of a loop.');
+  }
+}
+
 typedef _DataResolverCallback = Object Function(List<Object> dataKey);
 typedef _StateResolverCallback = Object Function(List<Object> stateKey, int depth);
 typedef _WidgetBuilderArgResolverCallback = Object Function(List<Object> argKey);
@@ -676,16 +806,10 @@ abstract class _CurriedWidget extends BlobNode {
 
   static Object _bindLoopVariable(Object node, Object argument, int depth) {
     if (node is DynamicMap) {
-      return node.map<String, Object?>(
-        (String name, Object? value) => MapEntry<String, Object?>(name, _bindLoopVariable(value!, argument, depth)),
-      );
+      return _LoopBoundMap(node, argument, depth);
     }
     if (node is DynamicList) {
-      return List<Object>.generate(
-        node.length,
-        (int index) => _bindLoopVariable(node[index]!, argument, depth),
-        growable: false,
-      );
+      return _LoopBoundList(node, argument, depth);
     }
     if (node is Loop) {
       return Loop(_bindLoopVariable(node.input, argument, depth), _bindLoopVariable(node.output, argument, depth + 1))
@@ -753,67 +877,34 @@ abstract class _CurriedWidget extends BlobNode {
   ///
   /// If `targetEffectiveIndex` is -1, this evaluates the entire list to ensure
   /// the length is available.
-  //
-  // TODO(ianh): This really should have some sort of caching. Right now, evaluating a whole list
-  // ends up being around O(N^2) since we have to walk the list from the start for every entry.
+  ///
+  /// If a `cache` is provided, the positions of the entries of `list` in the
+  /// expanded list are computed once and reused by later lookups, so that
+  /// evaluating a whole list is O(N log N) rather than O(N^2).
   static _ResolvedDynamicList _listLookup(
     DynamicList list,
     int targetEffectiveIndex,
     _StateResolverCallback stateResolver,
     _DataResolverCallback dataResolver,
     _WidgetBuilderArgResolverCallback widgetBuilderArgResolver,
+    _LoopExpansionCache? cache,
   ) {
+    if (cache != null) {
+      return _cachedListLookup(list, targetEffectiveIndex, stateResolver, dataResolver, widgetBuilderArgResolver, cache);
+    }
     var currentIndex = 0; // where we are in `list` (some entries of which might represent multiple values, because they are themselves loops)
     var effectiveIndex = 0; // where we are in the fully expanded list (the coordinate space in which we're aiming for `targetEffectiveIndex`)
     while ((effectiveIndex <= targetEffectiveIndex || targetEffectiveIndex < 0) && currentIndex < list.length) {
       final Object node = list[currentIndex]!;
       if (node is Loop) {
-        Object inputList = node.input;
-        while (inputList is! DynamicList) {
-          if (inputList is BoundArgsReference) {
-            inputList = _resolveFrom(
-              inputList.arguments,
-              inputList.parts,
-              stateResolver,
-              dataResolver,
-              widgetBuilderArgResolver,
-            );
-          } else if (inputList is DataReference) {
-            inputList = dataResolver(inputList.parts);
-          } else if (inputList is WidgetBuilderArgReference) {
-            inputList = widgetBuilderArgResolver(
-              <Object>[inputList.argumentName, ...inputList.parts],
-            );
-          } else if (inputList is BoundStateReference) {
-            inputList = stateResolver(inputList.parts, inputList.depth);
-          } else if (inputList is BoundLoopReference) {
-            inputList = _resolveFrom(
-              inputList.value,
-              inputList.parts,
-              stateResolver,
-              dataResolver,
-              widgetBuilderArgResolver,
-            );
-          } else if (inputList is Switch) {
-            inputList = _resolveFrom(
-              inputList,
-              const <Object>[],
-              stateResolver,
-              dataResolver,
-              widgetBuilderArgResolver,
-            );
-          } else {
-            // e.g. it's a map or something else that isn't indexable
-            inputList = DynamicList.empty();
-          }
-          assert(inputList is! _ResolvedDynamicList);
-        }
+        final DynamicList inputList = _resolveLoopInput(node, stateResolver, dataResolver, widgetBuilderArgResolver, null);
         final _ResolvedDynamicList entry = _listLookup(
           inputList,
           targetEffectiveIndex >= 0 ? targetEffectiveIndex - effectiveIndex : -1,
           stateResolver,
           dataResolver,
           widgetBuilderArgResolver,
+          null,
         );
         if (entry.result != null) {
           final Object boundResult = _bindLoopVariable(node.output, entry.result!, 0);
@@ -831,12 +922,131 @@ abstract class _CurriedWidget extends BlobNode {
     return _ResolvedDynamicList(list, null, effectiveIndex);
   }
 
+  static _ResolvedDynamicList _cachedListLookup(
+    DynamicList list,
+    int targetEffectiveIndex,
+    _StateResolverCallback stateResolver,
+    _DataResolverCallback dataResolver,
+    _WidgetBuilderArgResolverCallback widgetBuilderArgResolver,
+    _LoopExpansionCache cache,
+  ) {
+    final _LoopExpansion expansion = cache.expand(list, () {
+      if (!list.any((Object? entry) => entry is Loop)) {
+        return _LoopExpansion(null, null, list.length);
+      }
+      final offsets = List<int>.filled(list.length + 1, 0);
+      final inputs = List<DynamicList?>.filled(list.length, null);
+      var effectiveIndex = 0;
+      for (var index = 0; index < list.length; index += 1) {
+        offsets[index] = effectiveIndex;
+        final Object node = list[index]!;
+        if (node is Loop) {
+          final DynamicList inputList = _resolveLoopInput(node, stateResolver, dataResolver, widgetBuilderArgResolver, cache);
+          inputs[index] = inputList;
+          effectiveIndex += _listLookup(inputList, -1, stateResolver, dataResolver, widgetBuilderArgResolver, cache).length!;
+        } else {
+          effectiveIndex += 1;
+        }
+      }
+      offsets[list.length] = effectiveIndex;
+      return _LoopExpansion(offsets, inputs, effectiveIndex);
+    });
+    if (targetEffectiveIndex < 0 || targetEffectiveIndex >= expansion.length) {
+      return _ResolvedDynamicList(list, null, expansion.length);
+    }
+    final List<int>? offsets = expansion.offsets;
+    if (offsets == null) {
+      return _ResolvedDynamicList(null, list[targetEffectiveIndex], null);
+    }
+    // Find the last entry of `list` that starts at or before the target. Loops
+    // over empty lists share their offset with the next entry, so this skips
+    // past them.
+    var low = 0;
+    var high = list.length - 1;
+    while (low < high) {
+      final int middle = (low + high + 1) >> 1;
+      if (offsets[middle] <= targetEffectiveIndex) {
+        low = middle;
+      } else {
+        high = middle - 1;
+      }
+    }
+    final Object node = list[low]!;
+    if (node is Loop) {
+      final _ResolvedDynamicList entry = _listLookup(
+        expansion.inputs![low]!,
+        targetEffectiveIndex - offsets[low],
+        stateResolver,
+        dataResolver,
+        widgetBuilderArgResolver,
+        cache,
+      );
+      assert(entry.result != null);
+      return _ResolvedDynamicList(null, _bindLoopVariable(node.output, entry.result!, 0), null);
+    }
+    return _ResolvedDynamicList(null, node, null);
+  }
+
+  static DynamicList _resolveLoopInput(
+    Loop node,
+    _StateResolverCallback stateResolver,
+    _DataResolverCallback dataResolver,
+    _WidgetBuilderArgResolverCallback widgetBuilderArgResolver,
+    _LoopExpansionCache? cache,
+  ) {
+    Object inputList = node.input;
+    while (inputList is! DynamicList) {
+      if (inputList is BoundArgsReference) {
+        inputList = _resolveFrom(
+          inputList.arguments,
+          inputList.parts,
+          stateResolver,
+          dataResolver,
+          widgetBuilderArgResolver,
+          cache,
+        );
+      } else if (inputList is DataReference) {
+        inputList = dataResolver(inputList.parts);
+      } else if (inputList is WidgetBuilderArgReference) {
+        inputList = widgetBuilderArgResolver(
+          <Object>[inputList.argumentName, ...inputList.parts],
+        );
+      } else if (inputList is BoundStateReference) {
+        inputList = stateResolver(inputList.parts, inputList.depth);
+      } else if (inputList is BoundLoopReference) {
+        inputList = _resolveFrom(
+          inputList.value,
+          inputList.parts,
+          stateResolver,
+          dataResolver,
+          widgetBuilderArgResolver,
+          cache,
+        );
+      } else if (inputList is Switch) {
+        inputList = _resolveFrom(
+          inputList,
+          const <Object>[],
+          stateResolver,
+          dataResolver,
+          widgetBuilderArgResolver,
+          cache,
+        );
+      } else {
+        // e.g. it's a map or something else that isn't indexable
+        inputList = DynamicList.empty();
+      }
+      assert(inputList is! _ResolvedDynamicList);
+    }
+    return inputList;
+  }
+
   static Object _resolveFrom(
     Object root,
     List<Object> parts,
     _StateResolverCallback stateResolver,
     _DataResolverCallback dataResolver,
     _WidgetBuilderArgResolverCallback widgetBuilderArgResolver,
+    _LoopExpansionCache? cache,
   ) {
     var index = 0;
     var current = root;
@@ -883,6 +1093,7 @@ abstract class _CurriedWidget extends BlobNode {
           stateResolver,
           dataResolver,
           widgetBuilderArgResolver,
+          cache,
         );
         Object? value = current.outputs[key];
         if (value == null) {
@@ -899,12 +1110,12 @@ abstract class _CurriedWidget extends BlobNode {
         if (current is EventHandler) {
           current = EventHandler(
             current.eventName,
-            _fix(current.eventArguments, stateResolver, dataResolver, widgetBuilderArgResolver) as DynamicMap,
+            _fix(current.eventArguments, stateResolver, dataResolver, widgetBuilderArgResolver, cache) as DynamicMap,
           );
         } else if (current is SetStateHandler) {
           current = SetStateHandler(
             current.stateReference,
-            _fix(current.value, stateResolver, dataResolver, widgetBuilderArgResolver),
+            _fix(current.value, stateResolver, dataResolver, widgetBuilderArgResolver, cache),
           );
         }
         // else `current` is nothing special, and we'll just return it below.
@@ -927,6 +1138,7 @@ abstract class _CurriedWidget extends BlobNode {
           stateResolver,
           dataResolver,
           widgetBuilderArgResolver,
+          cache,
         ).result ?? missing;
       } else {
         assert(current is! ArgsReference);
@@ -947,40 +1159,47 @@ abstract class _CurriedWidget extends BlobNode {
     _StateResolverCallback stateResolver,
     _DataResolverCallback dataResolver,
     _WidgetBuilderArgResolverCallback widgetBuilderArgResolver,
+    _LoopExpansionCache? cache,
   ) {
     if (root is DynamicMap) {
       return root.map((String key, Object? value) =>
         MapEntry<String, Object?>(
           key,
-          _fix(root[key]!, stateResolver, dataResolver, widgetBuilderArgResolver),
+          _fix(root[key]!, stateResolver, dataResolver, widgetBuilderArgResolver, cache),
         ),
       );
     } else if (root is DynamicList) {
       if (root.any((Object? entry) => entry is Loop)) {
+        // Without a cache each lookup below would walk the list from the
+        // start. A temporary one is enough here, since all the lookups happen
+        // while the same values are being resolved.
+        final _LoopExpansionCache listCache = cache ?? _LoopExpansionCache(null);
         final int length = _listLookup(
           root,
           -1,
           stateResolver,
           dataResolver,
           widgetBuilderArgResolver,
+          listCache,
         ).length!;
         return DynamicList.generate(
           length,
           (int index) => _fix(
-            _listLookup(root, index, stateResolver, dataResolver, widgetBuilderArgResolver).result!, 
+            _listLookup(root, index, stateResolver, dataResolver, widgetBuilderArgResolver, listCache).result!,
             stateResolver,
             dataResolver,
             widgetBuilderArgResolver,
+            listCache,
           ),
         );
       } else {
         return DynamicList.generate(
           root.length,
-          (int index) => _fix(root[index]!, stateResolver, dataResolver, widgetBuilderArgResolver),
+          (int index) => _fix(root[index]!, stateResolver, dataResolver, widgetBuilderArgResolver, cache),
         );
       }
     } else if (root is BlobNode) {
-      return _resolveFrom(root, const <Object>[], stateResolver, dataResolver, widgetBuilderArgResolver);
+      return _resolveFrom(root, const <Object>[], stateResolver, dataResolver, widgetBuilderArgResolver, cache);
     } else {
       return root;
     }
@@ -990,12 +1209,13 @@ abstract class _CurriedWidget extends BlobNode {
     List<Object> parts,
     _StateResolverCallback stateResolver,
     _DataResolverCallback dataResolver,
-    _WidgetBuilderArgResolverCallback widgetBuilderArgResolver, {
+    _WidgetBuilderArgResolverCallback widgetBuilderArgResolver,
+    _LoopExpansionCache? cache, {
     required bool expandLists,
   }) {
-    Object result = _resolveFrom(arguments, parts, stateResolver, dataResolver, widgetBuilderArgResolver);
+    Object result = _resolveFrom(arguments, parts, stateResolver, dataResolver, widgetBuilderArgResolver, cache);
     if (result is DynamicList && expandLists) {
-      result = _listLookup(result, -1, stateResolver, dataResolver, widgetBuilderArgResolver);
+      result = _listLookup(result, -1, stateResolver, dataResolver, widgetBuilderArgResolver, cache);
     }
     assert(result is! Reference);
     assert(result is! Switch);
@@ -1124,6 +1344,7 @@ class _CurriedSwitch extends _CurriedWidget {
       stateResolver,
       dataResolver,
       widgetBuilderArgResolver,
+      null,
     );
     if (resolvedWidget is _CurriedWidget) {
       return resolvedWidget.build(context, data, remoteEventTarget, states);
@@ -1254,6 +1475,7 @@ class _WidgetState extends State<_Widget> implements DataSource {
     }
     _subscriptions.clear();
     _argsCache.clear();
+    _loopExpansions.clear();
   }
 
   @override
@@ -1403,6 +1625,10 @@ class _WidgetState extends State<_Widget> implements DataSource {
   bool _debugFetching = false;
   final List<_Subscription> _dependencies = <_Subscription>[];
 
+  // Expansions of the loops in lists, reused across fetches until any data
+  // they could depend on changes.
+  late final _LoopExpansionCache _loopExpansions = _LoopExpansionCache(_dependencies);
+
   Object _fetch(List<Object> argsKey, { required bool expandLists }) {
     final key = _Key(_kArgsSection, argsKey);
     final Object? value = _argsCache[key];
@@ -1417,6 +1643,7 @@ class _WidgetState extends State<_Widget> implements DataSource {
         _stateResolver,
         _dataResolver,
         _widgetBuilderArgResolver,
+        _loopExpansions,
         expandLists: expandLists,
       );
       for (final _Subscription subscription in _dependencies) {
@@ -1485,6 +1712,7 @@ class _WidgetState extends State<_Widget> implements DataSource {
       for (final key in affectedArgs) {
         _argsCache[key] = null;
       }
+      _loopExpansions.clear();
     });
   }
 
@@ -540,4 +540,105 @@ void main() {
       expect('$e', contains('Unrecognized data type 0x0A while decoding widget builder blob.'));
     }
   });
+
+  testWidgets('Version 2 map example', (WidgetTester tester) async {
+    final Uint8List bytes = encodeDataBlob(const <String, Object?>{ 'a': 'a' }, version: 2);
+    expect(bytes, <int>[ 0xFE, 0x52, 0x57, 0x32, 0x01, 0x01, 0x61, 0x07, 0x01, 0x00, 0x04, 0x00 ]);
+    final Object value = decodeDataBlob(bytes);
+    expect(value, const <String, Object?>{ 'a': 'a' });
+    final DynamicMap map = value as DynamicMap;
+    expect(identical(map.keys.single, map.values.single), isTrue);
+  });
+
+  testWidgets('Version 2 integers', (WidgetTester tester) async {
+    expect(encodeDataBlob(0, version: 2), <int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x02, 0x00 ]);
+    expect(encodeDataBlob(-1, version: 2), <int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x02, 0x01 ]);
+    expect(encodeDataBlob(1, version: 2), <int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x02, 0x02 ]);
+    expect(encodeDataBlob(300, version: 2), <int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x02, 0xD8, 0x04 ]);
+    for (final int value in <int>[ 0, 1, -1, 63, -64, 64, 300, largeNumber, -largeNumber ]) {
+      expect(decodeDataBlob(encodeDataBlob(value, version: 2)), value);
+    }
+  });
+
+  testWidgets('Version 2 libraries', (WidgetTester tester) async {
+    final RemoteWidgetLibrary library = parseLibraryFile('''
+      import core.widgets;
+      widget root { count: 0 } = Column(
+        children: [
+          ...for item in data.items:
+            Row(children: [ Text(text: item.name), Text(text: [item.count, -1, 300]) ]),
+          switch state.count {
+            0: Text(text: 'none'),
+            default: GestureDetector(onTap: set state.count = 1, child: Text(text: args.label)),
+          },
+          GestureDetector(onTap: event 'tap' { index: 12 }, child: Text(text: data.items.0.name)),
+        ],
+      );
+    ''');
+    final Uint8List v1 = encodeLibraryBlob(library);
+    final Uint8List v2 = encodeLibraryBlob(library, version: 2);
+    expect(v2.sublist(0, 4), libraryBlobSignatureV2);
+    expect(v2.length, lessThan(v1.length ~/ 2));
+    expect(decodeLibraryBlob(v2).toString(), library.toString());
+    expect(decodeLibraryBlob(v1).toString(), library.toString());
+  });
+
+  testWidgets('Version 2 invalid blobs', (WidgetTester tester) async {
+    try {
+      decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x04, 0x00 ]));
+      fail('did not throw exception');
+    } on FormatException catch (e) {
+      expect('$e', contains('Invalid string index 0 at offset 6 while decoding blob.'));
+    }
+    try {
+      decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x01, 0x05, 0x61 ]));
+      fail('did not throw exception');
+    } on FormatException catch (e) {
+      expect('$e', contains('Could not read string at offset 6: unexpected end of file.'));
+    }
+    expect(() => encodeDataBlob(0, version: 3), throwsArgumentError);
+  });
+
+  testWidgets('Version 2 varint overflow', (WidgetTester tester) async {
+    const nineContinuationBytes = <int>[ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF ];
+    try {
+      decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x02, ...nineContinuationBytes, 0x02 ]));
+      fail('did not throw exception');
+    } on FormatException catch (e) {
+      expect('$e', contains('Could not read varint at offset 6: value does not fit in 64 bits.'));
+    }
+    try {
+      decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x02, ...nineContinuationBytes, 0xFF, 0x00 ]));
+      fail('did not throw exception');
+    } on FormatException catch (e) {
+      expect('$e', contains('Could not read varint at offset 6: value does not fit in 64 bits.'));
+    }
+    // The largest 64-bit varint is a valid integer.
+    expect(decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x02, ...nineContinuationBytes, 0x01 ])), isA<int>());
+  });
+
+  testWidgets('Version 2 negative lengths and indices', (WidgetTester tester) async {
+    // Varints that wrap around to -1 on 64-bit platforms.
+    const minusOne = <int>[ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 ];
+    // A string table whose only string has a length of -1.
+    expect(
+      () => decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x01, ...minusOne, 0x00 ])),
+      throwsFormatException,
+    );
+    // A string table with -1 strings.
+    expect(
+      () => decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, ...minusOne, 0x00 ])),
+      throwsFormatException,
+    );
+    // A string with index -1.
+    expect(
+      () => decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x04, ...minusOne ])),
+      throwsFormatException,
+    );
+    // A list with -1 elements.
+    expect(
+      () => decodeDataBlob(Uint8List.fromList(<int>[ 0xFE, 0x52, 0x57, 0x32, 0x00, 0x05, ...minusOne ])),
+      throwsFormatException,
+    );
+  });
 }
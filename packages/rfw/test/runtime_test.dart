@@ -45,6 +45,53 @@ void main() {
     expect(find.byType(Text), findsNWidgets(5));
   });
 
+  testWidgets('list lookup with several loops', (WidgetTester tester) async {
+    final runtime = Runtime()
+      ..update(const LibraryName(<String>['core']), createCoreWidgets());
+    addTearDown(runtime.dispose);
+    final data = DynamicContent(<String, Object?>{
+      'a': <Object?>[ 'a0', 'a1' ],
+      'b': <Object?>[],
+      'c': <Object?>[ <Object?>[ 'c0' ], <Object?>[ 'c1', 'c2' ] ],
+      'long': List<Object?>.generate(1000, (int index) => index.toDouble()),
+    });
+    runtime.update(const LibraryName(<String>['test']), parseLibraryFile('''
+      import core;
+      widget root = Column(
+        children: [
+          Text(text: 'start', textDirection: "ltr"),
+          ...for v in data.a: Text(text: v, textDirection: "ltr"),
+          ...for v in data.b: Text(text: v, textDirection: "ltr"),
+          Text(text: 'middle', textDirection: "ltr"),
+          ...for w in data.c: ...for v in w: Text(text: v, textDirection: "ltr"),
+          Text(text: 'end', textDirection: "ltr"),
+          ...for v in data.long: SizedBox(width: v),
+        ],
+      );
+    '''));
+    await tester.pumpWidget(
+      RemoteWidget(
+        runtime: runtime,
+        data: data,
+        widget: const FullyQualifiedWidgetName(LibraryName(<String>['test']), 'root'),
+      ),
+    );
+    List<String> texts() => tester.widgetList<Text>(find.byType(Text)).map((Text text) => text.data!).toList();
+    expect(texts(), <String>['start', 'a0', 'a1', 'middle', 'c0', 'c1', 'c2', 'end']);
+    final Finder boxes = find.byType(SizedBox, skipOffstage: false);
+    expect(boxes, findsNWidgets(1000));
+    expect(tester.widget<SizedBox>(boxes.at(999)).width, 999.0);
+
+    data.update('b', <Object?>[ 'b0' ]);
+    data.update('c', <Object?>[ <Object?>[], <Object?>[ 'c3' ] ]);
+    await tester.pump();
+    expect(texts(), <String>['start', 'a0', 'a1', 'b0', 'middle', 'c3', 'end']);
+
+    data.update('a', <Object?>[]);
+    await tester.pump();
+    expect(texts(), <String>['start', 'b0', 'middle', 'c3', 'end']);
+  });
+
   testWidgets('data updates', (WidgetTester tester) async {
     var buildCount = 0;
     int? lastValue;
@@ -610,7 +657,45 @@ void main() {
     await tester.tap(find.byType(ColoredBox));
     await tester.pump();
     expect(tester.widget<ColoredBox>(find.byType(ColoredBox)).color, const Color(0xFF000002));
+  });
 
+  testWidgets('binding loop variables in event arguments', (WidgetTester tester) async {
+    final runtime = Runtime()
+      ..update(const LibraryName(<String>['core']), createCoreWidgets())
+      ..update(const LibraryName(<String>['test']), parseLibraryFile('''
+        import core;
+        widget root = Column(
+          children: [
+            ...for v in data.list:
+              GestureDetector(
+                onTap: event 'test' { values: [ v.a.b, ...for w in v.c: { w: w } ] },
+                child: ColoredBox(),
+              ),
+          ],
+        );
+      '''));
+    addTearDown(runtime.dispose);
+    final data = DynamicContent(<String, Object?>{
+      'list': <Object?>[
+        <String, Object?>{
+          'a': <String, Object?>{ 'b': 0xEE },
+          'c': <Object?>[ 0xDD ],
+        },
+      ],
+    });
+    final eventLog = <String>[];
+    await tester.pumpWidget(
+      RemoteWidget(
+        runtime: runtime,
+        data: data,
+        widget: const FullyQualifiedWidgetName(LibraryName(<String>['test']), 'root'),
+        onEvent: (String eventName, DynamicMap eventArguments) {
+          eventLog.add('$eventName $eventArguments');
+        },
+      ),
+    );
+    await tester.tap(find.byType(ColoredBox));
+    expect(eventLog, <String>['test {values: [${0xEE}, {w: ${0xDD}}]}']);
   });
 
   testWidgets('list lookup of esoteric values', (WidgetTester tester) async {
@@ -1114,6 +1199,66 @@ void main() {
     expect(log, <String>['leaf: 2', 'root: {a: [2, 3], b: [q, r]}', 'root: {a: [2, 3], b: [q, r], c: test}']);
   });
 
+  testWidgets('DynamicContent patches', (WidgetTester tester) async {
+    final log = <String>[];
+    final data = DynamicContent(<String, Object?>{
+      'a': <Object>[
+        <String, Object>{ 'name': 'x' },
+        <String, Object>{ 'name': 'y' },
+        <String, Object>{ 'name': 'z' },
+      ],
+      'b': 'q',
+    });
+    data.subscribe(<Object>[], (Object value) { log.add('root'); });
+    data.subscribe(<Object>['a'], (Object value) { log.add('a: $value'); });
+    data.subscribe(<Object>['a', 0, 'name'], (Object value) { log.add('a.0.name: $value'); });
+    data.subscribe(<Object>['a', 1, 'name'], (Object value) { log.add('a.1.name: $value'); });
+    data.subscribe(<Object>['a', 2], (Object value) { log.add('a.2: $value'); });
+    data.subscribe(<Object>['b'], (Object value) { log.add('b: $value'); });
+
+    data.set(<Object>['a', 1, 'name'], 'w');
+    expect(log, <String>['a.1.name: w', 'a: [{name: x}, {name: w}, {name: z}]', 'root']);
+    log.clear();
+
+    data.set(<Object>['a', 1, 'name'], 'w');
+    expect(log, isEmpty);
+
+    data.insert(<Object>['a', 1], <String, Object>{ 'name': 'v' });
+    expect(log, <String>[
+      'a.1.name: v',
+      'a.2: {name: w}',
+      'a: [{name: x}, {name: v}, {name: w}, {name: z}]',
+      'root',
+    ]);
+    log.clear();
+
+    data.remove(<Object>['a', 0]);
+    expect(log, <String>[
+      'a.0.name: v',
+      'a.1.name: w',
+      'a.2: {name: z}',
+      'a: [{name: v}, {name: w}, {name: z}]',
+      'root',
+    ]);
+    log.clear();
+
+    data.remove(<Object>['a', 2]);
+    expect(log, <String>['a.2: $missing', 'a: [{name: v}, {name: w}]', 'root']);
+    log.clear();
+
+    data.set(<Object>['b'], 'r');
+    expect(log, <String>['b: r', 'root']);
+    log.clear();
+
+    expect(() => data.set(<Object>[], 'r'), throwsArgumentError);
+    expect(() => data.set(<Object>['a', 5], 'r'), throwsArgumentError);
+    expect(() => data.set(<Object>['b', 'c'], 'r'), throwsArgumentError);
+    expect(() => data.insert(<Object>['a', 3], 'r'), throwsArgumentError);
+    expect(() => data.insert(<Object>['b'], 'r'), throwsArgumentError);
+    expect(() => data.remove(<Object>['c']), throwsArgumentError);
+    expect(log, isEmpty);
+  });
+
   testWidgets('Data source - optional builder works', (WidgetTester tester) async {
     const coreLibraryName = LibraryName(<String>['core']);
     const localLibraryName = LibraryName(<String>['local']);
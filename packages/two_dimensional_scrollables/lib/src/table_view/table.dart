@@ -311,7 +311,8 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
 
   // Skipped vicinities for the current frame based on merged cells.
   // This prevents multiple build calls for the same cell that spans multiple
-  // vicinities.
+  // vicinities. Only the vicinities within the laid out area are recorded, so
+  // the cost does not grow with the size of the merged areas.
   // The key represents a skipped vicinity, the value is the resolved vicinity
   // of the merged child.
   final Map<TableVicinity, TableVicinity> _mergedVicinities =
@@ -319,12 +320,17 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
   // These contain the indexes of rows/columns that contain merged cells to
   // optimize decoration drawing for rows/columns that don't contain merged
   // cells.
-  final List<int> _mergedRows = <int>[];
-  final List<int> _mergedColumns = <int>[];
-
-  // Cached Table metrics
-  final Map<int, _Span> _columnMetrics = <int, _Span>{};
-  final Map<int, _Span> _rowMetrics = <int, _Span>{};
+  final Set<int> _mergedRows = <int>{};
+  final Set<int> _mergedColumns = <int>{};
+
+  // Cached Table metrics, indexed by column and row. Metrics are always known
+  // for a contiguous range of indices starting at 0.
+  final List<_Span> _columnMetrics = <_Span>[];
+  final List<_Span> _rowMetrics = <_Span>[];
+  // The spans from before the metrics were last recomputed, which are reused
+  // for the same indices rather than being disposed and reallocated.
+  final List<_Span> _recycledColumnSpans = <_Span>[];
+  final List<_Span> _recycledRowSpans = <_Span>[];
   int? _firstNonPinnedRow;
   int? _firstNonPinnedColumn;
   int? _lastNonPinnedRow;
@@ -397,10 +403,10 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
       delegate.pinnedColumnCount > 0 ? delegate.pinnedColumnCount - 1 : null;
 
   double get _pinnedRowsExtent => _lastPinnedRow != null
-      ? _rowMetrics[_lastPinnedRow]!.trailingOffset
+      ? _rowMetrics[_lastPinnedRow!].trailingOffset
       : 0.0;
   double get _pinnedColumnsExtent => _lastPinnedColumn != null
-      ? _columnMetrics[_lastPinnedColumn]!.trailingOffset
+      ? _columnMetrics[_lastPinnedColumn!].trailingOffset
       : 0.0;
 
   @override
@@ -438,22 +444,22 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
           case Axis.vertical:
             // Row major order, rows go first.
             result.add(
-              HitTestEntry(_rowMetrics[cellParentData.tableVicinity.row]!),
+              HitTestEntry(_rowMetrics[cellParentData.tableVicinity.row]),
             );
             result.add(
               HitTestEntry(
-                _columnMetrics[cellParentData.tableVicinity.column]!,
+                _columnMetrics[cellParentData.tableVicinity.column],
               ),
             );
           case Axis.horizontal:
             // Column major order, columns go first.
             result.add(
               HitTestEntry(
-                _columnMetrics[cellParentData.tableVicinity.column]!,
+                _columnMetrics[cellParentData.tableVicinity.column],
               ),
             );
             result.add(
-              HitTestEntry(_rowMetrics[cellParentData.tableVicinity.row]!),
+              HitTestEntry(_rowMetrics[cellParentData.tableVicinity.row]),
             );
         }
         return true;
@@ -487,10 +493,14 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
       // columns we already know about.
       assert(_columnsAreInfinite);
       assert(_columnMetrics.isNotEmpty);
-      startOfPinnedColumn =
-          _columnMetrics[_firstNonPinnedColumn]?.trailingOffset ?? 0.0;
-      startOfRegularColumn =
-          _columnMetrics[_lastNonPinnedColumn]?.trailingOffset ?? 0.0;
+      startOfPinnedColumn = _trailingOffsetOf(
+        _columnMetrics,
+        _firstNonPinnedColumn,
+      );
+      startOfRegularColumn = _trailingOffsetOf(
+        _columnMetrics,
+        _lastNonPinnedColumn,
+      );
     }
     // If we are computing up to a specific index, we are getting info for a
     // merged cell, do not change the visible cells.
@@ -514,7 +524,10 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
         return _lastNonPinnedColumn != null ||
             _columnNullTerminatedIndex != null;
       }
-      // Compute all the metrics if the columns are finite.
+      // Compute all the metrics if the columns are finite. There is no fast
+      // path for columns of the same extent: each column is built by the
+      // delegate, and its extent may depend on its leading offset and the
+      // viewport, so uniform extents can't be known without building them.
       return column == delegate.columnCount!;
     }
 
@@ -523,9 +536,8 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
       final leadingOffset = isPinned
           ? startOfPinnedColumn
           : startOfRegularColumn;
-      _Span? span = _columnMetrics.remove(column);
-      final TableSpan? configuration =
-          span?.configuration ?? delegate.buildColumn(column);
+      assert(column == _columnMetrics.length);
+      final TableSpan? configuration = delegate.buildColumn(column);
       if (configuration == null) {
         // We have reached the end of columns based on a null termination. This
         // This happens when a column count has not been specified.
@@ -538,7 +550,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
         }
         break;
       }
-      span ??= _Span();
+      final _Span span = _obtainSpan(_recycledColumnSpans, column);
       span.update(
         isPinned: isPinned,
         configuration: configuration,
@@ -550,7 +562,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
           ),
         ),
       );
-      _columnMetrics[column] = span;
+      _columnMetrics.add(span);
       if (!isPinned) {
         if (span.trailingOffset >= _targetLeadingColumnPixel &&
             _firstNonPinnedColumn == null) {
@@ -594,8 +606,8 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
       // rows we already know about.
       assert(_rowsAreInfinite);
       assert(_rowMetrics.isNotEmpty);
-      startOfPinnedRow = _rowMetrics[_firstNonPinnedRow]?.trailingOffset ?? 0.0;
-      startOfRegularRow = _rowMetrics[_lastNonPinnedRow]?.trailingOffset ?? 0.0;
+      startOfPinnedRow = _trailingOffsetOf(_rowMetrics, _firstNonPinnedRow);
+      startOfRegularRow = _trailingOffsetOf(_rowMetrics, _lastNonPinnedRow);
     }
     // If we are computing up to a specific index, we are getting info for a
     // merged cell, do not change the visible cells.
@@ -616,16 +628,16 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
         // terminates.
         return _lastNonPinnedRow != null || _rowNullTerminatedIndex != null;
       }
-      // Compute all the metrics if the rows are finite.
+      // Compute all the metrics if the rows are finite. As with columns, rows
+      // of the same extent are built and measured one by one.
       return row == delegate.rowCount!;
     }
 
     while (!reachedRowEnd()) {
       final bool isPinned = row < delegate.pinnedRowCount;
       final leadingOffset = isPinned ? startOfPinnedRow : startOfRegularRow;
-      _Span? span = _rowMetrics.remove(row);
-      final TableSpan? configuration =
-          span?.configuration ?? delegate.buildRow(row);
+      assert(row == _rowMetrics.length);
+      final TableSpan? configuration = delegate.buildRow(row);
       if (configuration == null) {
         // We have reached the end of rows based on a null termination. This
         // This happens when a row count has not been specified, but we have
@@ -639,7 +651,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
         }
         break;
       }
-      span ??= _Span();
+      final _Span span = _obtainSpan(_recycledRowSpans, row);
       span.update(
         isPinned: isPinned,
         configuration: configuration,
@@ -651,7 +663,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
           ),
         ),
       );
-      _rowMetrics[row] = span;
+      _rowMetrics.add(span);
       if (!isPinned) {
         if (span.trailingOffset >= _targetLeadingRowPixel &&
             _firstNonPinnedRow == null) {
@@ -694,7 +706,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
       }
       maxHorizontalScrollExtent = math.max(
         0.0,
-        _columnMetrics[lastColumn]!.trailingOffset -
+        _columnMetrics[lastColumn].trailingOffset -
             viewportDimension.width +
             _pinnedColumnsExtent,
       );
@@ -720,7 +732,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
       }
       maxVerticalScrollExtent = math.max(
         0.0,
-        _rowMetrics[lastRow]!.trailingOffset -
+        _rowMetrics[lastRow].trailingOffset -
             viewportDimension.height +
             _pinnedRowsExtent,
       );
@@ -728,22 +740,51 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     return verticalOffset.applyContentDimensions(0.0, maxVerticalScrollExtent);
   }
 
+  // The trailing offset of the span at `index` in `metrics`, or 0.0 if `index`
+  // is null.
+  double _trailingOffsetOf(List<_Span> metrics, int? index) {
+    return index == null ? 0.0 : metrics[index].trailingOffset;
+  }
+
+  // Returns a span for the metrics at `index`, reusing the span that had that
+  // index before the metrics were recomputed, if any.
+  _Span _obtainSpan(List<_Span> recycled, int index) {
+    return index < recycled.length ? recycled[index] : _Span();
+  }
+
+  // Moves the current spans to `recycled` so they can be reused by the next
+  // metrics update.
+  void _recycleSpans(List<_Span> metrics, List<_Span> recycled) {
+    assert(recycled.isEmpty);
+    recycled.addAll(metrics);
+    metrics.clear();
+  }
+
+  // Disposes the recycled spans that were not reused by the last metrics
+  // update.
+  void _disposeRecycledSpans(List<_Span> metrics, List<_Span> recycled) {
+    for (int index = metrics.length; index < recycled.length; index++) {
+      recycled[index].dispose();
+    }
+    recycled.clear();
+  }
+
   /// Binary search to find the first index with [_Span] matching the condition.
-  /// [map]: Index-[_Span] map, [condition]: Match rule
+  /// [metrics]: Index-ordered [_Span]s, [condition]: Match rule
   /// Returns the first matched index or null if not found.
-  int? _binarySearchFirstFromMap(
-    Map<int, _Span> map,
+  int? _binarySearchFirst(
+    List<_Span> metrics,
     bool Function(_Span) condition,
   ) {
-    if (map.isEmpty) {
+    if (metrics.isEmpty) {
       return null;
     }
     var low = 0;
-    int high = map.length - 1;
+    int high = metrics.length - 1;
     int? result;
     while (low <= high) {
       final int mid = low + ((high - low) >> 1);
-      final _Span span = map[mid]!;
+      final _Span span = metrics[mid];
       if (condition(span)) {
         result = mid;
         high = mid - 1;
@@ -760,13 +801,13 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
   // layout portion we know about.
   void _updateFirstAndLastVisibleCell() {
     if (_columnMetrics.isNotEmpty) {
-      _Span lastKnownColumn = _columnMetrics[_columnMetrics.length - 1]!;
+      _Span lastKnownColumn = _columnMetrics.last;
       if (_columnsAreInfinite &&
           lastKnownColumn.trailingOffset < _targetTrailingColumnPixel) {
         // This will add the column metrics we do not know about up to the
         // _targetColumnPixel, while keeping the ones we already know about.
         _updateColumnMetrics(appendColumns: true);
-        lastKnownColumn = _columnMetrics[_columnMetrics.length - 1]!;
+        lastKnownColumn = _columnMetrics.last;
         assert(
           _columnMetrics.length == delegate.columnCount ||
               lastKnownColumn.trailingOffset >= _targetTrailingColumnPixel ||
@@ -777,12 +818,12 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     _firstNonPinnedColumn = null;
     _lastNonPinnedColumn = null;
     // Binary search replaces for-loop to reduce computation.
-    _firstNonPinnedColumn = _binarySearchFirstFromMap(
+    _firstNonPinnedColumn = _binarySearchFirst(
       _columnMetrics,
       (span) =>
           !span.isPinned && span.trailingOffset >= _targetLeadingColumnPixel,
     );
-    _lastNonPinnedColumn = _binarySearchFirstFromMap(
+    _lastNonPinnedColumn = _binarySearchFirst(
       _columnMetrics,
       (span) =>
           !span.isPinned && span.trailingOffset >= _targetTrailingColumnPixel,
@@ -792,13 +833,13 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     }
 
     if (_rowMetrics.isNotEmpty) {
-      _Span lastKnownRow = _rowMetrics[_rowMetrics.length - 1]!;
+      _Span lastKnownRow = _rowMetrics.last;
       if (_rowsAreInfinite &&
           lastKnownRow.trailingOffset < _targetTrailingRowPixel) {
         // This will add the row metrics we do not know about up to the
         // _targetRowPixel, while keeping the ones we already know about.
         _updateRowMetrics(appendRows: true);
-        lastKnownRow = _rowMetrics[_rowMetrics.length - 1]!;
+        lastKnownRow = _rowMetrics.last;
         assert(
           _rowMetrics.length == delegate.rowCount ||
               lastKnownRow.trailingOffset >= _targetTrailingRowPixel ||
@@ -809,11 +850,11 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     _firstNonPinnedRow = null;
     _lastNonPinnedRow = null;
     // Binary search replaces for-loop to reduce computation.
-    _firstNonPinnedRow = _binarySearchFirstFromMap(
+    _firstNonPinnedRow = _binarySearchFirst(
       _rowMetrics,
       (span) => !span.isPinned && span.trailingOffset >= _targetLeadingRowPixel,
     );
-    _lastNonPinnedRow = _binarySearchFirstFromMap(
+    _lastNonPinnedRow = _binarySearchFirst(
       _rowMetrics,
       (span) =>
           !span.isPinned && span.trailingOffset >= _targetTrailingRowPixel,
@@ -836,17 +877,13 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
 
     if (needsDelegateRebuild || didResize) {
       // Recomputes the table metrics, invalidates any cached information.
-      for (final _Span span in _columnMetrics.values) {
-        span.dispose();
-      }
-      _columnMetrics.clear();
-      for (final _Span span in _rowMetrics.values) {
-        span.dispose();
-      }
-      _rowMetrics.clear();
+      _recycleSpans(_columnMetrics, _recycledColumnSpans);
+      _recycleSpans(_rowMetrics, _recycledRowSpans);
       _updateColumnMetrics();
       _updateRowMetrics();
       _updateScrollBounds();
+      _disposeRecycledSpans(_columnMetrics, _recycledColumnSpans);
+      _disposeRecycledSpans(_rowMetrics, _recycledRowSpans);
     } else {
       // Updates the visible cells based on cached table metrics.
       _updateFirstAndLastVisibleCell();
@@ -861,12 +898,12 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
 
     final double? offsetIntoColumn = _firstNonPinnedColumn != null
         ? horizontalOffset.pixels -
-              _columnMetrics[_firstNonPinnedColumn]!.leadingOffset -
+              _columnMetrics[_firstNonPinnedColumn!].leadingOffset -
               _pinnedColumnsExtent
         : null;
     final double? offsetIntoRow = _firstNonPinnedRow != null
         ? verticalOffset.pixels -
-              _rowMetrics[_firstNonPinnedRow]!.leadingOffset -
+              _rowMetrics[_firstNonPinnedRow!].leadingOffset -
               _pinnedRowsExtent
         : null;
     if (_lastPinnedRow != null && _lastPinnedColumn != null) {
@@ -963,7 +1000,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     for (int row = start.row; row <= end.row; row += 1) {
       double columnOffset = -offset.dx;
       assert(row < _rowMetrics.length);
-      rowSpan = _rowMetrics[row]!;
+      rowSpan = _rowMetrics[row];
       final double standardRowHeight = rowSpan.extent;
       double? mergedRowHeight;
       double? mergedRowOffset;
@@ -971,14 +1008,14 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
 
       for (int column = start.column; column <= end.column; column += 1) {
         assert(column < _columnMetrics.length);
-        colSpan = _columnMetrics[column]!;
+        colSpan = _columnMetrics[column];
         final double standardColumnWidth = colSpan.extent;
         double? mergedColumnWidth;
         double? mergedColumnOffset;
         columnOffset += colSpan.configuration.padding.leading;
 
         final vicinity = TableVicinity(column: column, row: row);
-        final RenderBox? cell = _mergedVicinities.keys.contains(vicinity)
+        final RenderBox? cell = _mergedVicinities.containsKey(vicinity)
             ? null
             : buildOrObtainChildFor(vicinity);
 
@@ -1048,26 +1085,26 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
             };
             mergedRowOffset =
                 baseRowOffset +
-                _rowMetrics[firstRow]!.leadingOffset +
-                _rowMetrics[firstRow]!.configuration.padding.leading;
-            if (_rowsAreInfinite && _rowMetrics[lastRow] == null) {
+                _rowMetrics[firstRow].leadingOffset +
+                _rowMetrics[firstRow].configuration.padding.leading;
+            if (_rowsAreInfinite && lastRow >= _rowMetrics.length) {
               // The number of rows is infinite, and we have not calculated
               // the metrics to the full extent of the merged cell. Update the
               // metrics so we have all the information for the merged area.
               _updateRowMetrics(appendRows: true, toRowIndex: lastRow);
             }
             assert(
-              _rowMetrics[lastRow] != null,
+              lastRow < _rowMetrics.length,
               'The merged cell containing $vicinity is missing TableSpan '
               'information necessary for layout. The rowBuilder returned '
               'null, signifying the end, at row $_rowNullTerminatedIndex but the '
               'merged cell is configured to end with row $lastRow.',
             );
             mergedRowHeight =
-                _rowMetrics[lastRow]!.trailingOffset -
-                _rowMetrics[firstRow]!.leadingOffset -
-                _rowMetrics[lastRow]!.configuration.padding.trailing -
-                _rowMetrics[firstRow]!.configuration.padding.leading;
+                _rowMetrics[lastRow].trailingOffset -
+                _rowMetrics[firstRow].leadingOffset -
+                _rowMetrics[lastRow].configuration.padding.trailing -
+                _rowMetrics[firstRow].configuration.padding.leading;
             // Compute width and layout offset for merged columns.
             final bool columnIsInPinnedRow =
                 _lastPinnedRow != null && vicinity.row <= _lastPinnedRow!;
@@ -1085,10 +1122,10 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
             };
             mergedColumnOffset =
                 baseColumnOffset +
-                _columnMetrics[firstColumn]!.leadingOffset +
-                _columnMetrics[firstColumn]!.configuration.padding.leading;
+                _columnMetrics[firstColumn].leadingOffset +
+                _columnMetrics[firstColumn].configuration.padding.leading;
 
-            if (_columnsAreInfinite && _columnMetrics[lastColumn] == null) {
+            if (_columnsAreInfinite && lastColumn >= _columnMetrics.length) {
               // The number of columns is infinite, and we have not calculated
               // the metrics to the full extent of the merged cell. Update the
               // metrics so we have all the information for the merged area.
@@ -1098,29 +1135,32 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
               );
             }
             assert(
-              _columnMetrics[lastColumn] != null,
+              lastColumn < _columnMetrics.length,
               'The merged cell containing $vicinity is missing TableSpan '
               'information necessary for layout. The columnBuilder returned '
               'null, signifying the end, at column $_columnNullTerminatedIndex but '
               'the merged cell is configured to end with column $lastColumn.',
             );
             mergedColumnWidth =
-                _columnMetrics[lastColumn]!.trailingOffset -
-                _columnMetrics[firstColumn]!.leadingOffset -
-                _columnMetrics[lastColumn]!.configuration.padding.trailing -
-                _columnMetrics[firstColumn]!.configuration.padding.leading;
+                _columnMetrics[lastColumn].trailingOffset -
+                _columnMetrics[firstColumn].leadingOffset -
+                _columnMetrics[lastColumn].configuration.padding.trailing -
+                _columnMetrics[firstColumn].configuration.padding.leading;
 
             // Collect all of the vicinities that will not need to be built now.
-            var currentRow = firstRow;
-            while (currentRow <= lastRow) {
+            // Vicinities outside of the area being laid out are never visited,
+            // so they do not need to be recorded.
+            final int firstLaidOutRow = math.max(firstRow, start.row);
+            final int lastLaidOutRow = math.min(lastRow, end.row);
+            final int firstLaidOutColumn = math.max(firstColumn, start.column);
+            final int lastLaidOutColumn = math.min(lastColumn, end.column);
+            var currentRow = firstLaidOutRow;
+            while (currentRow <= lastLaidOutRow) {
               if (cellParentData.rowMergeStart != null) {
                 _mergedRows.add(currentRow);
               }
-              var currentColumn = firstColumn;
-              while (currentColumn <= lastColumn) {
-                if (cellParentData.columnMergeStart != null) {
-                  _mergedColumns.add(currentColumn);
-                }
+              var currentColumn = firstLaidOutColumn;
+              while (currentColumn <= lastLaidOutColumn) {
                 final key = TableVicinity(
                   row: currentRow,
                   column: currentColumn,
@@ -1130,6 +1170,15 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
               }
               currentRow++;
             }
+            if (cellParentData.columnMergeStart != null) {
+              for (
+                int currentColumn = firstLaidOutColumn;
+                currentColumn <= lastLaidOutColumn;
+                currentColumn++
+              ) {
+                _mergedColumns.add(currentColumn);
+              }
+            }
           }
 
           final cellConstraints = BoxConstraints.tightFor(
@@ -1148,10 +1197,10 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
         }
         columnOffset +=
             standardColumnWidth +
-            _columnMetrics[column]!.configuration.padding.trailing;
+            _columnMetrics[column].configuration.padding.trailing;
       }
       rowOffset +=
-          standardRowHeight + _rowMetrics[row]!.configuration.padding.trailing;
+          standardRowHeight + _rowMetrics[row].configuration.padding.trailing;
     }
   }
 
@@ -1315,7 +1364,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     // the full area. Returns the child that has been laid out to span the given
     // vicinity.
     assert(
-      _mergedVicinities.keys.contains(vicinity),
+      _mergedVicinities.containsKey(vicinity),
       'The vicinity $vicinity is not accounted for as covered by a merged cell.',
     );
     final TableVicinity mergedVicinity = _mergedVicinities[vicinity]!;
@@ -1336,18 +1385,18 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     final foregroundColumns = <Rect, TableSpanDecoration>{};
     final backgroundColumns = <Rect, TableSpanDecoration>{};
 
-    final TableSpan rowSpan = _rowMetrics[leadingVicinity.row]!.configuration;
+    final TableSpan rowSpan = _rowMetrics[leadingVicinity.row].configuration;
     for (
       int column = leadingVicinity.column;
       column <= trailingVicinity.column;
       column++
     ) {
-      TableSpan columnSpan = _columnMetrics[column]!.configuration;
+      TableSpan columnSpan = _columnMetrics[column].configuration;
       if (columnSpan.backgroundDecoration != null ||
           columnSpan.foregroundDecoration != null ||
           _mergedColumns.contains(column)) {
         final decorationCells = <({RenderBox leading, RenderBox trailing})>[];
-        if (_mergedColumns.isEmpty || !_mergedColumns.contains(column)) {
+        if (!_mergedColumns.contains(column)) {
           // One decoration across the whole column.
           decorationCells.add((
             leading: getChildFor(
@@ -1445,7 +1494,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
           final int columnIndex =
               parentDataOf(cell.leading).columnMergeStart ??
               parentDataOf(cell.leading).tableVicinity.column;
-          columnSpan = _columnMetrics[columnIndex]!.configuration;
+          columnSpan = _columnMetrics[columnIndex].configuration;
           if (columnSpan.backgroundDecoration != null) {
             final Rect rect = getColumnRect(
               leadingCell: cell.leading,
@@ -1472,14 +1521,14 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     final foregroundRows = <Rect, TableSpanDecoration>{};
     final backgroundRows = <Rect, TableSpanDecoration>{};
     final TableSpan columnSpan =
-        _columnMetrics[leadingVicinity.column]!.configuration;
+        _columnMetrics[leadingVicinity.column].configuration;
     for (int row = leadingVicinity.row; row <= trailingVicinity.row; row++) {
-      TableSpan rowSpan = _rowMetrics[row]!.configuration;
+      TableSpan rowSpan = _rowMetrics[row].configuration;
       if (rowSpan.backgroundDecoration != null ||
           rowSpan.foregroundDecoration != null ||
           _mergedRows.contains(row)) {
         final decorationCells = <({RenderBox leading, RenderBox trailing})>[];
-        if (_mergedRows.isEmpty || !_mergedRows.contains(row)) {
+        if (!_mergedRows.contains(row)) {
           // One decoration across the whole row.
           decorationCells.add((
             leading: getChildFor(
@@ -1577,7 +1626,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
           final int rowIndex =
               parentDataOf(cell.leading).rowMergeStart ??
               parentDataOf(cell.trailing).tableVicinity.row;
-          rowSpan = _rowMetrics[rowIndex]!.configuration;
+          rowSpan = _rowMetrics[rowIndex].configuration;
           if (rowSpan.backgroundDecoration != null) {
             final Rect rect = getRowRect(
               leadingCell: cell.leading,
@@ -1658,7 +1707,7 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
         if (cell == null) {
           // Covered by a merged cell
           assert(
-            _mergedVicinities.keys.contains(vicinity),
+            _mergedVicinities.containsKey(vicinity),
             'TableViewCell for $vicinity could not be found. If merging '
             'cells, the same TableViewCell must be returned for every '
             'TableVicinity that is contained in the merged area of the '
@@ -1719,10 +1768,10 @@ class RenderTableViewport extends RenderTwoDimensionalViewport {
     _clipPinnedRowsHandle.layer = null;
     _clipPinnedColumnsHandle.layer = null;
     _clipCellsHandle.layer = null;
-    for (final _Span span in _rowMetrics.values) {
+    for (final _Span span in _rowMetrics) {
       span.dispose();
     }
-    for (final _Span span in _columnMetrics.values) {
+    for (final _Span span in _columnMetrics) {
       span.dispose();
     }
     super.dispose();
@@ -619,6 +619,9 @@ class _TreeViewState<T> extends State<TreeView<T>>
   // The flat representation of the tree, omitting nodes that are not active.
   final List<TreeViewNode<T>> _activeNodes = <TreeViewNode<T>>[];
   final Map<int, int> _rowDepths = <int, int>{};
+  // The index of each node in _activeNodes.
+  final Map<TreeViewNode<T>, int> _activeNodeIndices =
+      <TreeViewNode<T>, int>{};
   bool _shouldUnpackNode(TreeViewNode<T> node) {
     if (node.children.isEmpty) {
       // No children to unpack.
@@ -634,31 +637,71 @@ class _TreeViewState<T> extends State<TreeView<T>>
   }
 
   // Flattens the tree, omitting nodes that are not active.
-  void _unpackActiveNodes({
-    int depth = 0,
-    List<TreeViewNode<T>>? nodes,
-    TreeViewNode<T>? parent,
-  }) {
-    if (nodes == null) {
-      _activeNodes.clear();
-      _rowDepths.clear();
-      nodes = widget.tree;
+  void _unpackActiveNodes() {
+    _activeNodes.clear();
+    _activeNodeIndices.clear();
+    _rowDepths.clear();
+    _flattenNodes(widget.tree, 0, null, _activeNodes);
+    _reindexActiveNodes(0);
+  }
+
+  // Re-flattens the active descendants of the given node in place, after it
+  // has been expanded or collapsed. Only the rows of the node's subtree and
+  // the indices of the rows after it are updated, rather than the whole tree.
+  void _unpackActiveDescendants(TreeViewNode<T> node) {
+    final int? index = _activeNodeIndices[node];
+    if (index == null) {
+      // The node is not active, so neither are its descendants.
+      return;
+    }
+    final int start = index + 1;
+    int end = start;
+    while (end < _activeNodes.length && _rowDepths[end]! > node.depth!) {
+      _activeNodeIndices.remove(_activeNodes[end]);
+      end++;
     }
+    final descendants = <TreeViewNode<T>>[];
+    if (_shouldUnpackNode(node)) {
+      _flattenNodes(node.children, node.depth! + 1, node, descendants);
+    }
+    if (descendants.isEmpty && start == end) {
+      return;
+    }
+    _activeNodes.replaceRange(start, end, descendants);
+    while (_rowDepths.length > _activeNodes.length) {
+      _rowDepths.remove(_rowDepths.length - 1);
+    }
+    _reindexActiveNodes(start);
+  }
+
+  // Appends the active nodes of the given subtree to flatNodes, in the order
+  // they appear in the tree.
+  void _flattenNodes(
+    List<TreeViewNode<T>> nodes,
+    int depth,
+    TreeViewNode<T>? parent,
+    List<TreeViewNode<T>> flatNodes,
+  ) {
     for (final TreeViewNode<T> node in nodes) {
       node._depth = depth;
       node._parent = parent;
-      _activeNodes.add(node);
-      _rowDepths[_activeNodes.length - 1] = depth;
+      flatNodes.add(node);
       if (_shouldUnpackNode(node)) {
-        _unpackActiveNodes(
-          depth: depth + 1,
-          nodes: node.children,
-          parent: node,
-        );
+        _flattenNodes(node.children, depth + 1, node, flatNodes);
       }
     }
   }
 
+  // Updates the row depths and indices of the active nodes from the given row
+  // onward.
+  void _reindexActiveNodes(int start) {
+    for (int row = start; row < _activeNodes.length; row++) {
+      final TreeViewNode<T> node = _activeNodes[row];
+      _activeNodeIndices[node] = row;
+      _rowDepths[row] = node.depth!;
+    }
+  }
+
   final Map<TreeViewNode<T>, _AnimationRecord> _currentAnimationForParent =
       <TreeViewNode<T>, _AnimationRecord>{};
   final Map<UniqueKey, TreeViewNodesAnimation> _activeAnimations =
@@ -769,7 +812,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
   }
 
   @override
-  bool isActive(TreeViewNode<T> node) => _activeNodes.contains(node);
+  bool isActive(TreeViewNode<T> node) => _activeNodeIndices.containsKey(node);
 
   @override
   TreeViewNode<T>? getNodeFor(T content) => _getNode(content, widget.tree);
@@ -790,12 +833,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
   }
 
   @override
-  int? getActiveIndexFor(TreeViewNode<T> node) {
-    if (_activeNodes.contains(node)) {
-      return _activeNodes.indexOf(node);
-    }
-    return null;
-  }
+  int? getActiveIndexFor(TreeViewNode<T> node) => _activeNodeIndices[node];
 
   @override
   void expandAll() {
@@ -815,7 +853,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
         _expandAll(node.children, activeNodesToExpand);
         if (!node.isExpanded) {
           // The node itself needs to be expanded.
-          if (_activeNodes.contains(node)) {
+          if (isActive(node)) {
             // This is an active node in the tree, add to
             // the list to toggle once all hidden nodes
             // have been handled.
@@ -847,7 +885,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
         _collapseAll(node.children, activeNodesToCollapse);
         if (node.isExpanded) {
           // The node itself needs to be collapsed.
-          if (_activeNodes.contains(node)) {
+          if (isActive(node)) {
             // This is an active node in the tree, add to
             // the list to toggle once all hidden nodes
             // have been handled.
@@ -867,9 +905,15 @@ class _TreeViewState<T> extends State<TreeView<T>>
     // animations keys each time we build with an updated active node list.
     _activeAnimations.clear();
     for (final TreeViewNode<T> node in _currentAnimationForParent.keys) {
+      final int? index = _activeNodeIndices[node];
+      if (index == null) {
+        // The node was removed from the active nodes when an ancestor finished
+        // collapsing, so none of its children are visible to animate.
+        continue;
+      }
       final _AnimationRecord animationRecord =
           _currentAnimationForParent[node]!;
-      final int leadingChildIndex = _activeNodes.indexOf(node) + 1;
+      final int leadingChildIndex = index + 1;
       final TreeViewNodesAnimation animatingChildren = (
         fromIndex: leadingChildIndex,
         toIndex: leadingChildIndex + node.children.length - 1,
@@ -881,7 +925,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
 
   @override
   void toggleNode(TreeViewNode<T> node) {
-    assert(_activeNodes.contains(node));
+    assert(isActive(node));
     if (node.children.isEmpty) {
       // No state to change.
       return;
@@ -896,7 +940,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
       // and update the active nodes immediately. This ensures the tree
       // is updated correctly when the node's children are no longer active.
       if (widget.toggleAnimationStyle?.duration == Duration.zero) {
-        _unpackActiveNodes();
+        _unpackActiveDescendants(node);
         return;
       }
 
@@ -921,7 +965,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
               // nodes to remove the ones that were removed from the tree.
               // This is only necessary if the node is collapsing.
               if (!node._expanded) {
-                _unpackActiveNodes();
+                _unpackActiveDescendants(node);
               }
             case AnimationStatus.forward:
             case AnimationStatus.reverse:
@@ -958,7 +1002,7 @@ class _TreeViewState<T> extends State<TreeView<T>>
       switch (node._expanded) {
         case true:
           // Expanding
-          _unpackActiveNodes();
+          _unpackActiveDescendants(node);
           controller.forward();
         case false:
           // Collapsing
@@ -1727,5 +1727,59 @@ void main() {
         expect(tester.getSize(find.text('M(2,0)')), const Size(100.0, 100.0));
       });
     });
+
+    testWidgets('merged cells much larger than the viewport', (
+      WidgetTester tester,
+    ) async {
+      final verticalController = ScrollController();
+      addTearDown(verticalController.dispose);
+      const rowCount = 10000;
+      await tester.pumpWidget(
+        Directionality(
+          textDirection: TextDirection.ltr,
+          child: TableView.builder(
+            verticalDetails: ScrollableDetails.vertical(
+              controller: verticalController,
+            ),
+            columnCount: 2,
+            rowCount: rowCount,
+            columnBuilder: (_) => span,
+            rowBuilder: (_) => span,
+            cellBuilder: (_, TableVicinity vicinity) {
+              if (vicinity.column == 0) {
+                // The first column is a single cell spanning every row.
+                return const TableViewCell(
+                  rowMergeStart: 0,
+                  rowMergeSpan: rowCount,
+                  child: Text('Merged'),
+                );
+              }
+              return TableViewCell(
+                child: Text('R${vicinity.row}:C${vicinity.column}'),
+              );
+            },
+          ),
+        ),
+      );
+      await tester.pumpAndSettle();
+      expect(find.text('Merged'), findsOneWidget);
+      expect(
+        tester.getRect(find.text('Merged')),
+        const Rect.fromLTWH(0.0, 0.0, 100.0, rowCount * 100.0),
+      );
+
+      verticalController.jumpTo(500000.0);
+      await tester.pumpAndSettle();
+      expect(find.text('Merged'), findsOneWidget);
+      expect(
+        tester.getRect(find.text('Merged')),
+        const Rect.fromLTWH(0.0, -500000.0, 100.0, rowCount * 100.0),
+      );
+      expect(find.text('R5000:C1'), findsOneWidget);
+      expect(
+        tester.getRect(find.text('R5000:C1')),
+        const Rect.fromLTWH(100.0, 0.0, 100.0, 100.0),
+      );
+    });
   });
 }
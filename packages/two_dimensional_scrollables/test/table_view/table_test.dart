@@ -3632,6 +3632,57 @@ void main() {
       );
     });
 
+    testWidgets('mouse handling is kept across delegate rebuilds', (
+      WidgetTester tester,
+    ) async {
+      var enterCounter = 0;
+      var exitCounter = 0;
+      TableView buildTableView(int rowCount) {
+        return TableView.builder(
+          rowCount: rowCount,
+          columnCount: 50,
+          columnBuilder: (_) => span,
+          rowBuilder: (int index) => index.isEven
+              ? getMouseTrackingSpan(
+                  index,
+                  onEnter: (_) => enterCounter++,
+                  onExit: (_) => exitCounter++,
+                )
+              : span,
+          cellBuilder: (_, TableVicinity vicinity) {
+            return TableViewCell(
+              child: SizedBox.square(
+                dimension: 100,
+                child: Text('Row: ${vicinity.row} Column: ${vicinity.column}'),
+              ),
+            );
+          },
+        );
+      }
+
+      await tester.pumpWidget(MaterialApp(home: buildTableView(50)));
+      await tester.pumpAndSettle();
+      final Offset evenRow = tester.getCenter(find.text('Row: 2 Column: 2'));
+      final TestGesture gesture = await tester.createGesture(
+        kind: PointerDeviceKind.mouse,
+      );
+      await gesture.addPointer(location: evenRow);
+      await tester.pumpAndSettle();
+      expect(enterCounter, 1);
+      expect(exitCounter, 0);
+
+      // Rebuilding the delegate recomputes the metrics, but the row under the
+      // mouse is the same, so it is neither exited nor entered again.
+      await tester.pumpWidget(MaterialApp(home: buildTableView(40)));
+      await tester.pumpAndSettle();
+      expect(enterCounter, 1);
+      expect(exitCounter, 0);
+      expect(
+        RendererBinding.instance.mouseTracker.debugDeviceActiveCursor(1),
+        SystemMouseCursors.cell,
+      );
+    });
+
     group('Merged pinned cells layout', () {
       // Regression tests for https://github.com/flutter/flutter/issues/143526
       // These tests all use the same collection of merged pinned cells in a
@@ -309,6 +309,112 @@ void main() {
       // 'Root 2'
       expect(controller.isExpanded(simpleNodeSet[2]), isTrue);
     });
+
+    testWidgets('Active indices update as nested nodes are toggled', (
+      WidgetTester tester,
+    ) async {
+      final controller = TreeViewController();
+      final nestedChild = TreeViewNode<String>(
+        'Child 0:0',
+        children: <TreeViewNode<String>>[
+          TreeViewNode<String>('Grandchild 0:0:0'),
+          TreeViewNode<String>('Grandchild 0:0:1'),
+        ],
+      );
+      final root = TreeViewNode<String>(
+        'Root 0',
+        expanded: true,
+        children: <TreeViewNode<String>>[
+          nestedChild,
+          TreeViewNode<String>('Child 0:1'),
+        ],
+      );
+      final lastRoot = TreeViewNode<String>('Root 1');
+      await tester.pumpWidget(
+        MaterialApp(
+          home: TreeView<String>(
+            tree: <TreeViewNode<String>>[root, lastRoot],
+            controller: controller,
+          ),
+        ),
+      );
+      expect(controller.getActiveIndexFor(lastRoot), 3);
+      expect(controller.getActiveIndexFor(nestedChild.children[0]), isNull);
+
+      // Expanding the nested child inserts its children after it.
+      controller.toggleNode(nestedChild);
+      await tester.pumpAndSettle();
+      expect(controller.getActiveIndexFor(nestedChild.children[0]), 2);
+      expect(controller.getActiveIndexFor(nestedChild.children[1]), 3);
+      expect(controller.getActiveIndexFor(root.children[1]), 4);
+      expect(controller.getActiveIndexFor(lastRoot), 5);
+      expect(nestedChild.children[1].depth, 2);
+
+      // Collapsing the root removes all of its descendants.
+      controller.toggleNode(root);
+      await tester.pumpAndSettle();
+      expect(controller.getActiveIndexFor(nestedChild), isNull);
+      expect(controller.getActiveIndexFor(nestedChild.children[0]), isNull);
+      expect(controller.getActiveIndexFor(lastRoot), 1);
+
+      // Expanding the root again restores the still expanded nested child.
+      controller.toggleNode(root);
+      await tester.pumpAndSettle();
+      expect(controller.getActiveIndexFor(nestedChild.children[1]), 3);
+      expect(controller.getActiveIndexFor(lastRoot), 5);
+      expect(find.text('Grandchild 0:0:1'), findsOneWidget);
+    });
+
+    testWidgets('Collapsing a nested node while its ancestor collapses', (
+      WidgetTester tester,
+    ) async {
+      final controller = TreeViewController();
+      final nestedChild = TreeViewNode<String>(
+        'Child 0:0',
+        expanded: true,
+        children: <TreeViewNode<String>>[
+          TreeViewNode<String>('Grandchild 0:0:0'),
+          TreeViewNode<String>('Grandchild 0:0:1'),
+        ],
+      );
+      final root = TreeViewNode<String>(
+        'Root 0',
+        expanded: true,
+        children: <TreeViewNode<String>>[
+          nestedChild,
+          TreeViewNode<String>('Child 0:1'),
+        ],
+      );
+      final lastRoot = TreeViewNode<String>('Root 1');
+      await tester.pumpWidget(
+        MaterialApp(
+          home: TreeView<String>(
+            tree: <TreeViewNode<String>>[root, lastRoot],
+            controller: controller,
+          ),
+        ),
+      );
+      expect(controller.getActiveIndexFor(lastRoot), 5);
+
+      controller.toggleNode(root);
+      await tester.pump();
+      await tester.pump(TreeView.defaultAnimationDuration ~/ 2);
+      // The nested node is still active while the root animates.
+      expect(controller.isActive(nestedChild), isTrue);
+      controller.toggleNode(nestedChild);
+      await tester.pump();
+      await tester.pump(TreeView.defaultAnimationDuration ~/ 2);
+      // The root's animation has completed, removing the nested node from the
+      // active nodes while its own animation is still running.
+      expect(controller.isActive(nestedChild), isFalse);
+      await tester.pump(const Duration(milliseconds: 10));
+      await tester.pumpAndSettle();
+      expect(tester.takeException(), isNull);
+      expect(controller.isExpanded(nestedChild), isFalse);
+      expect(controller.getActiveIndexFor(root), 0);
+      expect(controller.getActiveIndexFor(lastRoot), 1);
+      expect(find.text('Grandchild 0:0:0'), findsNothing);
+    });
   });
 
   group('TreeView', () {
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:io';
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+
+import 'raster_store.dart';
+
+/// A [RasterStore] that stores each raster as a file in a directory.
+///
+/// When the stored rasters exceed [maximumSizeBytes], the least recently used
+/// ones are removed, which eventually removes rasters of assets that have since
+/// changed. Call [clear] to remove all stored rasters, for example when the app
+/// is updated.
+class FileRasterStore implements RasterStore {
+  /// Creates a store that keeps rasters in the directory at [path].
+  ///
+  /// The directory is created when the first raster is stored.
+  FileRasterStore(this.path, {this.maximumSizeBytes = 64 << 20})
+    : assert(maximumSizeBytes >= 0);
+
+  /// The path of the directory rasters are stored in.
+  final String path;
+
+  /// The maximum number of bytes of rasters to keep in the directory.
+  ///
+  /// After a raster is written, the least recently used rasters are removed
+  /// until the directory is within this budget. Reading a raster marks it as
+  /// used. Defaults to 64 MiB.
+  final int maximumSizeBytes;
+
+  File _file(String key) => File('$path${Platform.pathSeparator}$key.rgba');
+
+  @override
+  Future<ui.ImmutableBuffer?> read(String key) async {
+    final File file = _file(key);
+    if (!await file.exists()) {
+      return null;
+    }
+    try {
+      // Mark the raster as recently used, so that it is removed last.
+      await file.setLastModified(DateTime.now());
+    } on FileSystemException {
+      // The raster can still be read, it will just be removed sooner.
+    }
+    return ui.ImmutableBuffer.fromFilePath(file.path);
+  }
+
+  @override
+  Future<void> write(String key, Uint8List pixels) async {
+    final File file = _file(key);
+    await file.parent.create(recursive: true);
+    // Write to a temporary file first, so that a partially written raster is
+    // never read.
+    final temporaryFile = File('${file.path}.$pid.tmp');
+    await temporaryFile.writeAsBytes(pixels, flush: true);
+    await temporaryFile.rename(file.path);
+    await _evict();
+  }
+
+  // Removes the least recently used rasters until the directory is within
+  // [maximumSizeBytes].
+  Future<void> _evict() async {
+    final rasters = <(File, FileStat)>[];
+    var sizeBytes = 0;
+    await for (final FileSystemEntity entity in Directory(path).list()) {
+      if (entity is File && entity.path.endsWith('.rgba')) {
+        final FileStat stat = await entity.stat();
+        rasters.add((entity, stat));
+        sizeBytes += stat.size;
+      }
+    }
+    if (sizeBytes <= maximumSizeBytes) {
+      return;
+    }
+    rasters.sort(
+      ((File, FileStat) a, (File, FileStat) b) =>
+          a.$2.modified.compareTo(b.$2.modified),
+    );
+    for (final (File file, FileStat stat) in rasters) {
+      if (sizeBytes <= maximumSizeBytes) {
+        break;
+      }
+      try {
+        await file.delete();
+      } on FileSystemException {
+        // Another write already removed it.
+      }
+      sizeBytes -= stat.size;
+    }
+  }
+
+  /// Removes all stored rasters.
+  Future<void> clear() async {
+    final directory = Directory(path);
+    if (await directory.exists()) {
+      await directory.delete(recursive: true);
+    }
+  }
+}
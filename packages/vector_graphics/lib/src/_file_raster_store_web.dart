@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+
+import 'raster_store.dart';
+
+/// A [RasterStore] that stores each raster as a file in a directory.
+///
+/// Files are not available on the web, so this always throws an
+/// [UnsupportedError].
+class FileRasterStore implements RasterStore {
+  /// Creates a store that keeps rasters in the directory at [path].
+  FileRasterStore(this.path, {this.maximumSizeBytes = 64 << 20}) {
+    throw UnsupportedError('FileRasterStore is not supported on the web.');
+  }
+
+  /// The path of the directory rasters are stored in.
+  final String path;
+
+  /// The maximum number of bytes of rasters to keep in the directory.
+  final int maximumSizeBytes;
+
+  @override
+  Future<ui.ImmutableBuffer?> read(String key) {
+    throw UnsupportedError('FileRasterStore is not supported on the web.');
+  }
+
+  @override
+  Future<void> write(String key, Uint8List pixels) {
+    throw UnsupportedError('FileRasterStore is not supported on the web.');
+  }
+
+  /// Removes all stored rasters.
+  Future<void> clear() {
+    throw UnsupportedError('FileRasterStore is not supported on the web.');
+  }
+}
@@ -418,6 +418,39 @@ class FlutterVectorGraphicsListener extends VectorGraphicsCodecListener {
     _currentPath = null;
   }
 
+  @override
+  void onPathData(int id, int fillType, Uint8List tags, Float32List points) {
+    onPathStart(id, fillType);
+    // Build the path directly, rather than through a listener call for each
+    // segment.
+    final Path path = _currentPath!;
+    for (var i = 0, j = 0; i < tags.length; i += 1) {
+      switch (tags[i]) {
+        case ControlPointTypes.moveTo:
+          path.moveTo(points[j], points[j + 1]);
+          j += 2;
+        case ControlPointTypes.lineTo:
+          path.lineTo(points[j], points[j + 1]);
+          j += 2;
+        case ControlPointTypes.cubicTo:
+          path.cubicTo(
+            points[j],
+            points[j + 1],
+            points[j + 2],
+            points[j + 3],
+            points[j + 4],
+            points[j + 5],
+          );
+          j += 6;
+        case ControlPointTypes.close:
+          path.close();
+        default:
+          assert(false);
+      }
+    }
+    onPathFinished();
+  }
+
   @override
   void onPathLineTo(double x, double y) {
     _currentPath!.lineTo(x, y);
@@ -0,0 +1,29 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+
+export '_file_raster_store_web.dart'
+    if (dart.library.io) '_file_raster_store_io.dart';
+
+/// Persistent storage for the rasters of vector graphics drawn with
+/// `RenderingStrategy.raster`.
+///
+/// A store lets rasters be reused after the app restarts, instead of each
+/// vector graphic being rasterized again. Rasters are stored as unencoded
+/// RGBA pixels, with the color components premultiplied by alpha. Each key
+/// identifies the contents of the vector graphic, the locale, text direction
+/// and clipping it was decoded with, and the size of the raster, so a store
+/// never needs to check whether a raster is stale. A store is responsible for
+/// limiting the space it uses.
+///
+/// `FileRasterStore` stores rasters as files in a directory.
+abstract class RasterStore {
+  /// Returns the pixels stored for [key], or null if there are none.
+  Future<ui.ImmutableBuffer?> read(String key);
+
+  /// Stores [pixels] for [key], replacing any pixels already stored for it.
+  Future<void> write(String key, Uint8List pixels);
+}
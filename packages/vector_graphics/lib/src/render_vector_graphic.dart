@@ -2,14 +2,20 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:async';
+import 'dart:collection';
+import 'dart:math' as math;
+import 'dart:typed_data';
 import 'dart:ui' as ui;
 
 import 'package:flutter/animation.dart';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/rendering.dart';
+import 'package:flutter/scheduler.dart';
 
 import 'debug.dart';
 import 'listener.dart';
+import 'raster_store.dart';
 
 /// The cache key for a rasterized vector graphic.
 @immutable
@@ -43,12 +49,37 @@ class RasterKey {
 /// The cache entry for a rasterized vector graphic.
 class RasterData {
   /// Create a new [RasterData].
-  RasterData(this._image, this.count, this.key);
+  RasterData(this._image, this.count, this.key) : _slot = Rect.zero;
+
+  RasterData._atlas(this._image, this._page, this._slot, this.key) : count = 0;
 
   /// The rasterized vector graphic.
-  ui.Image get image => _image!;
+  ///
+  /// If the raster was packed into an atlas, this is the atlas image, and
+  /// [source] is the area of it that contains the vector graphic.
+  ui.Image get image => _image ?? _page!.image!;
+
+  // The image of this raster alone. Rasters packed into an atlas only have
+  // one until they are drawn into the atlas at the end of the frame.
   ui.Image? _image;
 
+  _AtlasPage? _page;
+
+  // The area of the atlas page reserved for this raster, including padding.
+  final Rect _slot;
+
+  // Where this raster is drawn in its atlas page.
+  Offset get _origin => _slot.topLeft.translate(
+    _AtlasPage._padding.toDouble(),
+    _AtlasPage._padding.toDouble(),
+  );
+
+  /// The area of [image] that contains the rasterized vector graphic.
+  Rect get source {
+    final Offset origin = _image != null ? Offset.zero : _origin;
+    return origin & Size(key.width.toDouble(), key.height.toDouble());
+  }
+
   /// The cache key used to identify this vector graphic.
   final RasterKey key;
 
@@ -56,10 +87,537 @@ class RasterData {
   /// vector graphic raster data.
   int count = 0;
 
+  /// The number of bytes used by the rasterized vector graphic.
+  int get sizeInBytes => key.width * key.height * 4;
+
   /// Dispose this raster data.
   void dispose() {
     _image?.dispose();
     _image = null;
+    _page?._release(this);
+    _page = null;
+  }
+}
+
+// A shared image that small rasters are packed into.
+//
+// Rasters are packed into shelves: rows that are as tall as the first raster
+// placed in them. The slot of a disposed raster is reused by later rasters
+// that fit in it, and the whole page is disposed once none of its rasters are
+// in use.
+//
+// Rasters added during a frame are drawn into the page together at the end of
+// the frame, so that the page image is copied at most once per frame.
+class _AtlasPage {
+  _AtlasPage(this._cache);
+
+  // The width of each page, and the maximum height it can grow to.
+  static const int _size = 1024;
+
+  // The transparent gap kept around each raster, so that filtering a raster
+  // doesn't sample its neighbours.
+  static const int _padding = 1;
+
+  final RasterCache _cache;
+
+  ui.Image? image;
+
+  // The top, height and filled width of each shelf.
+  final List<int> _shelfTops = <int>[];
+  final List<int> _shelfHeights = <int>[];
+  final List<int> _shelfWidths = <int>[];
+
+  // The slots of disposed rasters.
+  final List<Rect> _freeSlots = <Rect>[];
+
+  // Rasters that have not been drawn into the page yet.
+  final List<RasterData> _pending = <RasterData>[];
+
+  int _entries = 0;
+
+  int get _height =>
+      _shelfTops.isEmpty ? 0 : _shelfTops.last + _shelfHeights.last;
+
+  // Returns a free slot of the page, or null if the page is full.
+  Rect? _allocate(int width, int height) {
+    final int paddedWidth = width + _padding * 2;
+    final int paddedHeight = height + _padding * 2;
+    // Reuse the smallest free slot that fits.
+    int? bestFree;
+    for (var i = 0; i < _freeSlots.length; i++) {
+      final Rect slot = _freeSlots[i];
+      if (slot.width >= paddedWidth &&
+          slot.height >= paddedHeight &&
+          (bestFree == null ||
+              slot.width * slot.height <
+                  _freeSlots[bestFree].width * _freeSlots[bestFree].height)) {
+        bestFree = i;
+      }
+    }
+    if (bestFree != null) {
+      return _freeSlots.removeAt(bestFree);
+    }
+    // Use the shortest shelf that fits, so that small rasters don't waste the
+    // space of taller shelves.
+    int? best;
+    for (var i = 0; i < _shelfTops.length; i++) {
+      if (_shelfHeights[i] >= paddedHeight &&
+          _shelfWidths[i] + paddedWidth <= _size &&
+          (best == null || _shelfHeights[i] < _shelfHeights[best])) {
+        best = i;
+      }
+    }
+    if (best == null) {
+      if (_height + paddedHeight > _size || paddedWidth > _size) {
+        return null;
+      }
+      _shelfTops.add(_height);
+      _shelfHeights.add(paddedHeight);
+      _shelfWidths.add(0);
+      best = _shelfTops.length - 1;
+    }
+    final slot = Rect.fromLTWH(
+      _shelfWidths[best].toDouble(),
+      _shelfTops[best].toDouble(),
+      paddedWidth.toDouble(),
+      _shelfHeights[best].toDouble(),
+    );
+    _shelfWidths[best] += paddedWidth;
+    return slot;
+  }
+
+  // Adds a raster that is drawn into the page at the end of the frame.
+  void _add(RasterData data) {
+    if (_pending.isEmpty) {
+      SchedulerBinding.instance.addPostFrameCallback((Duration _) => _flush());
+    }
+    _pending.add(data);
+    _entries += 1;
+  }
+
+  // Draws the pending rasters into the page, replacing the page image.
+  void _flush() {
+    if (_pending.isEmpty) {
+      return;
+    }
+    final recorder = ui.PictureRecorder();
+    final canvas = ui.Canvas(recorder);
+    if (image != null) {
+      canvas.drawImage(image!, Offset.zero, Paint());
+    }
+    final clear = Paint()..blendMode = BlendMode.clear;
+    for (final RasterData data in _pending) {
+      // The slot may still hold the raster that used it before.
+      canvas.drawRect(data._slot, clear);
+      canvas.drawImage(data._image!, data._origin, Paint());
+    }
+    final ui.Picture pagePicture = recorder.endRecording();
+    final ui.Image updated = pagePicture.toImageSync(_size, _height);
+    pagePicture.dispose();
+    // Pictures that already draw the previous images keep them alive.
+    image?.dispose();
+    image = updated;
+    for (final RasterData data in _pending) {
+      data._image!.dispose();
+      data._image = null;
+    }
+    _pending.clear();
+  }
+
+  void _release(RasterData data) {
+    _pending.remove(data);
+    _freeSlots.add(data._slot);
+    _entries -= 1;
+    if (_entries == 0) {
+      _cache._atlasPages.remove(this);
+      image?.dispose();
+      image = null;
+    }
+  }
+}
+
+/// The cache of rasters shared by vector graphics that are drawn as rasters.
+///
+/// A raster is kept while any vector graphic is drawing it. By default it is
+/// disposed as soon as it is no longer used, and each distinct size a vector
+/// graphic is drawn at creates a new raster. Graphics that animate in size, or
+/// that scroll out of view and back, can avoid being rasterized repeatedly by
+/// setting [sizeStep] and [maximumRetainedBytes].
+///
+/// The cache is available as `vg.rasterCache`.
+class RasterCache {
+  RasterCache._();
+
+  /// The raster cache used by all vector graphics.
+  static final RasterCache instance = RasterCache._();
+
+  final Map<RasterKey, RasterData> _live = <RasterKey, RasterData>{};
+
+  // Rasters that are not in use, from least to most recently released. This
+  // includes rasters read from the store that have not been drawn yet.
+  final LinkedHashMap<RasterKey, RasterData> _retained =
+      LinkedHashMap<RasterKey, RasterData>();
+
+  // The content keys of the vector graphics that can be stored, by asset key.
+  final Map<Object, String> _contentKeys = <Object, String>{};
+
+  /// Where rasters are persisted, so that they can be reused after the app
+  /// restarts.
+  ///
+  /// When this is set, each vector graphic is identified by a hash of its
+  /// encoded contents. Before a vector graphic is first shown, its raster is
+  /// read from the store if one was stored for the same contents and size.
+  /// Otherwise it is rasterized as usual, and the raster is written to the
+  /// store in the background. Rasters packed into an atlas are not stored.
+  ///
+  /// Rasters read from the store are kept like released rasters until they
+  /// are drawn, so they count towards [maximumRetainedBytes]. Rasters larger
+  /// than that budget are neither read nor written, which means that nothing
+  /// is stored while the budget is zero.
+  ///
+  /// Defaults to null, which does not persist rasters.
+  RasterStore? store;
+
+  /// The fraction by which the resolution of rasters is rounded up.
+  ///
+  /// When this is greater than zero, the scale a vector graphic is rasterized
+  /// at is rounded up to the next power of `1 + sizeStep`, and the raster is
+  /// downsampled when it is painted. For example, with a step of 0.1, a
+  /// graphic that is drawn at sizes within 10% of each other shares a single
+  /// raster. This trades some sharpness and memory for fewer rasterizations.
+  ///
+  /// Defaults to zero, which rasterizes each graphic at exactly the size it is
+  /// drawn at.
+  double get sizeStep => _sizeStep;
+  double _sizeStep = 0.0;
+  set sizeStep(double value) {
+    assert(value >= 0.0);
+    _sizeStep = value;
+  }
+
+  /// The maximum width and height, in physical pixels, of rasters that are
+  /// packed into shared atlas images.
+  ///
+  /// When this is greater than zero, rasters that are no larger than this in
+  /// either dimension are drawn into shared images instead of each having an
+  /// image of their own. This saves memory and texture switches when many
+  /// small graphics, such as icons, are drawn as rasters. Rasters are drawn
+  /// from their own images during the frame they are created in, and then
+  /// copied into an atlas at the end of the frame. Each frame that adds
+  /// rasters copies the atlas once, so this is best suited to graphics that are
+  /// rasterized once and drawn for a long time.
+  ///
+  /// Defaults to zero, which gives each raster its own image.
+  int get atlasMaximumExtent => _atlasMaximumExtent;
+  int _atlasMaximumExtent = 0;
+  set atlasMaximumExtent(int value) {
+    assert(value >= 0 && value <= 256);
+    _atlasMaximumExtent = value;
+  }
+
+  final List<_AtlasPage> _atlasPages = <_AtlasPage>[];
+
+  /// The number of atlas images currently holding rasters.
+  int get atlasPageCount => _atlasPages.length;
+
+  /// The maximum number of bytes of rasters to keep after they are no longer
+  /// drawn by any vector graphic.
+  ///
+  /// Rasters that are no longer drawn are kept, up to this budget, so that they
+  /// can be reused if the same graphic is drawn at the same size again. When
+  /// the budget is exceeded, the least recently released rasters are disposed
+  /// first. Rasters that are still being drawn do not count towards the budget.
+  ///
+  /// Defaults to zero, which disposes rasters as soon as they are no longer
+  /// drawn.
+  int get maximumRetainedBytes => _maximumRetainedBytes;
+  int _maximumRetainedBytes = 0;
+  set maximumRetainedBytes(int value) {
+    assert(value >= 0);
+    _maximumRetainedBytes = value;
+    _evictRetained();
+  }
+
+  /// The number of bytes used by rasters that are kept but no longer drawn.
+  int get retainedBytes => _retainedBytes;
+  int _retainedBytes = 0;
+
+  /// The number of times a vector graphic needed a raster that was already in
+  /// the cache.
+  int get hits => _hits;
+  int _hits = 0;
+
+  /// The number of times a vector graphic had to be rasterized because its
+  /// raster was not in the cache.
+  int get misses => _misses;
+  int _misses = 0;
+
+  /// Resets [hits] and [misses] to zero.
+  void resetCounters() {
+    _hits = 0;
+    _misses = 0;
+  }
+
+  /// Disposes all rasters that are kept but no longer drawn.
+  ///
+  /// This includes rasters that were read from the [store] but have not been
+  /// drawn yet.
+  void clearRetained() {
+    for (final RasterData data in _retained.values) {
+      data.dispose();
+    }
+    _retained.clear();
+    _retainedBytes = 0;
+  }
+
+  // Returns the raster scale to use for a graphic drawn at the given scale.
+  double _quantizeScale(double scaleFactor) {
+    if (_sizeStep == 0.0 || scaleFactor <= 0.0) {
+      return scaleFactor;
+    }
+    final double base = math.log(1.0 + _sizeStep);
+    // Allow for floating point error, so that a scale that is already on a step
+    // isn't rounded up to the next one.
+    final double exponent = (math.log(scaleFactor) / base - 1e-9)
+        .ceilToDouble();
+    return math.exp(exponent * base);
+  }
+
+  // Returns a raster that is packed into an atlas at the end of the frame, or
+  // null if the raster should keep an image of its own.
+  RasterData? _packInAtlas(RasterKey key, ui.Image image) {
+    if (key.width > _atlasMaximumExtent || key.height > _atlasMaximumExtent) {
+      return null;
+    }
+    _AtlasPage? page;
+    Rect? slot;
+    for (final _AtlasPage candidate in _atlasPages) {
+      slot = candidate._allocate(key.width, key.height);
+      if (slot != null) {
+        page = candidate;
+        break;
+      }
+    }
+    if (page == null) {
+      page = _AtlasPage(this);
+      slot = page._allocate(key.width, key.height);
+      _atlasPages.add(page);
+    }
+    final data = RasterData._atlas(image, page, slot!, key);
+    page._add(data);
+    return data;
+  }
+
+  RasterKey _keyFor(Object assetKey, Size size, double scaleFactor) {
+    return RasterKey(
+      assetKey,
+      (size.width * scaleFactor).round(),
+      (size.height * scaleFactor).round(),
+    );
+  }
+
+  bool _contains(RasterKey key) {
+    return _live.containsKey(key) || _retained.containsKey(key);
+  }
+
+  RasterData? _obtain(RasterKey key) {
+    RasterData? data = _live[key];
+    if (data == null) {
+      data = _retained.remove(key);
+      if (data != null) {
+        _retainedBytes -= data.sizeInBytes;
+        _live[key] = data;
+      }
+    }
+    if (data != null) {
+      _hits += 1;
+    }
+    return data;
+  }
+
+  void _add(RasterData data) {
+    assert(!_live.containsKey(data.key));
+    assert(!_retained.containsKey(data.key));
+    _misses += 1;
+    _live[data.key] = data;
+  }
+
+  String _storeKey(String contentKey, RasterKey key) {
+    return '$contentKey-${key.width}x${key.height}';
+  }
+
+  Future<void> _restore(
+    Object assetKey,
+    String contentKey,
+    Size size,
+    double scaleFactor,
+  ) async {
+    _contentKeys[assetKey] = contentKey;
+    final RasterStore? store = this.store;
+    final RasterKey key = _keyFor(assetKey, size, scaleFactor);
+    if (store == null ||
+        key.width <= 0 ||
+        key.height <= 0 ||
+        key.width * key.height * 4 > _maximumRetainedBytes ||
+        _contains(key)) {
+      return;
+    }
+    final ui.Image image;
+    try {
+      final ui.ImmutableBuffer? buffer = await store.read(
+        _storeKey(contentKey, key),
+      );
+      if (buffer == null) {
+        return;
+      }
+      final descriptor = ui.ImageDescriptor.raw(
+        buffer,
+        width: key.width,
+        height: key.height,
+        pixelFormat: ui.PixelFormat.rgba8888,
+      );
+      buffer.dispose();
+      final ui.Codec codec = await descriptor.instantiateCodec();
+      descriptor.dispose();
+      image = (await codec.getNextFrame()).image;
+      codec.dispose();
+    } on Exception catch (error) {
+      // The graphic is rasterized again instead.
+      debugPrint('Failed to read stored raster: $error');
+      return;
+    }
+    // The graphic may have been rasterized while the raster was read.
+    if (_contains(key)) {
+      image.dispose();
+      return;
+    }
+    _retain(RasterData(image, 0, key));
+  }
+
+  void _persist(RasterData data) {
+    final RasterStore? store = this.store;
+    final String? contentKey = _contentKeys[data.key.assetKey];
+    // Rasters larger than the retained budget are never read back, so they
+    // are not worth encoding and writing.
+    if (store == null ||
+        contentKey == null ||
+        data._page != null ||
+        data.sizeInBytes > _maximumRetainedBytes) {
+      return;
+    }
+    final String storeKey = _storeKey(contentKey, data.key);
+    unawaited(
+      data.image
+          .toByteData(format: ui.ImageByteFormat.rawRgba)
+          .then((ByteData? pixels) async {
+            if (pixels != null) {
+              await store.write(
+                storeKey,
+                pixels.buffer.asUint8List(
+                  pixels.offsetInBytes,
+                  pixels.lengthInBytes,
+                ),
+              );
+            }
+          })
+          .catchError((Object error) {
+            debugPrint('Failed to store raster: $error');
+          }),
+    );
+  }
+
+  void _release(RasterData data) {
+    if (_live[data.key] != data) {
+      return;
+    }
+    _live.remove(data.key);
+    _retain(data);
+  }
+
+  void _retain(RasterData data) {
+    if (data.sizeInBytes > _maximumRetainedBytes) {
+      data.dispose();
+      return;
+    }
+    _retained[data.key] = data;
+    _retainedBytes += data.sizeInBytes;
+    _evictRetained();
+  }
+
+  void _evictRetained() {
+    while (_retainedBytes > _maximumRetainedBytes) {
+      final RasterData data = _retained.remove(_retained.keys.first)!;
+      _retainedBytes -= data.sizeInBytes;
+      data.dispose();
+    }
+  }
+}
+
+/// Returns a key that identifies the encoded contents of a vector graphic, and
+/// the arguments it was decoded with, for use with a [RasterStore].
+String rasterContentKey(
+  ByteData data, {
+  required ui.Locale? locale,
+  required ui.TextDirection? textDirection,
+  required bool clipViewbox,
+}) {
+  // A 64-bit FNV-1a hash, combined with the length. Keys outlive the app, so
+  // a collision would show another graphic's pixels. The hash is computed in
+  // 32-bit halves, since integers on the web are limited to 53 bits.
+  var high = 0xcbf29ce4;
+  var low = 0x84222325;
+  final Uint8List bytes = data.buffer.asUint8List(
+    data.offsetInBytes,
+    data.lengthInBytes,
+  );
+  for (final int byte in bytes) {
+    low ^= byte;
+    // Multiply by the FNV prime, 2^40 + 0x1b3, modulo 2^64.
+    final int lowProduct = low * 0x1b3;
+    high =
+        (high * 0x1b3 + lowProduct ~/ 0x100000000 + (low & 0xffffff) * 0x100) %
+        0x100000000;
+    low = lowProduct % 0x100000000;
+  }
+  final String length = bytes.length.toRadixString(16);
+  final String digest =
+      high.toRadixString(16).padLeft(8, '0') +
+      low.toRadixString(16).padLeft(8, '0');
+  final String variant = <String>[
+    locale?.toLanguageTag() ?? 'und',
+    textDirection?.name ?? 'none',
+    if (clipViewbox) 'clip' else 'noclip',
+  ].join('-');
+  return '$length-$digest-$variant';
+}
+
+/// Reads the stored raster of a vector graphic with the given contents, so that
+/// a [RenderVectorGraphic] with the same arguments doesn't need to rasterize
+/// it.
+///
+/// Does nothing if [RasterCache.store] is not set.
+Future<void> restoreStoredRaster(
+  Object assetKey,
+  String contentKey,
+  PictureInfo pictureInfo,
+  double devicePixelRatio,
+  double scale,
+) {
+  final RasterCache cache = RasterCache.instance;
+  return cache._restore(
+    assetKey,
+    contentKey,
+    pictureInfo.size,
+    cache._quantizeScale(devicePixelRatio / scale),
+  );
+}
+
+/// For testing only, draw the rasters added during this frame into their
+/// atlas images, as happens at the end of each frame.
+@visibleForTesting
+void debugFlushAtlasPages() {
+  for (final _AtlasPage page in RasterCache.instance._atlasPages) {
+    page._flush();
   }
 }
 
@@ -69,7 +627,11 @@ void debugClearRasteCaches() {
   if (!kDebugMode) {
     return;
   }
-  RenderVectorGraphic._liveRasterCache.clear();
+  RasterCache.instance._live.clear();
+  RasterCache.instance._atlasPages.clear();
+  RasterCache.instance._contentKeys.clear();
+  RasterCache.instance.clearRetained();
+  RasterCache.instance.resetCounters();
 }
 
 /// A render object which draws a vector graphic instance as a raster.
@@ -87,9 +649,6 @@ class RenderVectorGraphic extends RenderBox {
     _updateOpacity();
   }
 
-  static final Map<RasterKey, RasterData> _liveRasterCache =
-      <RasterKey, RasterData>{};
-
   /// A key that uniquely identifies the [pictureInfo] used for this vg.
   Object get assetKey => _assetKey;
   Object _assetKey;
@@ -218,7 +777,8 @@ class RenderVectorGraphic extends RenderBox {
       scaledWidth,
       scaledHeight,
     );
-    return RasterData(pending, 0, key);
+    return RasterCache.instance._packInAtlas(key, pending) ??
+        RasterData(pending, 0, key);
   }
 
   void _maybeReleaseRaster(RasterData? data) {
@@ -226,9 +786,8 @@ class RenderVectorGraphic extends RenderBox {
       return;
     }
     data.count -= 1;
-    if (data.count == 0 && _liveRasterCache.containsKey(data.key)) {
-      _liveRasterCache.remove(data.key);
-      data.dispose();
+    if (data.count == 0) {
+      RasterCache.instance._release(data);
     }
   }
 
@@ -236,35 +795,34 @@ class RenderVectorGraphic extends RenderBox {
   // is sufficiently different. Returns `null` if rasterData has been
   // updated immediately.
   void _maybeUpdateRaster() {
-    final int scaledWidth = (pictureInfo.size.width * devicePixelRatio / scale)
-        .round();
-    final int scaledHeight =
-        (pictureInfo.size.height * devicePixelRatio / scale).round();
-    final key = RasterKey(assetKey, scaledWidth, scaledHeight);
+    final RasterCache cache = RasterCache.instance;
+    final double scaleFactor = cache._quantizeScale(devicePixelRatio / scale);
+    final RasterKey key = cache._keyFor(
+      assetKey,
+      pictureInfo.size,
+      scaleFactor,
+    );
 
     // First check if the raster is available synchronously. This also handles
     // a no-op change that would resolve to an identical picture.
-    if (_liveRasterCache.containsKey(key)) {
-      final RasterData data = _liveRasterCache[key]!;
-      if (data != _rasterData) {
-        _maybeReleaseRaster(_rasterData);
-        data.count += 1;
-      }
-      _rasterData = data;
+    if (_rasterData?.key == key) {
       return;
     }
-    final RasterData data = _createRaster(
-      key,
-      devicePixelRatio / scale,
-      pictureInfo,
-    );
+    final RasterData? cached = cache._obtain(key);
+    if (cached != null) {
+      cached.count += 1;
+      _maybeReleaseRaster(_rasterData);
+      _rasterData = cached;
+      return;
+    }
+    final RasterData data = _createRaster(key, scaleFactor, pictureInfo);
     data.count += 1;
 
-    assert(!_liveRasterCache.containsKey(key));
     assert(data.count == 1);
     assert(!debugDisposed!);
 
-    _liveRasterCache[key] = data;
+    cache._add(data);
+    cache._persist(data);
     _maybeReleaseRaster(_rasterData);
     _rasterData = data;
   }
@@ -308,8 +866,6 @@ class RenderVectorGraphic extends RenderBox {
 
     _maybeUpdateRaster();
     final ui.Image image = _rasterData!.image;
-    final int width = _rasterData!.key.width;
-    final int height = _rasterData!.key.height;
 
     // Use `FilterQuality.low` to scale the image, which corresponds to
     // bilinear interpolation.
@@ -318,7 +874,7 @@ class RenderVectorGraphic extends RenderBox {
       colorPaint.colorFilter = colorFilter;
     }
     colorPaint.color = Color.fromRGBO(0, 0, 0, _opacityValue);
-    final src = ui.Rect.fromLTWH(0, 0, width.toDouble(), height.toDouble());
+    final ui.Rect src = _rasterData!.source;
     final dst = ui.Rect.fromLTWH(
       offset.dx,
       offset.dy,
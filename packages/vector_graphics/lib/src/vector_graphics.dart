@@ -18,6 +18,8 @@ import 'render_vector_graphic.dart';
 
 export 'listener.dart' show PictureInfo;
 export 'loader.dart';
+export 'raster_store.dart';
+export 'render_vector_graphic.dart' show RasterCache;
 
 /// How the vector graphic will be rendered by the Flutter framework.
 ///
@@ -275,11 +277,14 @@ class VectorGraphic extends StatefulWidget {
 }
 
 class _PictureData {
-  _PictureData(this.pictureInfo, this.count, this.key);
+  _PictureData(this.pictureInfo, this.count, this.key, this.contentKey);
 
   final PictureInfo pictureInfo;
   _PictureKey key;
   int count = 0;
+
+  /// Identifies the encoded contents of the picture, if rasters are stored.
+  final String? contentKey;
 }
 
 @immutable
@@ -362,9 +367,18 @@ class _VectorGraphicWidgetState extends State<VectorGraphic> {
     if (_pendingPictures.containsKey(key)) {
       return _pendingPictures[key]!;
     }
+    String? contentKey;
     final Future<_PictureData> result = loader
         .loadBytes(context)
         .then((ByteData data) {
+          if (RasterCache.instance.store != null) {
+            contentKey = rasterContentKey(
+              data,
+              locale: key.locale,
+              textDirection: key.textDirection,
+              clipViewbox: key.clipViewbox,
+            );
+          }
           return decodeVectorGraphics(
             data,
             locale: key.locale,
@@ -374,7 +388,7 @@ class _VectorGraphicWidgetState extends State<VectorGraphic> {
           );
         })
         .then((PictureInfo pictureInfo) {
-          return _PictureData(pictureInfo, 0, key);
+          return _PictureData(pictureInfo, 0, key, contentKey);
         });
     _pendingPictures[key] = result;
     result.whenComplete(() {
@@ -414,6 +428,9 @@ class _VectorGraphicWidgetState extends State<VectorGraphic> {
     }
     // If not, then check if there is a pending load.
     final BytesLoader loader = widget.loader;
+    final double? devicePixelRatio = RasterCache.instance.store == null
+        ? null
+        : MediaQuery.maybeDevicePixelRatioOf(context) ?? 1.0;
 
     try {
       final _PictureData data = await _loadPicture(context, key, loader);
@@ -430,6 +447,25 @@ class _VectorGraphicWidgetState extends State<VectorGraphic> {
         _livePictureCache[key] = data;
       }
 
+      // Read a stored raster before the graphic is first painted, so that it
+      // doesn't need to be rasterized.
+      if (devicePixelRatio != null &&
+          data.contentKey != null &&
+          widget.strategy == RenderingStrategy.raster &&
+          !_webRenderObject) {
+        await restoreStoredRaster(
+          data.key,
+          data.contentKey!,
+          data.pictureInfo,
+          devicePixelRatio,
+          _computeScale(data.pictureInfo, _computeSize(data.pictureInfo)),
+        );
+        if (!mounted || loader != widget.loader) {
+          _maybeReleasePicture(data);
+          return;
+        }
+      }
+
       setState(() {
         _maybeReleasePicture(_pictureInfo);
         _pictureInfo = data;
@@ -441,35 +477,44 @@ class _VectorGraphicWidgetState extends State<VectorGraphic> {
 
   static final bool _webRenderObject = useHtmlRenderObject();
 
+  // The size to draw the picture at, before it is fit into its parent.
+  //
+  // If the caller did not specify a width or height, fall back to the size of
+  // the graphic. If the caller did specify a width or height, preserve the
+  // aspect ratio of the graphic and center it within that width and height.
+  Size _computeSize(PictureInfo pictureInfo) {
+    double? width = widget.width;
+    double? height = widget.height;
+
+    if (width == null && height == null) {
+      width = pictureInfo.size.width;
+      height = pictureInfo.size.height;
+    } else if (height != null && !pictureInfo.size.isEmpty) {
+      width = height / pictureInfo.size.height * pictureInfo.size.width;
+    } else if (width != null && !pictureInfo.size.isEmpty) {
+      height = width / pictureInfo.size.width * pictureInfo.size.height;
+    }
+
+    assert(width != null && height != null);
+    return Size(width!, height!);
+  }
+
+  // The ratio of the picture size to the size it is drawn at.
+  double _computeScale(PictureInfo pictureInfo, Size size) {
+    return math.min(
+      pictureInfo.size.width / size.width,
+      pictureInfo.size.height / size.height,
+    );
+  }
+
   @override
   Widget build(BuildContext context) {
     final PictureInfo? pictureInfo = _pictureInfo?.pictureInfo;
 
     Widget child;
     if (pictureInfo != null) {
-      // If the caller did not specify a width or height, fall back to the
-      // size of the graphic.
-      // If the caller did specify a width or height, preserve the aspect ratio
-      // of the graphic and center it within that width and height.
-      double? width = widget.width;
-      double? height = widget.height;
-
-      if (width == null && height == null) {
-        width = pictureInfo.size.width;
-        height = pictureInfo.size.height;
-      } else if (height != null && !pictureInfo.size.isEmpty) {
-        width = height / pictureInfo.size.height * pictureInfo.size.width;
-      } else if (width != null && !pictureInfo.size.isEmpty) {
-        height = width / pictureInfo.size.width * pictureInfo.size.height;
-      }
-
-      assert(width != null && height != null);
-
-      var scale = 1.0;
-      scale = math.min(
-        pictureInfo.size.width / width!,
-        pictureInfo.size.height / height!,
-      );
+      final Size size = _computeSize(pictureInfo);
+      final double scale = _computeScale(pictureInfo, size);
 
       if (_webRenderObject) {
         child = _RawWebVectorGraphicWidget(
@@ -508,8 +553,8 @@ class _VectorGraphicWidgetState extends State<VectorGraphic> {
       }
 
       child = SizedBox(
-        width: width,
-        height: height,
+        width: size.width,
+        height: size.height,
         child: FittedBox(
           fit: widget.fit,
           alignment: widget.alignment,
@@ -688,6 +733,10 @@ class VectorGraphicUtilities {
     );
   }
 
+  /// The cache of rasters used by vector graphics drawn with
+  /// [RenderingStrategy.raster].
+  RasterCache get rasterCache => RasterCache.instance;
+
   /// Load the [PictureInfo] from a given [loader].
   ///
   /// It is the caller's responsibility to handle disposing the picture when
@@ -6,8 +6,11 @@ export 'src/vector_graphics.dart'
     show
         AssetBytesLoader,
         BytesLoader,
+        FileRasterStore,
         NetworkBytesLoader,
         PictureInfo,
+        RasterCache,
+        RasterStore,
         RenderingStrategy,
         VectorGraphic,
         VectorGraphicUtilities,
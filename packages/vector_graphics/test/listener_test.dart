@@ -11,6 +11,8 @@ import 'package:flutter/widgets.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:vector_graphics/src/listener.dart';
 import 'package:vector_graphics/vector_graphics_compat.dart';
+import 'package:vector_graphics_codec/vector_graphics_codec.dart'
+    show ControlPointTypes;
 import 'package:vector_graphics_compiler/vector_graphics_compiler.dart';
 
 void main() {
@@ -101,6 +103,29 @@ void main() {
     );
   });
 
+  test('Builds paths from whole path data', () async {
+    final factory = TestPictureFactory();
+    final listener = FlutterVectorGraphicsListener(pictureFactory: factory);
+    listener.onPathData(
+      0,
+      ui.PathFillType.evenOdd.index,
+      Uint8List.fromList(<int>[
+        ControlPointTypes.moveTo,
+        ControlPointTypes.lineTo,
+        ControlPointTypes.cubicTo,
+        ControlPointTypes.close,
+      ]),
+      Float32List.fromList(<double>[0, 0, 10, 0, 10, 5, 10, 10, 0, 20]),
+    );
+    await listener.onDrawPath(0, null, null);
+
+    final Invocation drawPath = factory.fakeCanvases.last.invocations.single;
+    expect(drawPath.memberName, #drawPath);
+    final path = drawPath.positionalArguments[0] as ui.Path;
+    expect(path.fillType, ui.PathFillType.evenOdd);
+    expect(path.getBounds(), const ui.Rect.fromLTRB(0, 0, 10, 20));
+  });
+
   test('Text position is respected', () async {
     final factory = TestPictureFactory();
     final listener = FlutterVectorGraphicsListener(pictureFactory: factory);
@@ -6,6 +6,8 @@
 @TestOn('!chrome')
 library;
 
+import 'dart:async';
+import 'dart:io';
 import 'dart:typed_data';
 import 'dart:ui' as ui;
 
@@ -18,6 +20,7 @@ import 'package:vector_graphics/vector_graphics.dart';
 import 'package:vector_graphics_codec/vector_graphics_codec.dart';
 
 void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
   late PictureInfo pictureInfo;
 
   tearDown(() {
@@ -417,6 +420,425 @@ void main() {
     expect(opacity._listeners, hasLength(0));
   });
 
+  test('Rasters are shared by scales within the same size step', () async {
+    final RasterCache cache = vg.rasterCache;
+    addTearDown(() => cache.sizeStep = 0.0);
+    cache.sizeStep = 0.1;
+    final renderVectorGraphicA = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.02,
+      null,
+      1.0,
+    );
+    final renderVectorGraphicB = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.08,
+      null,
+      1.0,
+    );
+    renderVectorGraphicA.layout(BoxConstraints.tight(const Size(50, 50)));
+    renderVectorGraphicB.layout(BoxConstraints.tight(const Size(50, 50)));
+    final context = FakeHistoryPaintingContext();
+
+    renderVectorGraphicA.paint(context, Offset.zero);
+    renderVectorGraphicB.paint(context, Offset.zero);
+
+    // Both are rounded up to a scale of 1.1.
+    expect(context.canvas.images, hasLength(2));
+    expect(identical(context.canvas.images[0], context.canvas.images[1]), true);
+    expect(context.canvas.images[0].width, 55);
+    expect(cache.hits, 1);
+    expect(cache.misses, 1);
+  });
+
+  test('Released rasters are retained within the byte budget', () async {
+    final RasterCache cache = vg.rasterCache;
+    addTearDown(() => cache.maximumRetainedBytes = 0);
+    cache.maximumRetainedBytes = 50 * 50 * 4;
+    final renderVectorGraphicA = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    final renderVectorGraphicB = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphicA.layout(BoxConstraints.tight(const Size(50, 50)));
+    final context = FakeHistoryPaintingContext();
+
+    renderVectorGraphicA.paint(context, Offset.zero);
+    renderVectorGraphicA.dispose();
+
+    expect(context.canvas.images[0].debugDisposed, false);
+    expect(cache.retainedBytes, 50 * 50 * 4);
+
+    renderVectorGraphicB.layout(BoxConstraints.tight(const Size(50, 50)));
+    renderVectorGraphicB.paint(context, Offset.zero);
+
+    expect(context.canvas.images, hasLength(2));
+    expect(identical(context.canvas.images[0], context.canvas.images[1]), true);
+    expect(cache.retainedBytes, 0);
+    expect(cache.hits, 1);
+    expect(cache.misses, 1);
+
+    // Rasters that no longer fit in the budget are disposed.
+    renderVectorGraphicB.dispose();
+    expect(cache.retainedBytes, 50 * 50 * 4);
+    cache.maximumRetainedBytes = 0;
+    expect(cache.retainedBytes, 0);
+    expect(context.canvas.images[0].debugDisposed, true);
+  });
+
+  test('Small rasters are packed into a shared atlas', () async {
+    final RasterCache cache = vg.rasterCache;
+    addTearDown(() => cache.atlasMaximumExtent = 0);
+    cache.atlasMaximumExtent = 64;
+    final renderVectorGraphicA = RenderVectorGraphic(
+      pictureInfo,
+      'testA',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    final renderVectorGraphicB = RenderVectorGraphic(
+      pictureInfo,
+      'testB',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphicA.layout(BoxConstraints.tight(const Size(50, 50)));
+    renderVectorGraphicB.layout(BoxConstraints.tight(const Size(50, 50)));
+    final context = FakeHistoryPaintingContext();
+
+    renderVectorGraphicA.paint(context, Offset.zero);
+    renderVectorGraphicB.paint(context, Offset.zero);
+
+    // Until the end of the frame, each raster is drawn from its own image.
+    expect(cache.atlasPageCount, 1);
+    expect(context.canvas.srcs, <Rect>[
+      const Rect.fromLTWH(0, 0, 50, 50),
+      const Rect.fromLTWH(0, 0, 50, 50),
+    ]);
+
+    debugFlushAtlasPages();
+    expect(context.canvas.images[0].debugDisposed, true);
+    expect(context.canvas.images[1].debugDisposed, true);
+
+    renderVectorGraphicA.paint(context, Offset.zero);
+    renderVectorGraphicB.paint(context, Offset.zero);
+    expect(context.canvas.srcs.skip(2), <Rect>[
+      const Rect.fromLTWH(1, 1, 50, 50),
+      const Rect.fromLTWH(53, 1, 50, 50),
+    ]);
+    expect(context.canvas.images[2], same(context.canvas.images[3]));
+    expect(context.canvas.images[2].height, 52);
+
+    renderVectorGraphicA.dispose();
+    expect(context.canvas.images[2].debugDisposed, false);
+    renderVectorGraphicB.dispose();
+    expect(context.canvas.images[2].debugDisposed, true);
+    expect(cache.atlasPageCount, 0);
+  });
+
+  test('Atlas slots of disposed rasters are reused', () async {
+    final RasterCache cache = vg.rasterCache;
+    addTearDown(() => cache.atlasMaximumExtent = 0);
+    cache.atlasMaximumExtent = 64;
+    RenderVectorGraphic createRenderObject(String assetKey) {
+      final renderVectorGraphic = RenderVectorGraphic(
+        pictureInfo,
+        assetKey,
+        null,
+        1.0,
+        null,
+        1.0,
+      );
+      renderVectorGraphic.layout(BoxConstraints.tight(const Size(50, 50)));
+      return renderVectorGraphic;
+    }
+
+    final RenderVectorGraphic renderVectorGraphicA = createRenderObject(
+      'testA',
+    );
+    final RenderVectorGraphic renderVectorGraphicB = createRenderObject(
+      'testB',
+    );
+    final context = FakeHistoryPaintingContext();
+    renderVectorGraphicA.paint(context, Offset.zero);
+    renderVectorGraphicB.paint(context, Offset.zero);
+    debugFlushAtlasPages();
+    renderVectorGraphicA.dispose();
+
+    final RenderVectorGraphic renderVectorGraphicC = createRenderObject(
+      'testC',
+    );
+    renderVectorGraphicC.paint(context, Offset.zero);
+    debugFlushAtlasPages();
+    renderVectorGraphicC.paint(context, Offset.zero);
+
+    expect(cache.atlasPageCount, 1);
+    expect(context.canvas.srcs.last, const Rect.fromLTWH(1, 1, 50, 50));
+    expect(context.canvas.images.last.height, 52);
+
+    renderVectorGraphicB.dispose();
+    renderVectorGraphicC.dispose();
+  });
+
+  test('Rasters larger than the atlas extent get their own image', () async {
+    final RasterCache cache = vg.rasterCache;
+    addTearDown(() => cache.atlasMaximumExtent = 0);
+    cache.atlasMaximumExtent = 32;
+    final renderVectorGraphic = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphic.layout(BoxConstraints.tight(const Size(50, 50)));
+    final context = FakePaintingContext();
+    renderVectorGraphic.paint(context, Offset.zero);
+
+    expect(cache.atlasPageCount, 0);
+    expect(context.canvas.lastSrc, const Rect.fromLTWH(0, 0, 50, 50));
+  });
+
+  test('Rasters are written to and restored from the store', () async {
+    final RasterCache cache = vg.rasterCache;
+    final store = FakeRasterStore();
+    addTearDown(() {
+      cache.store = null;
+      cache.maximumRetainedBytes = 0;
+    });
+    cache.store = store;
+    cache.maximumRetainedBytes = 50 * 50 * 4;
+
+    await restoreStoredRaster('test', 'content', pictureInfo, 1.0, 1.0);
+    final renderVectorGraphicA = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphicA.layout(BoxConstraints.tight(const Size(50, 50)));
+    renderVectorGraphicA.paint(FakeHistoryPaintingContext(), Offset.zero);
+    renderVectorGraphicA.dispose();
+    await store.written.future;
+
+    expect(store.pixels.keys, <String>['content-50x50']);
+    expect(store.pixels['content-50x50'], hasLength(50 * 50 * 4));
+
+    cache.clearRetained();
+    cache.resetCounters();
+    await restoreStoredRaster('test', 'content', pictureInfo, 1.0, 1.0);
+    expect(cache.retainedBytes, 50 * 50 * 4);
+    final renderVectorGraphicB = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphicB.layout(BoxConstraints.tight(const Size(50, 50)));
+    final context = FakeHistoryPaintingContext();
+    renderVectorGraphicB.paint(context, Offset.zero);
+
+    expect(cache.hits, 1);
+    expect(cache.misses, 0);
+    expect(cache.retainedBytes, 0);
+    expect(context.canvas.images.single.width, 50);
+  });
+
+  test('Stored rasters are not read beyond the retained budget', () async {
+    final RasterCache cache = vg.rasterCache;
+    final store = FakeRasterStore();
+    addTearDown(() => cache.store = null);
+    cache.store = store;
+    store.pixels['content-50x50'] = Uint8List(50 * 50 * 4);
+
+    await restoreStoredRaster('test', 'content', pictureInfo, 1.0, 1.0);
+
+    expect(store.reads, 0);
+    expect(cache.retainedBytes, 0);
+  });
+
+  test('Rasters are not stored beyond the retained budget', () async {
+    final RasterCache cache = vg.rasterCache;
+    final store = FakeRasterStore();
+    addTearDown(() => cache.store = null);
+    cache.store = store;
+
+    await restoreStoredRaster('test', 'content', pictureInfo, 1.0, 1.0);
+    final renderVectorGraphic = RenderVectorGraphic(
+      pictureInfo,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphic.layout(BoxConstraints.tight(const Size(50, 50)));
+    renderVectorGraphic.paint(FakeHistoryPaintingContext(), Offset.zero);
+    renderVectorGraphic.dispose();
+    await pumpEventQueue();
+
+    expect(store.pixels, isEmpty);
+  });
+
+  test('Stored rasters keep translucent pixels', () async {
+    final buffer = VectorGraphicsBuffer();
+    const codec = VectorGraphicsCodec();
+    codec.writeSize(buffer, 2, 2);
+    final int paintId = codec.writeFill(buffer, 0x80ff0000, 0);
+    final int pathId = codec.writePath(
+      buffer,
+      Uint8List.fromList(<int>[
+        ControlPointTypes.moveTo,
+        ControlPointTypes.lineTo,
+        ControlPointTypes.lineTo,
+        ControlPointTypes.lineTo,
+        ControlPointTypes.close,
+      ]),
+      Float32List.fromList(<double>[0, 0, 2, 0, 2, 2, 0, 2]),
+      0,
+    );
+    codec.writeDrawPath(buffer, pathId, paintId, null);
+    final PictureInfo translucent = await decodeVectorGraphics(
+      buffer.done(),
+      locale: null,
+      textDirection: null,
+      clipViewbox: true,
+      loader: TestBytesLoader(Uint8List(0).buffer.asByteData()),
+    );
+    final RasterCache cache = vg.rasterCache;
+    final store = FakeRasterStore();
+    addTearDown(() {
+      cache.store = null;
+      cache.maximumRetainedBytes = 0;
+    });
+    cache.store = store;
+    cache.maximumRetainedBytes = 2 * 2 * 4;
+
+    await restoreStoredRaster('test', 'content', translucent, 1.0, 1.0);
+    final renderVectorGraphicA = RenderVectorGraphic(
+      translucent,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphicA.layout(BoxConstraints.tight(const Size(2, 2)));
+    final contextA = FakeHistoryPaintingContext();
+    renderVectorGraphicA.paint(contextA, Offset.zero);
+    final ui.Image rasterizedImage = contextA.canvas.images.single;
+    final ByteData rasterized = (await rasterizedImage.toByteData())!;
+    renderVectorGraphicA.dispose();
+    await store.written.future;
+
+    expect(store.pixels['content-2x2'], rasterized.buffer.asUint8List());
+
+    cache.clearRetained();
+    await restoreStoredRaster('test', 'content', translucent, 1.0, 1.0);
+    final renderVectorGraphicB = RenderVectorGraphic(
+      translucent,
+      'test',
+      null,
+      1.0,
+      null,
+      1.0,
+    );
+    renderVectorGraphicB.layout(BoxConstraints.tight(const Size(2, 2)));
+    final contextB = FakeHistoryPaintingContext();
+    renderVectorGraphicB.paint(contextB, Offset.zero);
+    final ui.Image restoredImage = contextB.canvas.images.single;
+    final ByteData restored = (await restoredImage.toByteData())!;
+
+    expect(cache.hits, 1);
+    // The color is half transparent red, stored premultiplied by its alpha.
+    expect(rasterized.getUint8(3), 0x80);
+    expect(restored.buffer.asUint8List(), rasterized.buffer.asUint8List());
+  });
+
+  test('Raster content keys are 64-bit hashes', () {
+    final String key = rasterContentKey(
+      Uint8List(0).buffer.asByteData(),
+      locale: null,
+      textDirection: null,
+      clipViewbox: true,
+    );
+
+    // The FNV-1a offset basis, for no input.
+    expect(key, startsWith('0-cbf29ce484222325-'));
+  });
+
+  test('FileRasterStore removes the least recently used rasters', () async {
+    final Directory directory = Directory.systemTemp.createTempSync('rasters');
+    addTearDown(() => directory.deleteSync(recursive: true));
+    final store = FileRasterStore(directory.path, maximumSizeBytes: 8);
+    File file(String name) =>
+        File('${directory.path}${Platform.pathSeparator}$name');
+
+    await store.write('a', Uint8List(4));
+    file('a.rgba').setLastModifiedSync(DateTime(2000));
+    await store.write('b', Uint8List(4));
+    file('b.rgba').setLastModifiedSync(DateTime(2001));
+    await store.write('c', Uint8List(4));
+
+    expect(file('a.rgba').existsSync(), false);
+    expect(file('b.rgba').existsSync(), true);
+    expect(file('c.rgba').existsSync(), true);
+  });
+
+  test('Raster content keys depend on the encoded bytes and arguments', () {
+    String contentKey(
+      List<int> bytes, {
+      Locale? locale = const Locale('en', 'US'),
+      TextDirection? textDirection = TextDirection.ltr,
+      bool clipViewbox = true,
+    }) {
+      return rasterContentKey(
+        Uint8List.fromList(bytes).buffer.asByteData(),
+        locale: locale,
+        textDirection: textDirection,
+        clipViewbox: clipViewbox,
+      );
+    }
+
+    final String key = contentKey(<int>[1, 2, 3]);
+
+    expect(contentKey(<int>[1, 2, 3]), key);
+    expect(contentKey(<int>[1, 2, 4]), isNot(key));
+    expect(
+      contentKey(<int>[1, 2, 3], locale: const Locale('fr', 'CH')),
+      isNot(key),
+    );
+    expect(
+      contentKey(<int>[1, 2, 3], textDirection: TextDirection.rtl),
+      isNot(key),
+    );
+    expect(contentKey(<int>[1, 2, 3], clipViewbox: false), isNot(key));
+  });
+
   test('RasterData.dispose is safe to call multiple times', () async {
     final recorder = ui.PictureRecorder();
     ui.Canvas(recorder);
@@ -508,10 +930,34 @@ class FakeCanvas extends Fake implements Canvas {
 
 class FakeHistoryCanvas extends Fake implements Canvas {
   final List<ui.Image> images = <ui.Image>[];
+  final List<Rect> srcs = <Rect>[];
 
   @override
   void drawImageRect(ui.Image image, Rect src, Rect dst, Paint paint) {
     images.add(image);
+    srcs.add(src);
+  }
+}
+
+class FakeRasterStore implements RasterStore {
+  final Map<String, Uint8List> pixels = <String, Uint8List>{};
+  final Completer<void> written = Completer<void>();
+  int reads = 0;
+
+  @override
+  Future<ui.ImmutableBuffer?> read(String key) async {
+    reads += 1;
+    final Uint8List? stored = pixels[key];
+    if (stored == null) {
+      return null;
+    }
+    return ui.ImmutableBuffer.fromUint8List(stored);
+  }
+
+  @override
+  Future<void> write(String key, Uint8List pixels) async {
+    this.pixels[key] = pixels;
+    written.complete();
   }
 }
 
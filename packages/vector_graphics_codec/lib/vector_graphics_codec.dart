@@ -835,36 +835,7 @@ class VectorGraphicsCodec {
     } else {
       points = buffer.getFloat32List(pointLength);
     }
-    listener?.onPathStart(id, fillType);
-    for (var i = 0, j = 0; i < tagLength; i += 1) {
-      switch (tags[i]) {
-        case ControlPointTypes.moveTo:
-          listener?.onPathMoveTo(points[j], points[j + 1]);
-          j += 2;
-          continue;
-        case ControlPointTypes.lineTo:
-          listener?.onPathLineTo(points[j], points[j + 1]);
-          j += 2;
-          continue;
-        case ControlPointTypes.cubicTo:
-          listener?.onPathCubicTo(
-            points[j],
-            points[j + 1],
-            points[j + 2],
-            points[j + 3],
-            points[j + 4],
-            points[j + 5],
-          );
-          j += 6;
-          continue;
-        case ControlPointTypes.close:
-          listener?.onPathClose();
-          continue;
-        default:
-          assert(false);
-      }
-    }
-    listener?.onPathFinished();
+    listener?.onPathData(id, fillType, tags, points);
   }
 
   void _readDrawPath(
@@ -1064,6 +1035,50 @@ abstract class VectorGraphicsCodecListener {
     required int? shaderId,
   });
 
+  /// A complete path object has been decoded, with the given [id] and
+  /// [fillType].
+  ///
+  /// [tags] holds one of the [ControlPointTypes] for each segment of the path,
+  /// and [points] holds the coordinates used by those segments, in order. Both
+  /// may be views of the data being decoded, and must be copied if they are
+  /// kept after this call.
+  ///
+  /// By default, this calls [onPathStart], then the path command callback for
+  /// each segment, then [onPathFinished]. Listeners can override this to build
+  /// the whole path at once instead.
+  void onPathData(int id, int fillType, Uint8List tags, Float32List points) {
+    onPathStart(id, fillType);
+    for (var i = 0, j = 0; i < tags.length; i += 1) {
+      switch (tags[i]) {
+        case ControlPointTypes.moveTo:
+          onPathMoveTo(points[j], points[j + 1]);
+          j += 2;
+          continue;
+        case ControlPointTypes.lineTo:
+          onPathLineTo(points[j], points[j + 1]);
+          j += 2;
+          continue;
+        case ControlPointTypes.cubicTo:
+          onPathCubicTo(
+            points[j],
+            points[j + 1],
+            points[j + 2],
+            points[j + 3],
+            points[j + 4],
+            points[j + 5],
+          );
+          j += 6;
+          continue;
+        case ControlPointTypes.close:
+          onPathClose();
+          continue;
+        default:
+          assert(false);
+      }
+    }
+    onPathFinished();
+  }
+
   /// A path object is being created, with the given [id] and [fillType].
   ///
   /// All subsequent path commands will refer to this path, until
@@ -861,6 +861,57 @@ void main() {
       const OnDrawPath(0, 1, null),
     ]);
   });
+
+  test('Paths can be decoded as whole arrays', () {
+    final buffer = VectorGraphicsBuffer();
+    final listener = PathDataListener();
+    final int paintId = codec.writeFill(buffer, 23, 0);
+    final int pathId = codec.writePath(
+      buffer,
+      Uint8List.fromList(<int>[
+        ControlPointTypes.moveTo,
+        ControlPointTypes.cubicTo,
+        ControlPointTypes.close,
+      ]),
+      Float32List.fromList(<double>[1, 2, 3, 4, 5, 6, 7, 8]),
+      1,
+    );
+    codec.writeDrawPath(buffer, pathId, paintId, null);
+
+    codec.decode(buffer.done(), listener);
+
+    expect(listener.commands, <Object>[
+      OnPaintObject(
+        color: 23,
+        strokeCap: null,
+        strokeJoin: null,
+        blendMode: 0,
+        strokeMiterLimit: null,
+        strokeWidth: null,
+        paintStyle: 0,
+        id: paintId,
+        shaderId: null,
+      ),
+      OnPathData(
+        pathId,
+        1,
+        <int>[
+          ControlPointTypes.moveTo,
+          ControlPointTypes.cubicTo,
+          ControlPointTypes.close,
+        ],
+        <double>[1, 2, 3, 4, 5, 6, 7, 8],
+      ),
+      OnDrawPath(pathId, paintId, null),
+    ]);
+  });
+}
+
+class PathDataListener extends TestListener {
+  @override
+  void onPathData(int id, int fillType, Uint8List tags, Float32List points) {
+    commands.add(OnPathData(id, fillType, tags.toList(), points.toList()));
+  }
 }
 
 class TestListener extends VectorGraphicsCodecListener {
@@ -1527,6 +1578,31 @@ class OnPathStart {
   String toString() => 'OnPathStart($id, $fillType)';
 }
 
+@immutable
+class OnPathData {
+  const OnPathData(this.id, this.fillType, this.tags, this.points);
+
+  final int id;
+  final int fillType;
+  final List<int> tags;
+  final List<double> points;
+
+  @override
+  int get hashCode =>
+      Object.hash(id, fillType, Object.hashAll(tags), Object.hashAll(points));
+
+  @override
+  bool operator ==(Object other) =>
+      other is OnPathData &&
+      other.id == id &&
+      other.fillType == fillType &&
+      _listEquals(other.tags, tags) &&
+      _listEquals(other.points, points);
+
+  @override
+  String toString() => 'OnPathData($id, $fillType, $tags, $points)';
+}
+
 @immutable
 class OnSize {
   const OnSize(this.width, this.height);
@@ -29,23 +29,84 @@ class Cache {
     if (maximumSize == 0) {
       clear();
     } else {
-      while (_cache.length > maximumSize) {
-        _cache.remove(_cache.keys.first);
-      }
+      _checkCacheSize();
     }
   }
 
+  /// Maximum number of bytes of encoded SVGs to store in the cache.
+  ///
+  /// Once the cache holds this many bytes, the least-recently-used entries are
+  /// evicted when adding a new entry. Entries larger than this are not cached.
+  int get maximumSizeBytes => _maximumSizeBytes;
+  int _maximumSizeBytes = 10 << 20; // 10 MiB
+
+  /// Changes the maximum cache size in bytes.
+  ///
+  /// If the new size is smaller than the current size of the cache, the
+  /// least-recently-used entries are evicted immediately.
+  set maximumSizeBytes(int value) {
+    assert(value >= 0);
+    if (value == maximumSizeBytes) {
+      return;
+    }
+    _maximumSizeBytes = value;
+    if (maximumSizeBytes == 0) {
+      clear();
+    } else {
+      _checkCacheSize();
+    }
+  }
+
+  /// The number of bytes of encoded SVGs in the cache.
+  int get currentSizeBytes => _currentSizeBytes;
+  int _currentSizeBytes = 0;
+
+  /// The path of a directory to store encoded SVGs in, so that they do not
+  /// need to be parsed again after the app restarts.
+  ///
+  /// Each SVG is stored under a hash of its source, its [SvgTheme] and the
+  /// format it is encoded in, so changed SVGs, and SVGs stored by versions of
+  /// flutter_svg or vector_graphics_compiler that encode SVGs differently, are
+  /// parsed again. Files are read and written on the same background isolate
+  /// that parses SVGs. SVGs loaded with a [ColorMapper] are not stored, since a
+  /// color mapper cannot be identified across launches.
+  ///
+  /// When the stored SVGs exceed [diskCacheMaximumSizeBytes], the least
+  /// recently used ones are removed, which eventually removes SVGs that are no
+  /// longer loaded.
+  ///
+  /// Defaults to null, which does not store SVGs. Not supported on the web.
+  String? diskCacheDirectory;
+
+  /// The maximum number of bytes of encoded SVGs to keep in
+  /// [diskCacheDirectory].
+  ///
+  /// After an SVG is stored, the least recently used SVGs are removed until
+  /// the directory is within this budget. Reading a stored SVG marks it as
+  /// used. Defaults to 20 MiB.
+  int get diskCacheMaximumSizeBytes => _diskCacheMaximumSizeBytes;
+  int _diskCacheMaximumSizeBytes = 20 << 20; // 20 MiB
+
+  /// Changes the maximum size of [diskCacheDirectory] in bytes.
+  ///
+  /// Stored SVGs are removed the next time an SVG is stored.
+  set diskCacheMaximumSizeBytes(int value) {
+    assert(value >= 0);
+    _diskCacheMaximumSizeBytes = value;
+  }
+
   /// Evicts all entries from the cache.
   ///
   /// This is useful if, for instance, the root asset bundle has been updated
   /// and therefore new images must be obtained.
   void clear() {
     _cache.clear();
+    _currentSizeBytes = 0;
   }
 
   /// Evicts a single entry from the cache, returning true if successful.
   bool evict(Object key) {
-    return _cache.remove(key) != null;
+    return _remove(key) != null;
   }
 
   /// Evicts a single entry from the cache if the `oldData` and `newData` are
@@ -74,7 +135,7 @@ class Cache {
     if (result != null) {
       // Remove the provider from the list so that we can put it back in below
       // and thus move it to the end of the list.
-      _cache.remove(key);
+      _remove(key);
     } else {
       pendingResult = loader();
       _pending[key] = pendingResult;
@@ -93,18 +154,32 @@ class Cache {
   }
 
   void _add(Object key, ByteData result) {
-    if (maximumSize > 0) {
-      if (_cache.containsKey(key)) {
-        _cache.remove(key); // update LRU.
-      } else if (_cache.length == maximumSize && maximumSize > 0) {
-        _cache.remove(_cache.keys.first);
-      }
-      assert(_cache.length < maximumSize);
+    if (maximumSize > 0 && result.lengthInBytes <= maximumSizeBytes) {
+      _remove(key); // update LRU.
       _cache[key] = result;
+      _currentSizeBytes += result.lengthInBytes;
+      _checkCacheSize();
     }
     assert(_cache.length <= maximumSize);
   }
 
+  ByteData? _remove(Object key) {
+    final ByteData? result = _cache.remove(key);
+    if (result != null) {
+      _currentSizeBytes -= result.lengthInBytes;
+    }
+    return result;
+  }
+
+  // Evicts the least-recently-used entries until the cache fits in both
+  // [maximumSize] and [maximumSizeBytes].
+  void _checkCacheSize() {
+    while (_cache.length > maximumSize ||
+        _currentSizeBytes > maximumSizeBytes) {
+      _remove(_cache.keys.first);
+    }
+  }
+
   /// The number of entries in the cache.
   int get count => _cache.length;
 }
@@ -115,6 +115,44 @@ class _DelegateVgColorMapper extends vg.ColorMapper {
   }
 }
 
+// Increment this when flutter_svg changes how it encodes SVGs, so that SVGs
+// stored on disk by earlier versions are parsed again.
+const int _diskCacheFormatVersion = 1;
+
+// An SVG that uses most kinds of encoded commands.
+const String _diskCacheReferenceSvg = '''
+<svg xmlns="http://www.w3.org/2000/svg" width="16" height="16">
+  <linearGradient id="g">
+    <stop offset="0" stop-color="red"/>
+    <stop offset="1" stop-color="currentColor"/>
+  </linearGradient>
+  <clipPath id="c"><circle cx="8" cy="8" r="7"/></clipPath>
+  <g clip-path="url(#c)" opacity="0.5">
+    <rect width="16" height="16" rx="2" fill="url(#g)"/>
+    <path d="M2 2C6 4 10 12 14 14" stroke="black" stroke-dasharray="1 2"/>
+  </g>
+  <text x="2" y="8" font-size="4">a</text>
+</svg>
+''';
+
+// Identifies how SVGs stored on disk are encoded. Besides the version above,
+// this includes the encoding of a reference SVG, which changes with the version
+// of the vector_graphics codec and with most changes to how
+// vector_graphics_compiler encodes SVGs. It is computed once per isolate, when
+// the first SVG is stored or read.
+final String _diskCacheFormat = hashForDiskCache(<String>[
+  '$_diskCacheFormatVersion',
+  String.fromCharCodes(
+    vg.encodeSvg(
+      xml: _diskCacheReferenceSvg,
+      debugName: 'Disk cache format',
+      enableClippingOptimizer: false,
+      enableMaskingOptimizer: false,
+      enableOverdrawOptimizer: false,
+    ),
+  ),
+]);
+
 /// A [BytesLoader] that parses a SVG data in an isolate and creates a
 /// vector_graphics binary representation.
 @immutable
@@ -155,23 +193,51 @@ abstract class SvgLoader<T> extends BytesLoader {
 
   Future<ByteData> _load(BuildContext? context) {
     final SvgTheme theme = getTheme(context);
+    // A color mapper can't be identified across launches, so SVGs that use one
+    // aren't stored on disk.
+    final String? diskCacheDirectory = colorMapper == null && !kIsWeb
+        ? svg.cache.diskCacheDirectory
+        : null;
+    final int diskCacheMaximumSizeBytes = svg.cache.diskCacheMaximumSizeBytes;
     return prepareMessage(context).then((T? message) {
       return compute(
         (T? message) {
-          return vg
-              .encodeSvg(
-                xml: provideSvg(message),
-                theme: theme.toVgTheme(),
-                colorMapper: colorMapper == null
-                    ? null
-                    : _DelegateVgColorMapper(colorMapper!),
-                debugName: 'Svg loader',
-                enableClippingOptimizer: false,
-                enableMaskingOptimizer: false,
-                enableOverdrawOptimizer: false,
-              )
-              .buffer
-              .asByteData();
+          final String xml = provideSvg(message);
+          String? diskCachePath;
+          if (diskCacheDirectory != null) {
+            final String key = hashForDiskCache(<String>[
+              _diskCacheFormat,
+              '${theme.currentColor.toARGB32()}',
+              '${theme.fontSize}',
+              '${theme.xHeight}',
+              xml,
+            ]);
+            diskCachePath = '$diskCacheDirectory/$key.vec';
+            final Uint8List? cached = readFileOrNull(diskCachePath);
+            if (cached != null) {
+              return cached.buffer.asByteData();
+            }
+          }
+          final Uint8List bytes = vg.encodeSvg(
+            xml: xml,
+            theme: theme.toVgTheme(),
+            colorMapper: colorMapper == null
+                ? null
+                : _DelegateVgColorMapper(colorMapper!),
+            debugName: 'Svg loader',
+            enableClippingOptimizer: false,
+            enableMaskingOptimizer: false,
+            enableOverdrawOptimizer: false,
+          );
+          if (diskCachePath != null) {
+            writeFileOrIgnore(diskCachePath, bytes);
+            evictLeastRecentlyUsed(
+              diskCacheDirectory!,
+              '.vec',
+              diskCacheMaximumSizeBytes,
+            );
+          }
+          return bytes.buffer.asByteData();
         },
         message,
         debugLabel: 'Load Bytes',
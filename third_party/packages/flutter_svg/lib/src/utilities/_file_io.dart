@@ -1 +1,99 @@
+import 'dart:io';
+import 'dart:typed_data';
+
 export 'dart:io' show File;
+
+/// Reads the file at [path], or returns null if it cannot be read.
+///
+/// The file is marked as recently used, so that [evictLeastRecentlyUsed]
+/// removes it last.
+Uint8List? readFileOrNull(String path) {
+  try {
+    final file = File(path);
+    final Uint8List bytes = file.readAsBytesSync();
+    try {
+      file.setLastModifiedSync(DateTime.now());
+    } on FileSystemException {
+      // The file can still be used, it will just be removed sooner.
+    }
+    return bytes;
+  } on FileSystemException {
+    return null;
+  }
+}
+
+/// Writes [bytes] to the file at [path], creating its directory if needed.
+///
+/// The bytes are written to a temporary file first, so that a partially
+/// written file is never read. Failures are ignored.
+void writeFileOrIgnore(String path, Uint8List bytes) {
+  try {
+    final file = File(path);
+    file.parent.createSync(recursive: true);
+    final temporaryFile = File('$path.$pid.tmp');
+    temporaryFile.writeAsBytesSync(bytes, flush: true);
+    temporaryFile.renameSync(path);
+  } on FileSystemException {
+    // The SVG is parsed again next time instead.
+  }
+}
+
+/// Removes the least recently used files in [directory] whose names end with
+/// [extension], until their total size is at most [maximumSizeBytes].
+///
+/// Failures are ignored.
+void evictLeastRecentlyUsed(
+  String directory,
+  String extension,
+  int maximumSizeBytes,
+) {
+  try {
+    final files = <(File, FileStat)>[];
+    var sizeBytes = 0;
+    for (final FileSystemEntity entity in Directory(directory).listSync()) {
+      if (entity is File && entity.path.endsWith(extension)) {
+        final FileStat stat = entity.statSync();
+        files.add((entity, stat));
+        sizeBytes += stat.size;
+      }
+    }
+    if (sizeBytes <= maximumSizeBytes) {
+      return;
+    }
+    files.sort(
+      ((File, FileStat) a, (File, FileStat) b) =>
+          a.$2.modified.compareTo(b.$2.modified),
+    );
+    for (final (File file, FileStat stat) in files) {
+      if (sizeBytes <= maximumSizeBytes) {
+        break;
+      }
+      try {
+        file.deleteSync();
+      } on FileSystemException {
+        // Another isolate already removed it.
+      }
+      sizeBytes -= stat.size;
+    }
+  } on FileSystemException {
+    // The files are removed after the next write instead.
+  }
+}
+
+/// Returns a 64-bit FNV-1a hash of [values], as a hex string.
+///
+/// This is only available where files are, since 64-bit integers can't be
+/// represented on the web.
+String hashForDiskCache(Iterable<String> values) {
+  var hash = 0xcbf29ce484222325;
+  for (final String value in values) {
+    for (final int unit in value.codeUnits) {
+      hash ^= unit;
+      hash *= 0x100000001b3;
+    }
+    // Separate the values, so that moving characters between them changes the
+    // hash.
+    hash *= 0x100000001b3;
+  }
+  return hash.toUnsigned(64).toRadixString(16).padLeft(16, '0');
+}
@@ -14,3 +14,21 @@ abstract class File {
   /// Reads the entire file contents as a list of bytes synchronously.
   Uint8List readAsBytesSync();
 }
+
+/// Files are not available on the web, so this always returns null.
+Uint8List? readFileOrNull(String path) => null;
+
+/// Files are not available on the web, so this does nothing.
+void writeFileOrIgnore(String path, Uint8List bytes) {}
+
+/// Files are not available on the web, so this does nothing.
+void evictLeastRecentlyUsed(
+  String directory,
+  String extension,
+  int maximumSizeBytes,
+) {}
+
+/// Files are not available on the web, so SVGs are never stored on disk.
+String hashForDiskCache(Iterable<String> values) {
+  throw UnsupportedError('Disk caching is not supported on the web.');
+}
@@ -0,0 +1,153 @@
+import 'dart:async';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:flutter/foundation.dart' as foundation;
+
+_Worker? _worker;
+
+/// A [foundation.compute] implementation that runs every callback on a single,
+/// long-lived background isolate.
+///
+/// Spawning an isolate for each SVG costs more than parsing most SVGs, so the
+/// worker is spawned on first use and kept for the lifetime of the app.
+/// Synchronous callbacks run one at a time, in the order they were requested.
+/// If the worker exits, pending callbacks fail with a [RemoteError] and the
+/// next callback spawns a new worker.
+Future<R> workerCompute<Q, R>(
+  foundation.ComputeCallback<Q, R> callback,
+  Q message, {
+  String? debugLabel,
+}) async {
+  final _Worker worker = _worker ??= _Worker();
+  return await worker.run(() => callback(message)) as R;
+}
+
+// The kinds of response the worker sends for a request.
+const int _valueResponse = 0;
+const int _bytesResponse = 1;
+const int _errorResponse = 2;
+
+class _Worker {
+  _Worker() {
+    _responses.handler = _handleResponse;
+    _errors.handler = _handleError;
+    _exits.handler = (Object? _) {
+      _close(
+        _lastError ??
+            RemoteError('The flutter_svg worker isolate exited.', ''),
+      );
+    };
+    Isolate.spawn(
+      _workerMain,
+      _responses.sendPort,
+      onError: _errors.sendPort,
+      onExit: _exits.sendPort,
+      debugName: 'flutter_svg worker',
+    ).then<void>((Isolate _) {}, onError: _close);
+  }
+
+  final RawReceivePort _responses = RawReceivePort();
+  final RawReceivePort _errors = RawReceivePort();
+  final RawReceivePort _exits = RawReceivePort();
+  final Completer<SendPort> _requests = Completer<SendPort>();
+  final Map<int, Completer<Object?>> _pendingRequests =
+      <int, Completer<Object?>>{};
+  int _nextRequestId = 0;
+  RemoteError? _lastError;
+  bool _closed = false;
+
+  Future<Object?> run(FutureOr<Object?> Function() callback) async {
+    final SendPort requests = await _requests.future;
+    if (_closed) {
+      throw _lastError ??
+          RemoteError('The flutter_svg worker isolate exited.', '');
+    }
+    final int id = _nextRequestId++;
+    final completer = Completer<Object?>();
+    _pendingRequests[id] = completer;
+    requests.send(<Object?>[id, callback]);
+    return completer.future;
+  }
+
+  void _handleResponse(Object? response) {
+    if (response is SendPort) {
+      _requests.complete(response);
+      return;
+    }
+    // Responses are [id, kind, ...], with the kind's values following.
+    final list = response! as List<Object?>;
+    final Completer<Object?>? completer = _pendingRequests.remove(
+      list[0]! as int,
+    );
+    switch (list[1]! as int) {
+      case _valueResponse:
+        completer?.complete(list[2]);
+      case _bytesResponse:
+        final bytes = list[2]! as TransferableTypedData;
+        completer?.complete(bytes.materialize().asByteData());
+      default:
+        completer?.completeError(
+          RemoteError(list[2]! as String, list[3]! as String),
+        );
+    }
+  }
+
+  void _handleError(Object? error) {
+    // Uncaught errors are sent as [error, stackTrace], both as strings. They
+    // are fatal, so the exit handler reports them.
+    final list = error! as List<Object?>;
+    _lastError = RemoteError('${list[0]}', '${list[1]}');
+  }
+
+  void _close(Object error, [StackTrace? stackTrace]) {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    if (identical(_worker, this)) {
+      _worker = null;
+    }
+    _responses.close();
+    _errors.close();
+    _exits.close();
+    if (!_requests.isCompleted) {
+      _requests.completeError(error, stackTrace);
+    }
+    for (final Completer<Object?> completer in _pendingRequests.values) {
+      completer.completeError(error, stackTrace);
+    }
+    _pendingRequests.clear();
+  }
+}
+
+void _workerMain(SendPort responses) {
+  final requests = RawReceivePort();
+  requests.handler = (Object? request) async {
+    final list = request! as List<Object?>;
+    final id = list[0]! as int;
+    final callback = list[1]! as FutureOr<Object?> Function();
+    try {
+      final Object? result = await callback();
+      if (result is ByteData) {
+        // Transfer encoded SVGs instead of copying them again when they are
+        // sent.
+        responses.send(<Object?>[
+          id,
+          _bytesResponse,
+          TransferableTypedData.fromList(<TypedData>[result]),
+        ]);
+      } else {
+        responses.send(<Object?>[id, _valueResponse, result]);
+      }
+    } catch (error, stackTrace) {
+      responses.send(<Object?>[
+        id,
+        _errorResponse,
+        error.toString(),
+        stackTrace.toString(),
+      ]);
+    }
+  };
+  responses.send(requests.sendPort);
+}
@@ -0,0 +1,10 @@
+import 'package:flutter/foundation.dart' as foundation;
+
+/// Isolates are not available on the web, so this uses [foundation.compute].
+Future<R> workerCompute<Q, R>(
+  foundation.ComputeCallback<Q, R> callback,
+  Q message, {
+  String? debugLabel,
+}) {
+  return foundation.compute(callback, message, debugLabel: debugLabel);
+}
@@ -2,6 +2,8 @@ import 'dart:async';
 
 import 'package:flutter/foundation.dart' as foundation;
 
+import 'worker.dart';
+
 Future<R> _testCompute<Q, R>(
   foundation.ComputeCallback<Q, R> callback,
   Q message, {
@@ -18,8 +20,9 @@ Future<R> _testCompute<Q, R>(
   return foundation.SynchronousFuture<R>(result);
 }
 
-/// A compute implementation that does not spawn isolates in tests.
+/// A compute implementation that does not spawn isolates in tests, and
+/// otherwise runs callbacks on a single long-lived worker isolate.
 const foundation.ComputeImpl compute =
     (foundation.kDebugMode || foundation.kIsWeb)
     ? _testCompute
-    : foundation.compute;
+    : workerCompute;
@@ -0,0 +1 @@
+export '_worker_io.dart' if (dart.library.js_interop) '_worker_none.dart';
@@ -99,6 +99,33 @@ void main() {
     expect(cache.count, 2);
   });
 
+  test('Byte budget', () async {
+    final cache = Cache();
+    cache.maximumSizeBytes = 5;
+
+    await cache.putIfAbsent(1, () => SynchronousFuture<ByteData>(ByteData(2)));
+    await cache.putIfAbsent(2, () => SynchronousFuture<ByteData>(ByteData(2)));
+    expect(cache.count, 2);
+    expect(cache.currentSizeBytes, 4);
+
+    // Evicts the least-recently-used entry to make room.
+    await cache.putIfAbsent(3, () => SynchronousFuture<ByteData>(ByteData(3)));
+    expect(cache.count, 2);
+    expect(cache.currentSizeBytes, 5);
+    expect(cache.evict(1), false);
+
+    // Entries larger than the budget are not cached.
+    await cache.putIfAbsent(4, () => SynchronousFuture<ByteData>(ByteData(6)));
+    expect(cache.count, 2);
+    expect(cache.evict(4), false);
+
+    cache.maximumSizeBytes = 3;
+    expect(cache.count, 1);
+    expect(cache.currentSizeBytes, 3);
+    expect(cache.evict(3), true);
+    expect(cache.currentSizeBytes, 0);
+  });
+
   test('Futures completing late/together', () async {
     final cache = Cache();
     cache.maximumSize = 2;
@@ -1,4 +1,5 @@
 import 'dart:convert';
+import 'dart:io';
 import 'dart:typed_data';
 
 import 'package:flutter/services.dart';
@@ -52,6 +53,68 @@ void main() {
     svg.cache.maximumSize = 100;
   });
 
+  test('Stores encoded SVGs on disk', () async {
+    final Directory directory = Directory.systemTemp.createTempSync(
+      'flutter_svg_test',
+    );
+    addTearDown(() {
+      svg.cache.diskCacheDirectory = null;
+      directory.deleteSync(recursive: true);
+    });
+    svg.cache.diskCacheDirectory = directory.path;
+
+    const loader = TestLoader();
+    final ByteData bytes = await loader.loadBytes(null);
+    final List<FileSystemEntity> files = directory.listSync();
+    expect(files, hasLength(1));
+    final file = files.single as File;
+    expect(file.readAsBytesSync(), Uint8List.sublistView(bytes));
+
+    // The stored SVG is used once the in-memory cache is cleared.
+    file.writeAsBytesSync(<int>[1, 2, 3]);
+    svg.cache.clear();
+    final ByteData stored = await loader.loadBytes(null);
+    expect(Uint8List.sublistView(stored), <int>[1, 2, 3]);
+
+    // SVGs with a color mapper are not stored.
+    await const TestLoader(
+      keyName: 'B',
+      colorMapper: _TestColorMapper(),
+    ).loadBytes(null);
+    expect(directory.listSync(), hasLength(1));
+  });
+
+  test('Removes the least recently used SVGs from disk', () async {
+    final Directory directory = Directory.systemTemp.createTempSync(
+      'flutter_svg_test',
+    );
+    addTearDown(() {
+      svg.cache.diskCacheDirectory = null;
+      svg.cache.diskCacheMaximumSizeBytes = 20 << 20;
+      directory.deleteSync(recursive: true);
+    });
+    svg.cache.diskCacheDirectory = directory.path;
+
+    await const TestLoader(
+      theme: SvgTheme(currentColor: Color(0xFF000001)),
+    ).loadBytes(null);
+    final file = directory.listSync().single as File;
+    file.setLastModifiedSync(DateTime(2000));
+    // Leave room for two stored SVGs.
+    svg.cache.diskCacheMaximumSizeBytes = file.lengthSync() * 2;
+
+    await const TestLoader(
+      theme: SvgTheme(currentColor: Color(0xFF000002)),
+    ).loadBytes(null);
+    expect(file.existsSync(), true);
+    await const TestLoader(
+      theme: SvgTheme(currentColor: Color(0xFF000003)),
+    ).loadBytes(null);
+
+    expect(file.existsSync(), false);
+    expect(directory.listSync(), hasLength(2));
+  });
+
   test('AssetLoader respects packages', () async {
     final bundle = TestBundle(<String, ByteData>{
       'foo': Uint8List(0).buffer.asByteData(),
@@ -0,0 +1,53 @@
+@TestOn('vm')
+library;
+
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:flutter_svg/src/utilities/worker.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+String? _isolateName(int value) => Isolate.current.debugName;
+
+int _double(int value) => value * 2;
+
+int _throw(int value) => throw StateError('failed $value');
+
+int _exit(int value) => Isolate.exit();
+
+ByteData _bytes(int value) =>
+    ByteData.sublistView(Uint8List.fromList(<int>[value, value]), 1);
+
+void main() {
+  test('Runs callbacks on a single background isolate', () async {
+    expect(await workerCompute(_double, 21), 42);
+    expect(await workerCompute(_isolateName, 0), 'flutter_svg worker');
+    expect(
+      await Future.wait(<Future<int>>[
+        workerCompute(_double, 1),
+        workerCompute(_double, 2),
+        workerCompute(_double, 3),
+      ]),
+      <int>[2, 4, 6],
+    );
+  });
+
+  test('Reports errors from callbacks', () async {
+    await expectLater(workerCompute(_throw, 1), throwsA(isA<RemoteError>()));
+    // The worker keeps running after an error.
+    expect(await workerCompute(_double, 4), 8);
+  });
+
+  test('Transfers encoded bytes', () async {
+    final ByteData bytes = await workerCompute(_bytes, 7);
+    expect(Uint8List.sublistView(bytes), <int>[7]);
+  });
+
+  test('Fails pending callbacks and respawns when the worker exits', () async {
+    final Future<int> pending = workerCompute(_double, 1);
+    await expectLater(workerCompute(_exit, 0), throwsA(isA<RemoteError>()));
+    // The request sent before the exit was answered first.
+    expect(await pending, 2);
+    expect(await workerCompute(_double, 5), 10);
+  });
+}
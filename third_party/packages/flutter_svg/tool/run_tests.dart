@@ -0,0 +1,37 @@
+// Called from the custom-tests CI action.
+//
+// usage: dart run tool/run_tests.dart
+
+// ignore_for_file: avoid_print
+
+import 'dart:io';
+
+// Builds the example app for the web, to catch code that compiles on the VM
+// but not with dart2js, such as integer literals that JavaScript can't
+// represent exactly. The web unit tests can't catch this, since the package's
+// tests only run on the VM.
+Future<void> main(List<String> args) async {
+  if (!Platform.isLinux) {
+    // The web build is the same on every host, so only run it once.
+    print('Skipping the web build on ${Platform.operatingSystem}.');
+    return;
+  }
+
+  final Directory exampleDir = Directory.fromUri(
+    Platform.script.resolve('../example/'),
+  );
+
+  print('Building ${exampleDir.path} for the web...');
+  final Process process = await Process.start(
+    'flutter',
+    <String>['build', 'web', '--release'],
+    workingDirectory: exampleDir.path,
+    runInShell: true,
+    mode: ProcessStartMode.inheritStdio,
+  );
+  final int exitCode = await process.exitCode;
+  if (exitCode != 0) {
+    print('Building the example for the web failed.');
+  }
+  exit(exitCode);
+}